@@ -3,19 +3,75 @@
  * Group: 7
  * Student IDs: S10267643, S10267163
  * Highlighted Features:
- * - Sorting: Implementation of the Bubble Sort algorithm to organize filtered
- * game lists by year or player count.
+ * - Filtering and Sorting: Player count, year range, play time, title text
+ * and availability combine into one query; the catalog's query planner picks the
+ * most selective index and orders the matches by year or player count.
  * - Input Validation: Robust error handling for integer ranges and string lengths.
- * - Table Rendering: Custom-aligned console output for professional reporting.
- * - Data Integrity: Automatic CSV synchronization after modification (Add/Remove).
+ * - Title Autocomplete: Game details can be looked up by the start of a title,
+ * answered from the catalog's title trie.
+ * - Table Rendering: Custom-aligned console output for professional reporting;
+ * long tables and the borrow history are formatted into a buffered
+ * ConsoleRenderer and can be paged.
+ * - Date Reports: Borrows in a date range and long-running loans come from the
+ * borrow-date index instead of a full scan of the records.
+ * - Overdue Report: Loans past their due date come straight from the due-date
+ * heap kept by the borrow records.
+ * - Leaderboards: Most borrowed and trending games are read from the
+ * incrementally maintained popularity board.
+ * - Play Statistics: Most played games, win rates and favourite partners come
+ * from the streaming aggregates kept by PlayStats.
+ * - Bulk Import: External board-game dumps are streamed into the catalog,
+ * skipping titles it already has, with a rows-per-second report.
+ * - Memory Report: Bytes held by each catalog structure, in total and per game.
+ * - Cache Report: Hit, miss and staleness counts of the search result cache.
+ * - Counter Batches: A file of borrows and returns for any members is
+ * validated and applied as one BorrowBatch, with a result per line.
+ * - Parallel Benchmark: Times CSV parsing, query index rebuilds and borrow
+ * history scans with and without the shared thread pool.
+ * - Snapshot Benchmark: Read throughput of lock-free catalog snapshots against
+ * a global catalog lock, for a growing number of reader threads, while the
+ * catalog keeps changing.
+ * - Usage Analytics: Distinct borrowers per game and the most viewed games
+ * come from fixed-size sketches, shown next to an exact scan for comparison.
+ * - Borrow Record Storage: Converts the records to the memory-mapped binary
+ * borrow log, exports it back to CSV on demand, and looks records up by ID or
+ * borrow date with binary searches over its fixed-width entries.
+ * - Data Integrity: Automatic CSV synchronization after modification (Add/Remove),
+ * written behind by the PersistenceWorker.
  *****************************************************************************/
 
 #include "AdminMenu.h"
 #include "CSVHandler.h"
+#include "QueryEngine.h"
+#include "QueryCache.h"
+#include "ConsoleRenderer.h"
+#include "GameImporter.h"
+#include "BorrowBatch.h"
+#include "CatalogSnapshot.h"
+#include "StreamSketches.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace std;
 
+// most titles offered when the admin types the start of a title
+static const int TITLE_SUGGESTIONS = 10;
+// timed runs per benchmark variant; the fastest one is reported
+static const int BENCHMARK_RUNS = 5;
+// how long each reader count of the snapshot benchmark runs
+static const int SNAPSHOT_BENCHMARK_MS = 400;
+
+// most played games listed by the play session report
+static const int PLAY_STATS_LIST_SIZE = 10;
+
 /**
  * Helper function to convert an integer to a string without using std::to_string.
  * @param value The integer to convert.
@@ -36,11 +92,9 @@ static string intToStr(int value) {
  * @param text The string to display.
  * @param width The total width of the column.
  */
-static void printColumn(string text, int width) {
+static void printColumn(const string& text, int width) {
     cout << text;
-    for (int i = text.length(); i < width; i++) {
-        cout << " ";
-    }
+    if ((int)text.length() < width) cout << string(width - text.length(), ' ');
 }
 
 /**
@@ -67,6 +121,36 @@ static int getValidInt(string prompt, int minVal, int maxVal) {
     }
 }
 
+/**
+ * Forces the user to provide a valid calendar date.
+ * @param prompt The message shown to the user.
+ * @return A non-empty Date.
+ */
+static Date getValidDate(string prompt) {
+    string text;
+    while (true) {
+        cout << prompt;
+        cin >> text;
+        cin.ignore(1000, '\n');
+        Date date = Date::parse(text);
+        if (!date.isEmpty()) return date;
+        cout << "[INVALID] Please enter a date as YYYY-MM-DD.\n";
+    }
+}
+
+/**
+ * Formats one row of a borrow report (dates are 10 characters wide).
+ */
+static void renderBorrowRow(ConsoleRenderer& out, const BorrowRecord& record, GameDynamicArray& games) {
+    Game* game = games.findByGameID(record.getGameID());
+    out.date(record.getBorrowDate()).text("  ");
+    out.column(record.getUserID(), 8);
+    out.column(record.getGameID(), 7);
+    if (record.isReturned()) out.date(record.getReturnDate()).text("  ");
+    else out.column("on loan", 12);
+    out.text(game != nullptr ? game->getTitle() : "Unknown").newline();
+}
+
 // --- AdminMenu Implementation ---
 
 /**
@@ -75,11 +159,24 @@ static int getValidInt(string prompt, int minVal, int maxVal) {
  * @param games Reference to the game inventory array.
  * @param users Reference to the user directory array.
  * @param records Reference to the borrowing record linked list.
+ * @param persistence Background writer that saves changes.
+ * @param playStats Recorded play sessions and their statistics.
+ * @param pool Shared worker threads (used by the parallel benchmark).
+ * @param sessions Warm member sessions, kept in step by batch borrows/returns.
+ * @param recommender Recommendations fed by batch borrows.
+ * @param borrowLog Binary borrow log (open once the records are stored in it).
  */
-void AdminMenu::show(GameDynamicArray& games, UserDynamicArray& users, BorrowLinkedList& records) {
+void AdminMenu::show(GameDynamicArray& games, UserDynamicArray& users, BorrowLinkedList& records,
+    PersistenceWorker& persistence, PlayStats& playStats, ThreadPool& pool,
+    SessionCache& sessions, Recommender& recommender, BorrowLog& borrowLog) {
     int choice = -1;
 
     while (choice != 0) {
+        long long journalFailures = persistence.takeJournalFailures();
+        if (journalFailures > 0) {
+            cout << "[WARNING] " << journalFailures << " recent change(s) could not be written to the journal; "
+                 << "they will be saved with the next file write.\n";
+        }
         cout << "\n==============================\n";
         cout << "         ADMIN MENU           \n";
         cout << "==============================\n";
@@ -88,7 +185,21 @@ void AdminMenu::show(GameDynamicArray& games, UserDynamicArray& users, BorrowLin
         cout << "3. Add a new member\n";
         cout << "4. Display borrowing summary\n";
         cout << "5. Display game details\n";
-        cout << "6. List games by player count\n";
+        cout << "6. Filter and sort games\n";
+        cout << "7. List borrows between two dates\n";
+        cout << "8. List loans older than N days\n";
+        cout << "9. List overdue loans\n";
+        cout << "10. Show most borrowed and trending games\n";
+        cout << "11. Show play session statistics\n";
+        cout << "12. Find members by name\n";
+        cout << "13. Show catalog memory footprint\n";
+        cout << "14. Import games from a CSV dump\n";
+        cout << "15. Show search cache hit rate\n";
+        cout << "16. Benchmark parallel operations\n";
+        cout << "17. Process a borrow/return batch file\n";
+        cout << "18. Benchmark snapshot reads\n";
+        cout << "19. Show borrower and view analytics\n";
+        cout << "20. Manage borrow record storage\n";
         cout << "0. Exit\n";
         cout << "------------------------------\n";
         cout << "Choice: ";
@@ -101,21 +212,36 @@ void AdminMenu::show(GameDynamicArray& games, UserDynamicArray& users, BorrowLin
         }
 
         switch (choice) {
-        case 1: handleAddGame(games); break;
-        case 2: handleRemoveGame(games); break;
-        case 3: handleAddMember(users); break;
+        case 1: handleAddGame(games, persistence); break;
+        case 2: handleRemoveGame(games, persistence); break;
+        case 3: handleAddMember(users, persistence); break;
         case 4: {
             cout << "\n--- Borrowing Records Summary ---\n";
             if (records.isEmpty()) {
                 cout << "No records found.\n";
             }
             else {
-                records.printAll();
+                int pageSize = getValidInt("Records per page (0 = show all): ", 0, 1000000);
+                records.printAll(&games, pageSize);
             }
             break;
         }
         case 5: handleGameSearch(games); break;
         case 6: handleFilterAndSort(games); break;
+        case 7: handleBorrowsBetween(records, games); break;
+        case 8: handleOverdueLoans(records, games); break;
+        case 9: handleOverdueReport(records, games); break;
+        case 10: handleLeaderboard(records, games); break;
+        case 11: handlePlayStats(playStats, games, users); break;
+        case 12: handleFindMember(users); break;
+        case 13: handleMemoryReport(games); break;
+        case 14: handleImportGames(games, persistence); break;
+        case 15: handleQueryCacheReport(games); break;
+        case 16: handleParallelBenchmark(games, records, pool); break;
+        case 17: handleBorrowBatch(games, users, records, persistence, sessions, recommender); break;
+        case 18: handleSnapshotBenchmark(games, pool); break;
+        case 19: handleUsageAnalytics(games, records, sessions); break;
+        case 20: handleBorrowStorage(records, borrowLog, games, persistence); break;
         case 0: cout << "Exiting Admin Menu...\n"; break;
         default: cout << "Invalid choice. Try again.\n";
         }
@@ -126,12 +252,13 @@ void AdminMenu::show(GameDynamicArray& games, UserDynamicArray& users, BorrowLin
  * Handles the logic for adding a new game to the system.
  * Includes automated ID generation and field validation.
  * @param games Reference to the inventory to update.
+ * @param persistence Background writer that saves the catalog.
  */
-void AdminMenu::handleAddGame(GameDynamicArray& games) {
+void AdminMenu::handleAddGame(GameDynamicArray& games, PersistenceWorker& persistence) {
     string title;
 
-    int nextNum = games.size() + 1;
-    string id = "G" + (nextNum < 100 ? string("0") : "") + (nextNum < 10 ? string("0") : "") + intToStr(nextNum);
+    // Continues after the highest ID ever used, so removed games' IDs are not reissued
+    string id = games.nextGameID();
 
     cout << "\nAdding New Game (Assigned ID: " << id << ")\n";
     cin.ignore(1000, '\n');
@@ -150,15 +277,16 @@ void AdminMenu::handleAddGame(GameDynamicArray& games) {
 
     Game newGame(id, title, minP, maxP, year, total, total);
     games.add(newGame);
-    CSVHandler::saveGames("games.csv", games);
+    persistence.markGamesDirty(games);
     cout << "\n[SUCCESS] Game '" << title << "' added to inventory.\n";
 }
 
 /**
  * Removes a game from the inventory after user confirmation.
  * @param games Reference to the inventory to update.
+ * @param persistence Background writer that saves the catalog.
  */
-void AdminMenu::handleRemoveGame(GameDynamicArray& games) {
+void AdminMenu::handleRemoveGame(GameDynamicArray& games, PersistenceWorker& persistence) {
     string id;
     cout << "Enter Game ID to remove (e.g., G001): ";
     cin >> id;
@@ -177,7 +305,7 @@ void AdminMenu::handleRemoveGame(GameDynamicArray& games) {
 
             if (confirm == 'Y') {
                 if (games.removeByGameID(id)) {
-                    CSVHandler::saveGames("games.csv", games);
+                    persistence.markGamesDirty(games);
                     cout << "[SUCCESS] Game " << id << " removed and CSV updated.\n";
                 }
                 break;
@@ -201,8 +329,9 @@ void AdminMenu::handleRemoveGame(GameDynamicArray& games) {
 /**
  * Logic for adding new members with unique ID check.
  * @param users Reference to the user collection.
+ * @param persistence Background writer that saves the user list.
  */
-void AdminMenu::handleAddMember(UserDynamicArray& users) {
+void AdminMenu::handleAddMember(UserDynamicArray& users, PersistenceWorker& persistence) {
     string userID, name;
 
     while (true) {
@@ -227,20 +356,63 @@ void AdminMenu::handleAddMember(UserDynamicArray& users) {
 
     User u(userID, name, MEMBER);
     users.add(u);
-    CSVHandler::saveUsers("users.csv", users);
+    persistence.markUsersDirty(users);
     cout << "[SUCCESS] Member '" << name << "' added.\n";
 }
 
 /**
- * Searches for a game by ID and prints detailed information including reviews.
+ * Lists every account with a given name (case-insensitive), answered from
+ * the directory's name index.
+ * @param users Reference to the user collection.
+ */
+void AdminMenu::handleFindMember(UserDynamicArray& users) {
+    string name;
+    cin.ignore(1000, '\n');
+    cout << "Enter member name: ";
+    getline(cin, name);
+
+    vector<User*> found;
+    users.findByName(name, found);
+    if (found.empty()) {
+        cout << "[INFO] No members named '" << name << "'.\n";
+        return;
+    }
+    for (int i = 0; i < (int)found.size(); i++) {
+        cout << "---------------------\n";
+        found[i]->print();
+    }
+}
+
+/**
+ * Shows a game's details. Accepts a Game ID, or the start of a title and
+ * offers the matching titles (autocomplete) to pick from.
  * @param games Reference to the inventory.
  */
 void AdminMenu::handleGameSearch(GameDynamicArray& games) {
-    string id;
-    cout << "Enter Game ID to view: ";
-    cin >> id;
+    string input;
+    cin.ignore(1000, '\n');
+    cout << "Enter Game ID or the start of a title: ";
+    getline(cin, input);
+
+    Game* g = games.findByGameID(input);
+    if (g == nullptr && !input.empty()) {
+        vector<Game*> suggestions;
+        games.completeTitles(input, TITLE_SUGGESTIONS, suggestions);
+        if (suggestions.size() == 1) {
+            g = suggestions[0];
+        }
+        else if (!suggestions.empty()) {
+            cout << "\nTitles starting with '" << input << "':\n";
+            for (int i = 0; i < (int)suggestions.size(); i++) {
+                cout << "[" << (i + 1) << "] " << suggestions[i]->getTitle()
+                     << " (" << suggestions[i]->getGameID() << ")\n";
+            }
+            int pick = getValidInt("Select a game (0 to cancel): ", 0, (int)suggestions.size());
+            if (pick == 0) return;
+            g = suggestions[pick - 1];
+        }
+    }
 
-    Game* g = games.findByGameID(id);
     if (g) {
         g->print();
     }
@@ -250,59 +422,283 @@ void AdminMenu::handleGameSearch(GameDynamicArray& games) {
 }
 
 /**
- * Filters games based on player count and allows sorting of the result.
- * Implements a Bubble Sort for organizing the filtered data.
+ * Filters games on any combination of player count, year range, play time,
+ * title text and availability, then lists them in the chosen order. The query plan is
+ * shown so the admin can see which index answered it.
  * @param games Reference to the inventory.
  */
 void AdminMenu::handleFilterAndSort(GameDynamicArray& games) {
-    int players = getValidInt("Enter number of players to filter by (1-100): ", 1, 100);
+    GameQuery query;
+    cout << "(Enter 0 to skip a numeric filter)\n";
+    query.players = getValidInt("Number of players (0-100): ", 0, 100);
+    query.yearFrom = getValidInt("Published from year (0-9999): ", 0, 9999);
+    query.yearTo = getValidInt("Published up to year (0-9999): ", 0, 9999);
+    query.maxPlayTime = getValidInt("Finishes within minutes (0-10000): ", 0, 10000);
+    cout << "Title contains (Enter to skip): ";
+    getline(cin, query.titleText);
+    query.availableOnly = getValidInt("Only games with copies available? (1 = yes, 0 = no): ", 0, 1) == 1;
+
+    cout << "\nSort results by:\n";
+    cout << "1. Year Published\n";
+    cout << "2. Max Player Count\n";
+    cout << "0. Title\n";
+
+    int sortChoice = getValidInt("Choice: ", 0, 2);
+    if (sortChoice == 1) query.sortKey = GameQuery::BY_YEAR;
+    else if (sortChoice == 2) query.sortKey = GameQuery::BY_MAX_PLAYERS;
+
+    QueryResult result;
+    games.runQuery(query, result);
+    cout << "[PLAN] " << result.plan << "\n";
+
+    if (result.totalMatches == 0) {
+        cout << "[INFO] No games match those filters.\n";
+        return;
+    }
 
     GameDynamicArray filtered;
+    for (int i = 0; i < (int)result.games.size(); i++) {
+        filtered.add(*result.games[i]);
+    }
+    displayGamesTable(filtered);
+}
 
-    for (int i = 0; i < games.size(); i++) {
-        Game g = games.get(i);
-        if (players >= g.getMinPlayers() && players <= g.getMaxPlayers()) {
-            filtered.add(g);
-        }
+/**
+ * Lists every borrow (active, returned or archived) made within a date range.
+ * @param records Borrow history with its date index.
+ * @param games Catalog used to show titles.
+ */
+void AdminMenu::handleBorrowsBetween(BorrowLinkedList& records, GameDynamicArray& games) {
+    Date from = getValidDate("From date (YYYY-MM-DD): ");
+    Date to = getValidDate("To date (YYYY-MM-DD): ");
+    if (to < from) {
+        Date swap = from;
+        from = to;
+        to = swap;
     }
 
-    if (filtered.size() == 0) {
-        cout << "[INFO] No games found that support " << players << " players.\n";
+    vector<BorrowRecord> found;
+    records.findBorrowedBetween(from, to, found);
+
+    cout << "\n--- Borrows from " << from << " to " << to << " ---\n";
+    if (found.empty()) {
+        cout << "No borrows in this period.\n";
         return;
     }
+    ConsoleRenderer out;
+    out.column("Borrowed", 12).column("User", 8).column("Game", 7).column("Returned", 12).text("Title\n");
+    for (int i = 0; i < (int)found.size(); i++) renderBorrowRow(out, found[i], games);
+    out.number((long long)found.size()).text(" borrow(s) found.\n");
+}
 
-    cout << "\nSort results by:\n";
-    cout << "1. Year Published\n";
-    cout << "2. Max Player Count\n";
-    cout << "0. Cancel (Don't sort)\n";
+/**
+ * Lists games that are still on loan after more than N days, oldest first.
+ * @param records Borrow history with its active-loan index.
+ * @param games Catalog used to show titles.
+ */
+void AdminMenu::handleOverdueLoans(BorrowLinkedList& records, GameDynamicArray& games) {
+    int days = getValidInt("Show loans older than how many days (0-3650)? ", 0, 3650);
+    Date today = Date::today();
 
-    int sortChoice = getValidInt("Choice: ", 0, 2);
+    vector<BorrowRecord*> found;
+    records.findActiveBorrowedBefore(today.addDays(-days), found);
 
-    if (sortChoice != 0) {
-        // Bubble Sort Algorithm
-        for (int i = 0; i < filtered.size() - 1; i++) {
-            for (int j = 0; j < filtered.size() - i - 1; j++) {
-                bool swapNeeded = false;
+    cout << "\n--- Loans out for more than " << days << " day(s) ---\n";
+    if (found.empty()) {
+        cout << "No loans found.\n";
+        return;
+    }
+    ConsoleRenderer out;
+    out.column("Borrowed", 12).column("User", 8).column("Game", 7).column("Days", 12).text("Title\n");
+    for (int i = 0; i < (int)found.size(); i++) {
+        Game* game = games.findByGameID(found[i]->getGameID());
+        out.date(found[i]->getBorrowDate()).text("  ");
+        out.column(found[i]->getUserID(), 8).column(found[i]->getGameID(), 7);
+        out.column(intToStr(found[i]->getBorrowDate().daysUntil(today)), 12);
+        out.text(game != nullptr ? game->getTitle() : "Unknown").newline();
+    }
+    out.number((long long)found.size()).text(" loan(s) found.\n");
+}
 
-                if (sortChoice == 1) {
-                    if (filtered.get(j).getYear() > filtered.get(j + 1).getYear())
-                        swapNeeded = true;
-                }
-                else if (sortChoice == 2) {
-                    if (filtered.get(j).getMaxPlayers() > filtered.get(j + 1).getMaxPlayers())
-                        swapNeeded = true;
-                }
+/**
+ * Lists loans that are past their due date, most overdue first.
+ * @param records Borrow history with its overdue tracker.
+ * @param games Catalog used to show titles.
+ */
+void AdminMenu::handleOverdueReport(BorrowLinkedList& records, GameDynamicArray& games) {
+    Date today = Date::today();
 
-                if (swapNeeded) {
-                    Game temp = filtered.get(j);
-                    *filtered.getPtr(j) = filtered.get(j + 1);
-                    *filtered.getPtr(j + 1) = temp;
-                }
-            }
+    vector<BorrowRecord*> found;
+    records.findOverdue(today, found);
+
+    cout << "\n--- Overdue Loans (loan period " << OverdueTracker::LOAN_PERIOD_DAYS << " days) ---\n";
+    if (found.empty()) {
+        cout << "No overdue loans.\n";
+        return;
+    }
+    ConsoleRenderer out;
+    out.column("Due", 12).column("User", 8).column("Game", 7).column("Days Late", 12).text("Title\n");
+    for (int i = 0; i < (int)found.size(); i++) {
+        Date due = OverdueTracker::dueDateFor(*found[i]);
+        Game* game = games.findByGameID(found[i]->getGameID());
+        out.date(due).text("  ");
+        out.column(found[i]->getUserID(), 8).column(found[i]->getGameID(), 7);
+        out.column(intToStr(due.daysUntil(today)), 12);
+        out.text(game != nullptr ? game->getTitle() : "Unknown").newline();
+    }
+    out.number((long long)found.size()).text(" overdue loan(s).\n");
+}
+
+/**
+ * Prints one leaderboard table.
+ */
+static void printLeaderboard(const vector<PopularityBoard::Entry>& ranked, GameDynamicArray& games,
+    const string& scoreLabel, bool wholeNumbers) {
+    if (ranked.empty()) {
+        cout << "No borrows recorded yet.\n";
+        return;
+    }
+    printColumn("Rank", 6);
+    printColumn("Game", 7);
+    printColumn(scoreLabel, 10);
+    cout << "Title\n";
+    for (int i = 0; i < (int)ranked.size(); i++) {
+        Game* game = games.findByGameID(ranked[i].gameID);
+        stringstream score;
+        score << fixed << setprecision(wholeNumbers ? 0 : 2) << ranked[i].score;
+        printColumn(intToStr(i + 1), 6);
+        printColumn(ranked[i].gameID, 7);
+        printColumn(score.str(), 10);
+        cout << (game != nullptr ? game->getTitle() : "(removed)") << "\n";
+    }
+}
+
+/**
+ * Shows the all-time most borrowed games and the currently trending ones.
+ * @param records Borrow history with its popularity board.
+ * @param games Catalog used to show titles.
+ */
+void AdminMenu::handleLeaderboard(BorrowLinkedList& records, GameDynamicArray& games) {
+    const PopularityBoard& board = records.getPopularity();
+
+    vector<PopularityBoard::Entry> ranked;
+    board.topBorrowed(PopularityBoard::CAPACITY, ranked);
+    cout << "\n--- Most Borrowed Games (all time) ---\n";
+    printLeaderboard(ranked, games, "Borrows", true);
+
+    ranked.clear();
+    board.topTrending(PopularityBoard::CAPACITY, Date::today(), ranked);
+    cout << "\n--- Trending Games (weight halves every " << PopularityBoard::HALF_LIFE_DAYS << " days) ---\n";
+    printLeaderboard(ranked, games, "Score", false);
+}
+
+/**
+ * Shows play-session statistics: most played games, and every player's win
+ * rate with their most frequent partner. All figures are read from the
+ * aggregates PlayStats keeps up to date.
+ * @param playStats Recorded sessions and their aggregates.
+ * @param games Catalog used to show titles.
+ * @param users Members, used to show names.
+ */
+void AdminMenu::handlePlayStats(PlayStats& playStats, GameDynamicArray& games, UserDynamicArray& users) {
+    cout << "\n--- Play Sessions (" << playStats.getSessionCount() << " recorded) ---\n";
+    if (playStats.getSessionCount() == 0) {
+        cout << "No play sessions recorded yet.\n";
+        return;
+    }
+
+    vector<pair<string, int>> topGames;
+    playStats.topGames(PLAY_STATS_LIST_SIZE, topGames);
+    cout << "\nMost played games:\n";
+    printColumn("Rank", 6);
+    printColumn("Game", 7);
+    printColumn("Plays", 7);
+    cout << "Title\n";
+    for (int i = 0; i < (int)topGames.size(); i++) {
+        Game* game = games.findByGameID(topGames[i].first);
+        printColumn(intToStr(i + 1), 6);
+        printColumn(topGames[i].first, 7);
+        printColumn(intToStr(topGames[i].second), 7);
+        cout << (game != nullptr ? game->getTitle() : "(removed)") << "\n";
+    }
+
+    vector<pair<string, PlayStats::PlayerRecord>> players;
+    playStats.playersByWinRate(players);
+    cout << "\nPlayers by win rate:\n";
+    printColumn("User", 7);
+    printColumn("Name", 12);
+    printColumn("Plays", 7);
+    printColumn("Wins", 6);
+    printColumn("Win %", 8);
+    cout << "Plays most with\n";
+    for (int i = 0; i < (int)players.size(); i++) {
+        const string& userID = players[i].first;
+        User* user = users.findByUserID(userID);
+        stringstream rate;
+        rate << fixed << setprecision(1) << playStats.getWinRate(userID) * 100.0;
+        PlayStats::Partner partner;
+        printColumn(userID, 7);
+        printColumn(user != nullptr ? user->getName() : "(unknown)", 12);
+        printColumn(intToStr(players[i].second.plays), 7);
+        printColumn(intToStr(players[i].second.wins), 6);
+        printColumn(rate.str(), 8);
+        if (playStats.getBestPartner(userID, partner)) {
+            cout << partner.userID << " (" << partner.sessions << " session(s))\n";
+        }
+        else {
+            cout << "-\n";
         }
     }
+}
 
-    displayGamesTable(filtered);
+/**
+ * Imports new games from an external CSV dump (columns matched by header
+ * name) and queues the enlarged catalog for saving.
+ * @param games Catalog that receives the new games.
+ * @param persistence Background writer that saves the catalog.
+ */
+void AdminMenu::handleImportGames(GameDynamicArray& games, PersistenceWorker& persistence) {
+    string filename;
+    cin.ignore(1000, '\n');
+    cout << "Enter the path of the CSV file to import: ";
+    getline(cin, filename);
+
+    GameImporter::Stats stats;
+    if (!GameImporter::importFile(filename, games, stats)) return;
+
+    stringstream seconds;
+    seconds << fixed << setprecision(2) << stats.seconds;
+    cout << "[SUCCESS] Read " << stats.rowsRead << " rows in " << seconds.str()
+         << " s (" << (long long)stats.rowsPerSecond << " rows/s).\n";
+    cout << "  Imported: " << stats.imported << " | Duplicate titles: " << stats.duplicates
+         << " | Rejected: " << stats.rejected << "\n";
+    if (stats.imported > 0) persistence.markGamesDirty(games);
+}
+
+/**
+ * Shows how much memory each catalog structure holds, in total and per game.
+ * @param games Catalog to measure.
+ */
+void AdminMenu::handleMemoryReport(GameDynamicArray& games) {
+    vector<pair<string, size_t>> footprint;
+    games.memoryFootprint(footprint);
+    int gameCount = games.size();
+
+    ConsoleRenderer out;
+    out.text("\n--- Catalog Memory Footprint (").number(gameCount).text(" games, ")
+       .number((long long)sizeof(Game)).text("-byte hot record) ---\n");
+    out.column("Structure", 36).column("Size", 14).text("Bytes/game\n");
+    size_t total = 0;
+    for (int i = 0; i < (int)footprint.size(); i++) {
+        total += footprint[i].second;
+        out.column(footprint[i].first, 36).column(intToStr((int)(footprint[i].second / 1024)) + " KB", 14);
+        if (gameCount > 0) out.number((long long)(footprint[i].second / gameCount));
+        out.newline();
+    }
+    out.column("Total", 36).column(intToStr((int)(total / 1024)) + " KB", 14);
+    if (gameCount > 0) out.number((long long)(total / gameCount));
+    out.newline();
+    out.text("(Indexes at 0 are built on first use.)\n");
 }
 
 /**
@@ -310,27 +706,496 @@ void AdminMenu::handleFilterAndSort(GameDynamicArray& games) {
  * @param list The dynamic array of games to display.
  */
 void AdminMenu::displayGamesTable(GameDynamicArray& list) {
-    cout << "\n" << string(75, '=') << endl;
-    printColumn("ID", 8);
-    printColumn("Title", 35);
-    printColumn("Players", 12);
-    printColumn("Year", 8);
-    cout << "Stock" << endl;
-    cout << string(75, '-') << endl;
+    ConsoleRenderer out;
+    out.newline().repeat('=', 75).newline();
+    out.column("ID", 8).column("Title", 35).column("Players", 12).column("Year", 8).text("Stock").newline();
+    out.repeat('-', 75).newline();
 
     for (int i = 0; i < list.size(); i++) {
-        Game g = list.get(i);
-        printColumn(g.getGameID(), 8);
+        const Game& g = list.get(i);
+        out.column(g.getGameID(), 8);
+
+        if (g.getTitle().length() > 32) out.column(g.getTitle().substr(0, 29) + "...", 35);
+        else out.column(g.getTitle(), 35);
+
+        out.column(intToStr(g.getMinPlayers()) + "-" + intToStr(g.getMaxPlayers()), 12);
+        out.column(intToStr(g.getYear()), 8);
+        out.number(g.getAvailableCopies()).text(" / ").number(g.getTotalCopies()).newline();
+    }
+    out.repeat('=', 75).newline();
+}
+/**
+ * Shows how often searches were answered from the query result cache, and
+ * how many cached results were dropped because the catalog or availability
+ * had changed since they were computed.
+ * @param games Catalog whose cache is reported.
+ */
+void AdminMenu::handleQueryCacheReport(const GameDynamicArray& games) {
+    QueryCache::Stats stats;
+    games.getQueryCache().getStats(stats);
+    long long lookups = stats.hits + stats.misses;
+
+    stringstream hitRate, missRate;
+    hitRate << fixed << setprecision(1) << (lookups > 0 ? 100.0 * stats.hits / lookups : 0.0) << "%";
+    missRate << fixed << setprecision(1) << (lookups > 0 ? 100.0 * stats.misses / lookups : 0.0) << "%";
+
+    cout << "\n--- Search Result Cache ---\n";
+    cout << "Lookups: " << lookups << "\n";
+    cout << "  Hits: " << stats.hits << " (" << hitRate.str() << ")\n";
+    cout << "  Misses: " << stats.misses << " (" << missRate.str() << "), of which stale: " << stats.stale << "\n";
+    cout << "Entries: " << stats.entries << "/" << QueryCache::MAX_ENTRIES
+         << " | Games held: " << stats.handles << " | Evictions: " << stats.evictions << "\n";
+}
+
+// most rejected lines listed individually after a batch
+static const int BATCH_REJECTIONS_SHOWN = 20;
+
+/**
+ * Applies a counter batch file ("action,userID,gameID" per line) and reports
+ * the result of every rejected line plus the totals and throughput.
+ * @param games Catalog whose copies change.
+ * @param users Members the borrows must belong to.
+ * @param records Borrow records that receive the changes.
+ * @param persistence Background writer and journal.
+ * @param sessions Warm member sessions to keep in step.
+ * @param recommender Recommendations fed by the borrows.
+ */
+void AdminMenu::handleBorrowBatch(GameDynamicArray& games, UserDynamicArray& users, BorrowLinkedList& records,
+    PersistenceWorker& persistence, SessionCache& sessions, Recommender& recommender) {
+    string filename;
+    cin.ignore(1000, '\n');
+    cout << "Enter the path of the batch file (action,userID,gameID per line): ";
+    getline(cin, filename);
+
+    vector<BorrowBatch::Operation> operations;
+    int malformed = 0;
+    if (!BorrowBatch::loadFile(filename, operations, malformed)) {
+        cout << "[ERROR] Could not open " << filename << "\n";
+        return;
+    }
+    if (operations.empty()) {
+        cout << "[INFO] The file has no borrow or return lines.\n";
+        return;
+    }
 
-        string displayTitle = g.getTitle();
-        if (displayTitle.length() > 32) displayTitle = displayTitle.substr(0, 29) + "...";
-        printColumn(displayTitle, 35);
+    BorrowBatch batch(games, users, records, persistence);
+    batch.attachSessions(&sessions);
+    batch.attachRecommender(&recommender);
+    vector<BorrowBatch::ItemResult> results;
+    BorrowBatch::Stats stats;
+    batch.apply(operations, results, stats);
 
-        string playerRange = intToStr(g.getMinPlayers()) + "-" + intToStr(g.getMaxPlayers());
-        printColumn(playerRange, 12);
-        printColumn(intToStr(g.getYear()), 8);
+    int shown = 0;
+    for (int i = 0; i < (int)results.size(); i++) {
+        if (results[i].outcome == BorrowBatch::APPLIED) continue;
+        if (shown++ >= BATCH_REJECTIONS_SHOWN) continue;
+        cout << "  #" << (i + 1) << " " << (operations[i].action == BorrowBatch::BORROW ? "borrow " : "return ")
+             << operations[i].userID << " " << operations[i].gameID << ": "
+             << BorrowBatch::describe(results[i].outcome) << "\n";
+    }
+    if (shown > BATCH_REJECTIONS_SHOWN) cout << "  ... and " << (shown - BATCH_REJECTIONS_SHOWN) << " more rejected.\n";
+
+    stringstream seconds;
+    seconds << fixed << setprecision(3) << stats.seconds;
+    cout << "[SUCCESS] Applied " << stats.applied << " of " << operations.size() << " operation(s) in "
+         << seconds.str() << " s (" << (long long)stats.operationsPerSecond << " operations/s).\n";
+    cout << "  Rejected: " << stats.rejected << " | Unreadable lines: " << malformed << "\n";
+    if (!stats.durable) cout << "[WARNING] The batch could not be written to the journal.\n";
+}
 
-        cout << g.getAvailableCopies() << " / " << g.getTotalCopies() << endl;
+// Runs a job BENCHMARK_RUNS times and returns the fastest run in milliseconds
+static double fastestRunMs(const function<void()>& job) {
+    double best = -1;
+    for (int run = 0; run < BENCHMARK_RUNS; run++) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        job();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (best < 0 || ms < best) best = ms;
+    }
+    return best;
+}
+
+/**
+ * Times the operations that use the shared thread pool, once on the calling
+ * thread only and once with the pool, and prints the speedup of each.
+ * Small inputs stay on one thread either way (see the grain sizes), so a
+ * speedup near 1.00x is expected until the data grows.
+ * @param games Catalog whose query indexes are rebuilt (a separate engine is
+ * used, so the catalog's own indexes and result cache are left untouched).
+ * @param records Borrow records whose history (including the archive) is scanned.
+ * @param pool Shared worker threads.
+ */
+void AdminMenu::handleParallelBenchmark(GameDynamicArray& games, BorrowLinkedList& records, ThreadPool& pool) {
+    string gamesText;
+    CSVHandler::readFile("games.csv", gamesText);
+
+    GameQuery fullScan;
+    fullScan.availableOnly = true;      // no index applies, so every game is checked
+    QueryEngine engine(games);
+    QueryResult result;
+
+    vector<string> names;
+    vector<function<void(ThreadPool*)>> jobs;
+
+    names.push_back("Parse games.csv (" + intToStr((int)(gamesText.size() / 1024)) + " KB)");
+    jobs.push_back([&gamesText](ThreadPool* workers) {
+        vector<GameRow> rows;
+        CSVHandler::parseChunked(workers, gamesText, CSVHandler::parseGameRows, rows);
+    });
+
+    names.push_back("Rebuild query indexes + full scan (" + intToStr(games.size()) + " games)");
+    jobs.push_back([&engine, &fullScan, &result](ThreadPool* workers) {
+        engine.attachThreadPool(workers);
+        engine.markStale();
+        engine.run(fullScan, result);
+    });
+
+    names.push_back("Scan full borrow history");
+    jobs.push_back([&records](ThreadPool* workers) {
+        records.attachThreadPool(workers);
+        vector<BorrowRecord> all;
+        records.collectAll(all);
+    });
+
+    long long stealsBefore = pool.getSteals();
+    ConsoleRenderer out;
+    out.text("\n--- Parallel Benchmark (").number(pool.getThreadCount())
+       .text(" worker thread(s), best of ").number(BENCHMARK_RUNS).text(" runs) ---\n");
+    out.column("Operation", 52).column("Serial ms", 12).column("Pool ms", 12).text("Speedup\n");
+    for (int j = 0; j < (int)jobs.size(); j++) {
+        const function<void(ThreadPool*)>& job = jobs[j];
+        double serial = fastestRunMs([&job]() { job(nullptr); });
+        double parallel = fastestRunMs([&job, &pool]() { job(&pool); });
+
+        stringstream serialText, parallelText, speedup;
+        serialText << fixed << setprecision(2) << serial;
+        parallelText << fixed << setprecision(2) << parallel;
+        speedup << fixed << setprecision(2) << (parallel > 0 ? serial / parallel : 1.0) << "x";
+        out.column(names[j], 52).column(serialText.str(), 12).column(parallelText.str(), 12)
+           .text(speedup.str()).newline();
+    }
+    out.text("Tasks stolen between workers: ").number(pool.getSteals() - stealsBefore).newline();
+
+    // Leave the archive scanning on the pool, as set up at startup
+    records.attachThreadPool(&pool);
+}
+
+/**
+ * Runs 'readers' reader tasks on the pool for SNAPSHOT_BENCHMARK_MS while the
+ * calling thread keeps changing the catalog, and counts the lookups made.
+ * @param read One lookup (position and game ID chosen by the caller).
+ * @param write One catalog change.
+ * @return Lookups per second over all readers.
+ */
+static double readsPerSecond(ThreadPool& pool, int readers, const vector<string>& ids,
+    const function<long long(int, const string&)>& read, const function<void()>& write) {
+    atomic<bool> stop(false);
+    vector<future<long long>> pending;
+    for (int r = 0; r < readers; r++) {
+        pending.push_back(pool.submit([&stop, &ids, &read, r]() {
+            unsigned int seed = 2654435761u * (unsigned int)(r + 1);
+            long long lookups = 0, checksum = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                seed = seed * 1103515245u + 12345u;
+                int index = (int)((seed >> 8) % ids.size());
+                checksum += read(index, ids[index]);
+                lookups++;
+            }
+            return (checksum == -1) ? 0 : lookups;     // keeps the reads from being optimized away
+        }));
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    chrono::steady_clock::time_point end = start + chrono::milliseconds(SNAPSHOT_BENCHMARK_MS);
+    while (chrono::steady_clock::now() < end) {
+        write();
+        this_thread::yield();
+    }
+    stop = true;
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long long total = 0;
+    for (int r = 0; r < readers; r++) total += pool.wait(pending[r]);
+    return total / seconds;
+}
+
+/**
+ * Compares catalog reads from published snapshots (lock-free, see
+ * CatalogVersions) with reads of the live catalog under one global lock, for
+ * 1 up to one reader per pool thread. Meanwhile this thread borrows and
+ * returns a copy of one game over and over, so versions keep being published
+ * and reclaimed. The catalog is left as it was.
+ * @param games Catalog to read (must have snapshots attached).
+ * @param pool Shared worker threads that run the readers.
+ */
+void AdminMenu::handleSnapshotBenchmark(GameDynamicArray& games, ThreadPool& pool) {
+    CatalogVersions* versions = games.getSnapshots();
+    if (versions == nullptr || games.size() == 0) {
+        cout << "[INFO] The catalog has no published snapshots to read.\n";
+        return;
+    }
+
+    vector<string> ids;
+    ids.reserve(games.size());
+    Game* toggled = nullptr;
+    for (int i = 0; i < games.size(); i++) {
+        ids.push_back(games.get(i).getGameID());
+        if (toggled == nullptr && games.get(i).getAvailableCopies() > 0) toggled = &games.get(i);
     }
-    cout << string(75, '=') << endl;
-}
\ No newline at end of file
+
+    // Every write really changes a game, so one chunk is copied per publication
+    bool lent = false;
+    mutex catalogLock;
+    function<void()> change = [&games, &lent, toggled]() {
+        if (toggled != nullptr) {
+            if (lent) toggled->incrementAvailable();
+            else toggled->decrementAvailable();
+            lent = !lent;
+        }
+        games.markAvailabilityChanged(toggled);
+    };
+    function<void()> lockedChange = [&catalogLock, &change]() {
+        lock_guard<mutex> lock(catalogLock);
+        change();
+    };
+
+    function<long long(int, const string&)> snapshotRead = [versions](int position, const string& gameID) {
+        CatalogVersions::Reader reader(*versions);
+        const CatalogSnapshot& snapshot = reader.snapshot();
+        const GameView* game = snapshot.findByGameID(gameID);
+        return (long long)snapshot.get(position % snapshot.size()).availableCopies + (game != nullptr ? game->year : 0);
+    };
+    function<long long(int, const string&)> lockedRead = [&games, &catalogLock](int position, const string& gameID) {
+        lock_guard<mutex> lock(catalogLock);
+        const Game* game = games.findByGameID(gameID);
+        return (long long)games.get(position).getAvailableCopies() + (game != nullptr ? game->getYear() : 0);
+    };
+
+    CatalogVersions::Stats before;
+    versions->getStats(before);
+    ConsoleRenderer out;
+    out.text("\n--- Snapshot Read Benchmark (").number(games.size()).text(" games, ")
+       .number(SNAPSHOT_BENCHMARK_MS).text(" ms per row, writer changing the catalog) ---\n");
+    out.column("Readers", 10).column("Global lock reads/s", 22).column("Snapshot reads/s", 20).text("Speedup\n");
+    vector<int> readerCounts;
+    for (int readers = 1; readers < pool.getThreadCount(); readers *= 2) readerCounts.push_back(readers);
+    readerCounts.push_back(pool.getThreadCount());
+
+    double baseline = 0;
+    for (int c = 0; c < (int)readerCounts.size(); c++) {
+        int readers = readerCounts[c];
+        double locked = readsPerSecond(pool, readers, ids, lockedRead, lockedChange);
+        double lockFree = readsPerSecond(pool, readers, ids, snapshotRead, change);
+        if (c == 0) baseline = lockFree;
+
+        stringstream lockedText, lockFreeText, speedup;
+        lockedText << fixed << setprecision(0) << locked;
+        lockFreeText << fixed << setprecision(0) << lockFree;
+        speedup << fixed << setprecision(2) << (locked > 0 ? lockFree / locked : 1.0) << "x vs lock, "
+                << (baseline > 0 ? lockFree / baseline : 1.0) << "x vs 1 reader";
+        out.column(intToStr(readers), 10).column(lockedText.str(), 22).column(lockFreeText.str(), 20)
+           .text(speedup.str()).newline();
+    }
+    if (lent) change();     // give the borrowed copy back
+    versions->reclaim();
+
+    CatalogVersions::Stats after;
+    versions->getStats(after);
+    out.text("Versions published: ").number(after.published - before.published)
+       .text(" | reclaimed: ").number(after.reclaimed - before.reclaimed)
+       .text(" | still in grace period: ").number(after.pending).newline();
+    out.text("Chunks copied: ").number(after.chunksCopied - before.chunksCopied)
+       .text(" | shared with the previous version: ").number(after.chunksShared - before.chunksShared)
+       .text(" | ID index shards copied: ").number(after.shardsCopied - before.shardsCopied).newline();
+}
+
+/**
+ * Approximate usage dashboard: distinct members per most borrowed game (from
+ * the per-game HyperLogLogs) and the most viewed games (from the view
+ * Count-Min sketch). The distinct-member estimates are checked against an
+ * exact scan of the whole borrow history, and both are timed.
+ * @param games Catalog used for titles.
+ * @param records Borrow records whose popularity board holds the sketches.
+ * @param sessions Session cache that counts views.
+ */
+void AdminMenu::handleUsageAnalytics(GameDynamicArray& games, BorrowLinkedList& records, SessionCache& sessions) {
+    const PopularityBoard& board = records.getPopularity();
+    vector<PopularityBoard::Entry> ranked;
+    board.topBorrowed(PopularityBoard::CAPACITY, ranked);
+
+    ConsoleRenderer out;
+    out.text("\n--- Distinct Borrowers (HyperLogLog, about 4.6% standard error) ---\n");
+    if (ranked.empty()) {
+        out.text("No borrows recorded yet.\n");
+    }
+    else {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        vector<string> gameIDs;
+        vector<double> estimates;
+        for (int i = 0; i < (int)ranked.size(); i++) {
+            gameIDs.push_back(ranked[i].gameID);
+            estimates.push_back(board.estimateDistinctBorrowers(ranked[i].gameID));
+        }
+        double anyEstimate = board.estimateDistinctBorrowers(gameIDs);
+        double sketchMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        // Exact answer for comparison: every record, in memory and archived
+        start = chrono::steady_clock::now();
+        vector<BorrowRecord> all;
+        records.collectAll(all);
+        unordered_map<string, unordered_set<string>> members;
+        for (int i = 0; i < (int)gameIDs.size(); i++) members[gameIDs[i]];
+        unordered_set<string> anyMembers;
+        for (int i = 0; i < (int)all.size(); i++) {
+            unordered_map<string, unordered_set<string>>::iterator it = members.find(all[i].getGameID());
+            if (it == members.end()) continue;
+            it->second.insert(all[i].getUserID());
+            anyMembers.insert(all[i].getUserID());
+        }
+        double scanMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        out.column("Game", 7).column("Borrows", 10).column("~Members", 10).column("Exact", 8)
+           .column("Error", 9).text("Title\n");
+        for (int i = 0; i < (int)gameIDs.size(); i++) {
+            int exact = (int)members[gameIDs[i]].size();
+            stringstream estimate, error;
+            estimate << fixed << setprecision(0) << estimates[i];
+            error << fixed << setprecision(1) << (exact > 0 ? 100.0 * (estimates[i] - exact) / exact : 0.0) << "%";
+            Game* game = games.findByGameID(gameIDs[i]);
+            out.column(gameIDs[i], 7).column(intToStr((int)ranked[i].score), 10).column(estimate.str(), 10)
+               .column(intToStr(exact), 8).column(error.str(), 9)
+               .text(game != nullptr ? game->getTitle() : "(removed)").newline();
+        }
+
+        stringstream anyText, sketchText, scanText;
+        anyText << fixed << setprecision(0) << anyEstimate;
+        sketchText << fixed << setprecision(3) << sketchMs;
+        scanText << fixed << setprecision(3) << scanMs;
+        out.text("Members who borrowed any of these games: ~").text(anyText.str())
+           .text(" (exact ").number((long long)anyMembers.size()).text(", from merged sketches)\n");
+        out.text("Sketches answered in ").text(sketchText.str()).text(" ms; the exact scan of ")
+           .number((long long)all.size()).text(" record(s) took ").text(scanText.str()).text(" ms.\n");
+    }
+
+    const CountMinSketch* views = sessions.getViewCounter();
+    out.text("\n--- Most Viewed Games (Count-Min sketch) ---\n");
+    if (views == nullptr || views->getTotal() == 0) {
+        out.text("No views recorded yet.\n");
+    }
+    else {
+        vector<CountMinSketch::HeavyHitter> viewed;
+        views->topItems(PopularityBoard::CAPACITY, viewed);
+        out.column("Rank", 6).column("Game", 7).column("~Views", 10).text("Title\n");
+        for (int i = 0; i < (int)viewed.size(); i++) {
+            Game* game = games.findByGameID(viewed[i].item);
+            out.column(intToStr(i + 1), 6).column(viewed[i].item, 7).column(intToStr((int)viewed[i].count), 10)
+               .text(game != nullptr ? game->getTitle() : "(removed)").newline();
+        }
+        out.text("Views counted: ").number(views->getTotal()).text(" | each count is at most ")
+           .number(views->errorBound()).text(" too high (with 98% probability)\n");
+    }
+
+    out.text("Sketch memory: ").number((long long)(board.sketchMemoryUsage() / 1024)).text(" KB distinct borrowers, ")
+       .number((long long)((views != nullptr ? views->memoryUsage() : 0) / 1024)).text(" KB views\n");
+}
+
+/**
+ * Borrow record storage: shows whether the records live in borrow_records.csv
+ * or in the binary borrow log. CSV storage can be converted to the log (the
+ * CSV is left as it is); the log can be exported back to CSV and searched by
+ * record ID or borrow date. Decoding the log is timed against parsing the
+ * same records as CSV text.
+ * @param records Borrow records (attached to the log after a conversion).
+ * @param borrowLog Binary borrow log, open when it is the primary store.
+ * @param games Catalog used for titles.
+ * @param persistence Background writer that syncs the log.
+ */
+void AdminMenu::handleBorrowStorage(BorrowLinkedList& records, BorrowLog& borrowLog,
+    GameDynamicArray& games, PersistenceWorker& persistence) {
+    cout << "\n--- Borrow Record Storage ---\n";
+    if (records.getLog() == nullptr) {
+        cout << "Records are stored in borrow_records.csv and rewritten after every change.\n";
+        cout << "1. Convert to the binary borrow log (" << borrowLog.getFilename() << ")\n";
+        cout << "0. Back\n";
+        if (getValidInt("Choice: ", 0, 1) == 0) return;
+
+        // The log starts from the records in memory, oldest first; archived ones stay in the archive
+        vector<BorrowRecord> current;
+        records.collectInMemory(current);
+        reverse(current.begin(), current.end());
+        if (!borrowLog.create(current)) {
+            cout << "[ERROR] Could not create " << borrowLog.getFilename() << ".\n";
+            return;
+        }
+        records.attachLog(&borrowLog);
+        persistence.markRecordsDirty(records);
+        cout << "[SUCCESS] " << borrowLog.getEntryCount() << " record(s) moved to " << borrowLog.getFilename()
+             << ". Returns now update entries in place; borrow_records.csv is only written on export.\n";
+        return;
+    }
+
+    vector<BorrowRecord> live;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    borrowLog.collectLive(live);
+    double decodeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    string text = CSVHandler::formatBorrowRecords(live);
+    vector<BorrowRecord> parsed;
+    start = chrono::steady_clock::now();
+    CSVHandler::parseBorrowRows(text, CSVHandler::findDataStart(text), text.size(), parsed);
+    double parseMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    stringstream decodeText, parseText;
+    decodeText << fixed << setprecision(3) << decodeMs;
+    parseText << fixed << setprecision(3) << parseMs;
+    cout << "Records are stored in " << borrowLog.getFilename() << ": " << borrowLog.getEntryCount()
+         << " entries (" << live.size() << " live), " << borrowLog.getStringCount() << " interned IDs, "
+         << (borrowLog.getFileBytes() / 1024) << " KB mapped.\n";
+    cout << "Decoding the live records took " << decodeText.str() << " ms; parsing them as CSV ("
+         << (text.size() / 1024) << " KB) takes " << parseText.str() << " ms.\n";
+    cout << "1. Export to borrow_records.csv\n";
+    cout << "2. Look up a record ID\n";
+    cout << "3. List logged borrows between two dates\n";
+    cout << "0. Back\n";
+    int choice = getValidInt("Choice: ", 0, 3);
+
+    if (choice == 1) {
+        if (borrowLog.exportCSV("borrow_records.csv")) {
+            cout << "[SUCCESS] Exported " << live.size() << " record(s) to borrow_records.csv.\n";
+        }
+        else {
+            cout << "[ERROR] Unable to write to borrow_records.csv\n";
+        }
+        return;
+    }
+    if (choice == 0) return;
+
+    vector<BorrowRecord> found;
+    if (choice == 2) {
+        string recordID;
+        cout << "Record ID: ";
+        cin >> recordID;
+        cin.ignore(1000, '\n');
+        borrowLog.findByRecordID(recordID, found);
+    }
+    else {
+        Date from = getValidDate("From date (YYYY-MM-DD): ");
+        Date to = getValidDate("To date (YYYY-MM-DD): ");
+        if (to < from) {
+            Date swap = from;
+            from = to;
+            to = swap;
+        }
+        borrowLog.findBorrowedBetween(from, to, found);
+    }
+
+    if (found.empty()) {
+        cout << "No matching entries in the log.\n";
+        return;
+    }
+    ConsoleRenderer out;
+    out.column("Borrowed", 12).column("User", 8).column("Game", 7).column("Returned", 12).text("Title\n");
+    for (int i = 0; i < (int)found.size(); i++) renderBorrowRow(out, found[i], games);
+    out.number((long long)found.size()).text(" entr").text(found.size() == 1 ? "y" : "ies")
+       .text(" found (archived ones included).\n");
+}
@@ -4,18 +4,42 @@
 #include "GameDynamicArray.h"
 #include "UserDynamicArray.h"
 #include "BorrowLinkedList.h"
+#include "PersistenceWorker.h"
+#include "PlayStats.h"
+#include "ThreadPool.h"
+#include "SessionCache.h"
+#include "Recommender.h"
+#include "BorrowLog.h"
 
 class AdminMenu {
 public:
-    static void show(GameDynamicArray& games, UserDynamicArray& users, BorrowLinkedList& records);
+    static void show(GameDynamicArray& games, UserDynamicArray& users, BorrowLinkedList& records,
+                     PersistenceWorker& persistence, PlayStats& playStats, ThreadPool& pool,
+                     SessionCache& sessions, Recommender& recommender, BorrowLog& borrowLog);
 
 private:
     // Helper logic functions
-    static void handleAddGame(GameDynamicArray& games);
-    static void handleRemoveGame(GameDynamicArray& games);
-    static void handleAddMember(UserDynamicArray& users);
+    static void handleAddGame(GameDynamicArray& games, PersistenceWorker& persistence);
+    static void handleRemoveGame(GameDynamicArray& games, PersistenceWorker& persistence);
+    static void handleAddMember(UserDynamicArray& users, PersistenceWorker& persistence);
+    static void handleFindMember(UserDynamicArray& users);
     static void handleGameSearch(GameDynamicArray& games);
     static void handleFilterAndSort(GameDynamicArray& games);
+    static void handleBorrowsBetween(BorrowLinkedList& records, GameDynamicArray& games);
+    static void handleOverdueLoans(BorrowLinkedList& records, GameDynamicArray& games);
+    static void handleOverdueReport(BorrowLinkedList& records, GameDynamicArray& games);
+    static void handleLeaderboard(BorrowLinkedList& records, GameDynamicArray& games);
+    static void handlePlayStats(PlayStats& playStats, GameDynamicArray& games, UserDynamicArray& users);
+    static void handleMemoryReport(GameDynamicArray& games);
+    static void handleImportGames(GameDynamicArray& games, PersistenceWorker& persistence);
+    static void handleQueryCacheReport(const GameDynamicArray& games);
+    static void handleParallelBenchmark(GameDynamicArray& games, BorrowLinkedList& records, ThreadPool& pool);
+    static void handleSnapshotBenchmark(GameDynamicArray& games, ThreadPool& pool);
+    static void handleUsageAnalytics(GameDynamicArray& games, BorrowLinkedList& records, SessionCache& sessions);
+    static void handleBorrowStorage(BorrowLinkedList& records, BorrowLog& borrowLog,
+                                    GameDynamicArray& games, PersistenceWorker& persistence);
+    static void handleBorrowBatch(GameDynamicArray& games, UserDynamicArray& users, BorrowLinkedList& records,
+                                  PersistenceWorker& persistence, SessionCache& sessions, Recommender& recommender);
 
     // Utility for the menu
     static void displayGamesTable(GameDynamicArray& list);
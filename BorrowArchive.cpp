@@ -0,0 +1,631 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Hot/Cold Tiering: Old returned borrows leave the in-memory linked list
+ * and move into immutable on-disk segments.
+ * - Columnar Compression: Each segment stores its columns separately; ID
+ * columns are dictionary-encoded and dates are delta-encoded, all as varints.
+ * - Segment Skipping: Per-segment date and user ID ranges are kept in a small
+ * manifest so queries only decode segments that can contain matches.
+ * - Segment Summaries: Each segment has a .sum file of pre-aggregated counts,
+ * so startup leaderboards, recommendations and member borrow counts never
+ * decode archived rows.
+ * - Parallel Scans: Counting and collecting queries decode the segments they
+ * need on the shared work-stealing pool, one task per range of segments.
+ * - Crash-Safe Segments: Segments and the manifest are synced and renamed into
+ * place, and records already sealed into a segment are never archived twice.
+ *****************************************************************************/
+
+#include "BorrowArchive.h"
+#include "CSVHandler.h"
+#include "GameDynamicArray.h"
+#include "ConsoleRenderer.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+using namespace std;
+
+static const char SEGMENT_MAGIC[4] = { 'B', 'S', 'G', '1' };
+
+// --- VARINT ENCODING ---
+
+static void putVarint(string& out, unsigned long long value) {
+    while (value >= 0x80) {
+        out += (char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += (char)value;
+}
+
+static bool getVarint(const string& in, size_t& pos, unsigned long long& value) {
+    value = 0;
+    int shift = 0;
+    while (pos < in.size() && shift < 64) {
+        unsigned char byte = (unsigned char)in[pos++];
+        value |= (unsigned long long)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+        shift += 7;
+    }
+    return false;
+}
+
+// Zig-zag maps small negative deltas to small unsigned values
+static unsigned long long zigzag(long long v) { return ((unsigned long long)v << 1) ^ (unsigned long long)(v >> 63); }
+static long long unzigzag(unsigned long long v) { return (long long)(v >> 1) ^ -(long long)(v & 1); }
+
+/**
+ * Dictionary-encodes one string column: distinct values first, then one
+ * varint code per row.
+ */
+static void putStringColumn(string& out, const vector<string>& values) {
+    map<string, int> codes;
+    vector<string> dictionary;
+    vector<int> rowCodes;
+    for (int i = 0; i < (int)values.size(); i++) {
+        map<string, int>::iterator it = codes.find(values[i]);
+        if (it == codes.end()) {
+            it = codes.insert(make_pair(values[i], (int)dictionary.size())).first;
+            dictionary.push_back(values[i]);
+        }
+        rowCodes.push_back(it->second);
+    }
+    putVarint(out, dictionary.size());
+    for (int i = 0; i < (int)dictionary.size(); i++) {
+        putVarint(out, dictionary[i].size());
+        out += dictionary[i];
+    }
+    for (int i = 0; i < (int)rowCodes.size(); i++) putVarint(out, rowCodes[i]);
+}
+
+static bool getStringColumn(const string& in, size_t& pos, int rows, vector<string>& values) {
+    unsigned long long dictSize, length, code;
+    if (!getVarint(in, pos, dictSize)) return false;
+    vector<string> dictionary;
+    for (unsigned long long i = 0; i < dictSize; i++) {
+        if (!getVarint(in, pos, length) || pos + length > in.size()) return false;
+        dictionary.push_back(in.substr(pos, (size_t)length));
+        pos += (size_t)length;
+    }
+    values.resize(rows);
+    for (int i = 0; i < rows; i++) {
+        if (!getVarint(in, pos, code) || code >= dictionary.size()) return false;
+        values[i] = dictionary[(size_t)code];
+    }
+    return true;
+}
+
+/** Numeric part of a record ID such as "BR42" (0 if it has none). */
+static int recordNumber(const string& recordID) {
+    int number = 0;
+    for (size_t i = 0; i < recordID.size(); i++) {
+        if (recordID[i] >= '0' && recordID[i] <= '9') number = number * 10 + (recordID[i] - '0');
+    }
+    return number;
+}
+
+/** borrow_archive_3.seg -> borrow_archive_3.sum */
+static string countsFileFor(const string& segmentFile) {
+    size_t dot = segmentFile.find_last_of('.');
+    return ((dot == string::npos) ? segmentFile : segmentFile.substr(0, dot)) + ".sum";
+}
+
+/** The four fields that identify one borrow (record IDs alone are reused). */
+static string identityKey(const BorrowRecord& record) {
+    stringstream key;
+    key << record.getRecordID() << ',' << record.getUserID() << ','
+        << record.getGameID() << ',' << record.getBorrowDate().toKey();
+    return key.str();
+}
+
+// --- ARCHIVE ---
+
+/**
+ * @param manifest Path of the summary file listing every segment.
+ * @param prefix File name prefix for segment files.
+ */
+BorrowArchive::BorrowArchive(const string& manifest, const string& prefix) {
+    manifestFile = manifest;
+    segmentPrefix = prefix;
+    totalRecords = 0;
+    segmentsRead = 0;
+    segmentsSkipped = 0;
+    segmentsFailed = 0;
+    pool = nullptr;
+}
+
+/** Sets the pool used to decode segments in parallel (nullptr = sequential). */
+void BorrowArchive::attachThreadPool(ThreadPool* workers) {
+    pool = workers;
+}
+
+/**
+ * Reads the manifest (summaries only; segment files stay on disk).
+ * @return False if there is no archive yet.
+ */
+bool BorrowArchive::load() {
+    ifstream file(manifestFile);
+    if (!file.is_open()) return false;
+
+    segments.clear();
+    totalRecords = 0;
+    string line;
+    while (getline(file, line)) {
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        if (line.empty()) continue;
+
+        stringstream ss(line);
+        SegmentInfo info;
+        string rowStr, minStr, maxStr;
+        getline(ss, info.filename, ',');
+        getline(ss, rowStr, ',');
+        getline(ss, minStr, ',');
+        getline(ss, maxStr, ',');
+        getline(ss, info.minUser, ',');
+        getline(ss, info.maxUser, ',');
+
+        info.rowCount = atoi(rowStr.c_str());
+        info.minDate = atoi(minStr.c_str());
+        info.maxDate = atoi(maxStr.c_str());
+        segments.push_back(info);
+        totalRecords += info.rowCount;
+    }
+    file.close();
+
+    // Counts come from the .sum files; a missing one (older archive, or a
+    // crash while sealing) is rebuilt once from its segment
+    int failedBefore = segmentsFailed;
+    for (int s = 0; s < (int)segments.size(); s++) {
+        SegmentInfo& info = segments[s];
+        info.counts.highestRecordNumber = 0;
+        if (readCounts(countsFileFor(info.filename), info.counts)) continue;
+
+        vector<BorrowRecord> rows;
+        if (!readSegment(info, rows)) continue;
+        summarize(rows, info.counts);
+        writeCounts(countsFileFor(info.filename), info.counts);
+    }
+    reportFailures(failedBefore);
+    return true;
+}
+
+/** Aggregates a segment's rows into its per-member and per-game counts. */
+void BorrowArchive::summarize(const vector<BorrowRecord>& rows, Counts& counts) {
+    map<pair<string, int>, int> gameDays;
+    set<pair<string, string>> borrowers;
+    counts.byUser.clear();
+    counts.highestRecordNumber = 0;
+    for (int i = 0; i < (int)rows.size(); i++) {
+        counts.byUser[rows[i].getUserID()]++;
+        gameDays[make_pair(rows[i].getGameID(), rows[i].getBorrowDate().toKey())]++;
+        borrowers.insert(make_pair(rows[i].getUserID(), rows[i].getGameID()));
+        int number = recordNumber(rows[i].getRecordID());
+        if (number > counts.highestRecordNumber) counts.highestRecordNumber = number;
+    }
+    counts.byGameDay.clear();
+    for (map<pair<string, int>, int>::const_iterator it = gameDays.begin(); it != gameDays.end(); ++it) {
+        GameDayCount entry = { it->first.first, it->first.second, it->second };
+        counts.byGameDay.push_back(entry);
+    }
+    counts.borrowers.assign(borrowers.begin(), borrowers.end());
+}
+
+/**
+ * Writes a segment's counts, one per line:
+ * R,highestRecordNumber / U,userID,count / G,gameID,yyyymmdd,count / P,userID,gameID
+ */
+bool BorrowArchive::writeCounts(const string& filename, const Counts& counts) {
+    stringstream out;
+    out << "R," << counts.highestRecordNumber << "\n";
+    for (unordered_map<string, int>::const_iterator it = counts.byUser.begin(); it != counts.byUser.end(); ++it) {
+        out << "U," << it->first << "," << it->second << "\n";
+    }
+    for (int i = 0; i < (int)counts.byGameDay.size(); i++) {
+        out << "G," << counts.byGameDay[i].gameID << "," << counts.byGameDay[i].day << ","
+            << counts.byGameDay[i].count << "\n";
+    }
+    for (int i = 0; i < (int)counts.borrowers.size(); i++) {
+        out << "P," << counts.borrowers[i].first << "," << counts.borrowers[i].second << "\n";
+    }
+    return CSVHandler::writeFile(filename, out.str());
+}
+
+/**
+ * Reads a .sum file written by writeCounts.
+ * @return False if it is missing or does not start with the R line.
+ */
+bool BorrowArchive::readCounts(const string& filename, Counts& counts) {
+    ifstream file(filename);
+    if (!file.is_open()) return false;
+
+    Counts loaded;
+    loaded.highestRecordNumber = 0;
+    bool sawHeader = false;
+    string line;
+    while (getline(file, line)) {
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        stringstream ss(line);
+        string type, first, second, third;
+        getline(ss, type, ',');
+        getline(ss, first, ',');
+        getline(ss, second, ',');
+        getline(ss, third, ',');
+
+        if (type == "R") {
+            loaded.highestRecordNumber = atoi(first.c_str());
+            sawHeader = true;
+        }
+        else if (type == "U") {
+            loaded.byUser[first] += atoi(second.c_str());
+        }
+        else if (type == "G") {
+            GameDayCount entry = { first, atoi(second.c_str()), atoi(third.c_str()) };
+            loaded.byGameDay.push_back(entry);
+        }
+        else if (type == "P") {
+            loaded.borrowers.push_back(make_pair(first, second));
+        }
+    }
+    if (!sawHeader) return false;
+    counts = loaded;
+    return true;
+}
+
+/**
+ * Seals a batch of returned records into a new immutable segment and adds
+ * its summary to the manifest. Rows are sorted by borrow date first so the
+ * date column delta-encodes well. Both files are synced and renamed into
+ * place, and the segment is only counted once the manifest lists it, so a
+ * crash leaves at most an unlisted segment that the next write replaces.
+ * @param rows Records to archive (reordered in place).
+ * @return False if either file could not be written.
+ */
+bool BorrowArchive::writeSegment(vector<BorrowRecord>& rows) {
+    if (rows.empty()) return true;
+
+    sort(rows.begin(), rows.end(), [](const BorrowRecord& a, const BorrowRecord& b) {
+        return a.getBorrowDate() < b.getBorrowDate();
+    });
+
+    SegmentInfo info;
+    info.rowCount = (int)rows.size();
+    info.minDate = rows.front().getBorrowDate().toKey();
+    info.maxDate = rows.back().getBorrowDate().toKey();
+    info.minUser = info.maxUser = rows[0].getUserID();
+
+    vector<string> recordIDs, userIDs, gameIDs;
+    for (int i = 0; i < (int)rows.size(); i++) {
+        recordIDs.push_back(rows[i].getRecordID());
+        userIDs.push_back(rows[i].getUserID());
+        gameIDs.push_back(rows[i].getGameID());
+        if (rows[i].getUserID() < info.minUser) info.minUser = rows[i].getUserID();
+        if (rows[i].getUserID() > info.maxUser) info.maxUser = rows[i].getUserID();
+    }
+
+    string data(SEGMENT_MAGIC, 4);
+    putVarint(data, rows.size());
+    putStringColumn(data, recordIDs);
+    putStringColumn(data, userIDs);
+    putStringColumn(data, gameIDs);
+
+    // Dates are stored as yyyymmdd keys, the same form the manifest uses
+    long long previous = 0;
+    for (int i = 0; i < (int)rows.size(); i++) {
+        long long borrowKey = rows[i].getBorrowDate().toKey();
+        putVarint(data, zigzag(borrowKey - previous));
+        previous = borrowKey;
+    }
+    for (int i = 0; i < (int)rows.size(); i++) {
+        long long borrowKey = rows[i].getBorrowDate().toKey();
+        putVarint(data, zigzag(rows[i].getReturnDate().toKey() - borrowKey));
+    }
+
+    stringstream name;
+    name << segmentPrefix << (segments.size() + 1) << ".seg";
+    info.filename = name.str();
+    summarize(rows, info.counts);
+
+    if (!CSVHandler::writeFile(info.filename, data)) return false;
+    if (!writeCounts(countsFileFor(info.filename), info.counts)) return false;
+
+    // Rewrite the whole manifest (it is one short line per segment)
+    stringstream manifest;
+    for (int s = 0; s <= (int)segments.size(); s++) {
+        const SegmentInfo& entry = (s < (int)segments.size()) ? segments[s] : info;
+        manifest << entry.filename << "," << entry.rowCount << "," << entry.minDate << ","
+                 << entry.maxDate << "," << entry.minUser << "," << entry.maxUser << "\n";
+    }
+    if (!CSVHandler::writeFile(manifestFile, manifest.str())) return false;
+
+    segments.push_back(info);
+    totalRecords += info.rowCount;
+    return true;
+}
+
+/**
+ * Decodes a whole segment back into records. A missing or corrupt segment
+ * adds nothing to rows and is counted in getSegmentsFailed().
+ * @return False if the file is missing or corrupt.
+ */
+bool BorrowArchive::readSegment(const SegmentInfo& info, vector<BorrowRecord>& rows) const {
+    ifstream file(info.filename, ios::binary);
+    if (!file.is_open()) {
+        segmentsFailed++;
+        return false;
+    }
+    stringstream raw;
+    raw << file.rdbuf();
+    string data = raw.str();
+    segmentsRead++;
+
+    vector<BorrowRecord> decoded;
+    if (!decodeSegment(data, info.rowCount, decoded)) {
+        segmentsFailed++;
+        return false;
+    }
+    rows.insert(rows.end(), decoded.begin(), decoded.end());
+    return true;
+}
+
+/**
+ * Decodes the bytes of one segment.
+ * @param data Whole segment file.
+ * @param expectedRows Row count the manifest recorded for it.
+ * @param rows Receives the records.
+ * @return False if the bytes are corrupt or hold a different number of rows.
+ */
+bool BorrowArchive::decodeSegment(const string& data, int expectedRows, vector<BorrowRecord>& rows) {
+    if (data.size() < 4 || data.compare(0, 4, string(SEGMENT_MAGIC, 4)) != 0) return false;
+    size_t pos = 4;
+    unsigned long long count, value;
+    if (!getVarint(data, pos, count) || count != (unsigned long long)expectedRows) return false;
+    int n = (int)count;
+
+    vector<string> recordIDs, userIDs, gameIDs;
+    if (!getStringColumn(data, pos, n, recordIDs)) return false;
+    if (!getStringColumn(data, pos, n, userIDs)) return false;
+    if (!getStringColumn(data, pos, n, gameIDs)) return false;
+
+    vector<long long> borrowKeys(n);
+    long long previous = 0;
+    for (int i = 0; i < n; i++) {
+        if (!getVarint(data, pos, value)) return false;
+        previous += unzigzag(value);
+        borrowKeys[i] = previous;
+    }
+    for (int i = 0; i < n; i++) {
+        if (!getVarint(data, pos, value)) return false;
+        long long returnKey = borrowKeys[i] + unzigzag(value);
+        rows.push_back(BorrowRecord(recordIDs[i], userIDs[i], gameIDs[i],
+            Date::fromKey((int)borrowKeys[i]), Date::fromKey((int)returnKey)));
+    }
+    return pos == data.size();
+}
+
+/** @return True if the segment's user range could contain this user. */
+bool BorrowArchive::userInRange(const SegmentInfo& info, const string& userID) const {
+    return userID >= info.minUser && userID <= info.maxUser;
+}
+
+int BorrowArchive::getRecordCount() const { return totalRecords; }
+int BorrowArchive::getSegmentCount() const { return (int)segments.size(); }
+int BorrowArchive::getSegmentsRead() const { return segmentsRead; }
+int BorrowArchive::getSegmentsSkipped() const { return segmentsSkipped; }
+int BorrowArchive::getSegmentsFailed() const { return segmentsFailed; }
+
+/** @return Largest record number in any segment (keeps nextRecordID() from reusing one). */
+int BorrowArchive::getHighestRecordNumber() const {
+    int highest = 0;
+    for (int s = 0; s < (int)segments.size(); s++) {
+        if (segments[s].counts.highestRecordNumber > highest) highest = segments[s].counts.highestRecordNumber;
+    }
+    return highest;
+}
+
+/** Appends every segment's (game, borrow day, count) totals. */
+void BorrowArchive::collectGameDayCounts(vector<GameDayCount>& out) const {
+    for (int s = 0; s < (int)segments.size(); s++) {
+        out.insert(out.end(), segments[s].counts.byGameDay.begin(), segments[s].counts.byGameDay.end());
+    }
+}
+
+/**
+ * Appends (userID, gameID) for every member who borrowed a game in some
+ * segment; a pair may repeat across segments.
+ */
+void BorrowArchive::collectBorrowers(vector<pair<string, string>>& out) const {
+    for (int s = 0; s < (int)segments.size(); s++) {
+        out.insert(out.end(), segments[s].counts.borrowers.begin(), segments[s].counts.borrowers.end());
+    }
+}
+
+/**
+ * Warns that a query's archived results are incomplete.
+ * @param failedBefore getSegmentsFailed() from before the query ran.
+ */
+void BorrowArchive::reportFailures(int failedBefore) const {
+    int failed = segmentsFailed - failedBefore;
+    if (failed > 0) {
+        cout << "[ERROR] " << failed << " archive segment(s) could not be read; "
+             << "archived history in this result is incomplete.\n";
+    }
+}
+
+/**
+ * Removes from rows every record that is already sealed into a segment, so
+ * rows still in the live file after a crash mid-archive are not archived
+ * twice. Only segments whose date and user ranges overlap rows are opened.
+ * @param rows Candidates for archiving (filtered in place).
+ * @return Number of records removed.
+ */
+int BorrowArchive::removeArchived(vector<BorrowRecord>& rows) const {
+    if (rows.empty() || segments.empty()) return 0;
+    int failedBefore = segmentsFailed;
+
+    int minKey = rows[0].getBorrowDate().toKey(), maxKey = minKey;
+    string minUser = rows[0].getUserID(), maxUser = minUser;
+    for (int i = 1; i < (int)rows.size(); i++) {
+        int key = rows[i].getBorrowDate().toKey();
+        if (key < minKey) minKey = key;
+        if (key > maxKey) maxKey = key;
+        if (rows[i].getUserID() < minUser) minUser = rows[i].getUserID();
+        if (rows[i].getUserID() > maxUser) maxUser = rows[i].getUserID();
+    }
+
+    set<string> sealed;
+    for (int s = 0; s < (int)segments.size(); s++) {
+        if (segments[s].maxDate < minKey || segments[s].minDate > maxKey ||
+            segments[s].maxUser < minUser || segments[s].minUser > maxUser) {
+            segmentsSkipped++;
+            continue;
+        }
+        vector<BorrowRecord> archived;
+        readSegment(segments[s], archived);
+        for (int i = 0; i < (int)archived.size(); i++) sealed.insert(identityKey(archived[i]));
+    }
+    reportFailures(failedBefore);
+    if (sealed.empty()) return 0;
+
+    int kept = 0;
+    for (int i = 0; i < (int)rows.size(); i++) {
+        if (sealed.count(identityKey(rows[i])) == 0) rows[kept++] = rows[i];
+    }
+    int removed = (int)rows.size() - kept;
+    rows.resize(kept);
+    return removed;
+}
+
+/**
+ * Counts archived borrows for a user (every archived borrow is returned).
+ * Answered from the per-segment counts; no segment is opened.
+ * Time Complexity: O(segments)
+ */
+int BorrowArchive::countByUser(const string& userID) const {
+    int count = 0;
+    for (int s = 0; s < (int)segments.size(); s++) {
+        if (!userInRange(segments[s], userID)) continue;
+        unordered_map<string, int>::const_iterator it = segments[s].counts.byUser.find(userID);
+        if (it != segments[s].counts.byUser.end()) count += it->second;
+    }
+    return count;
+}
+
+/** Looks up a game title for display, "Unknown" if the game is gone. */
+static string titleFor(GameDynamicArray* games, const string& gameID) {
+    if (games == nullptr) return "Unknown";
+    Game* game = games->findByGameID(gameID);
+    return (game != nullptr) ? game->getTitle() : "Unknown";
+}
+
+/** Prints a user's archived borrows, newest segment first. */
+void BorrowArchive::printByUser(ConsoleRenderer& out, const string& userID, GameDynamicArray* games) const {
+    int failedBefore = segmentsFailed;
+    for (int s = (int)segments.size() - 1; s >= 0 && !out.isStopped(); s--) {
+        if (!userInRange(segments[s], userID)) {
+            segmentsSkipped++;
+            continue;
+        }
+        vector<BorrowRecord> rows;
+        readSegment(segments[s], rows);
+        for (int i = (int)rows.size() - 1; i >= 0; i--) {
+            if (rows[i].getUserID() != userID) continue;
+            out.text("---------------------\n");
+            rows[i].render(out, titleFor(games, rows[i].getGameID()));
+            if (!out.endRow()) return;
+        }
+    }
+    if (segmentsFailed > failedBefore) {
+        out.text("[ERROR] Some archive segments could not be read; this history is incomplete.\n");
+    }
+}
+
+/** Prints every archived borrow, newest segment first. */
+void BorrowArchive::printAll(ConsoleRenderer& out, GameDynamicArray* games) const {
+    int failedBefore = segmentsFailed;
+    for (int s = (int)segments.size() - 1; s >= 0 && !out.isStopped(); s--) {
+        vector<BorrowRecord> rows;
+        readSegment(segments[s], rows);
+        for (int i = (int)rows.size() - 1; i >= 0; i--) {
+            out.text("---------------------\n");
+            rows[i].render(out, titleFor(games, rows[i].getGameID()));
+            if (!out.endRow()) return;
+        }
+    }
+    if (segmentsFailed > failedBefore) {
+        out.text("[ERROR] Some archive segments could not be read; this history is incomplete.\n");
+    }
+}
+
+/**
+ * Appends archived borrows whose borrow date lies in [fromDate, toDate].
+ * Segments whose date range does not overlap are skipped unread.
+ * @param from Inclusive lower bound.
+ * @param to Inclusive upper bound.
+ * @param out Receives matching records.
+ */
+void BorrowArchive::collectBorrowedBetween(const Date& from, const Date& to, vector<BorrowRecord>& out) const {
+    int fromKey = from.toKey(), toKey = to.toKey();
+    int failedBefore = segmentsFailed;
+    vector<vector<BorrowRecord>> matches(segments.size());
+    parallelFor(pool, 0, (int)segments.size(), 1, [&](int first, int last) {
+        for (int s = first; s < last; s++) {
+            if (segments[s].maxDate < fromKey || segments[s].minDate > toKey) {
+                segmentsSkipped++;
+                continue;
+            }
+            vector<BorrowRecord> rows;
+            readSegment(segments[s], rows);
+            for (int i = 0; i < (int)rows.size(); i++) {
+                Date borrowed = rows[i].getBorrowDate();
+                if (borrowed >= from && borrowed <= to) matches[s].push_back(rows[i]);
+            }
+        }
+    });
+    for (int s = 0; s < (int)matches.size(); s++) out.insert(out.end(), matches[s].begin(), matches[s].end());
+    reportFailures(failedBefore);
+}
+
+/**
+ * Tells whether a borrow with all four key fields was archived. Only segments
+ * whose user and date ranges cover it are opened. Used by journal recovery so a
+ * logged borrow that has since been archived is not re-created as a loan.
+ */
+bool BorrowArchive::containsRecord(const string& recordID, const string& userID,
+                                   const string& gameID, const Date& borrowDate) const {
+    int key = borrowDate.toKey();
+    int failedBefore = segmentsFailed;
+    bool found = false;
+    for (int s = 0; s < (int)segments.size() && !found; s++) {
+        if (!userInRange(segments[s], userID) || segments[s].maxDate < key || segments[s].minDate > key) {
+            segmentsSkipped++;
+            continue;
+        }
+        vector<BorrowRecord> rows;
+        readSegment(segments[s], rows);
+        for (int i = 0; i < (int)rows.size(); i++) {
+            if (rows[i].getRecordID() == recordID && rows[i].getUserID() == userID &&
+                rows[i].getGameID() == gameID && rows[i].getBorrowDate() == borrowDate) {
+                found = true;
+                break;
+            }
+        }
+    }
+    reportFailures(failedBefore);
+    return found;
+}
+
+/** Appends every archived borrow (decodes all segments). */
+void BorrowArchive::collectAll(vector<BorrowRecord>& out) const {
+    int failedBefore = segmentsFailed;
+    vector<vector<BorrowRecord>> rows(segments.size());
+    parallelFor(pool, 0, (int)segments.size(), 1, [&](int first, int last) {
+        for (int s = first; s < last; s++) readSegment(segments[s], rows[s]);
+    });
+    for (int s = 0; s < (int)rows.size(); s++) out.insert(out.end(), rows[s].begin(), rows[s].end());
+    reportFailures(failedBefore);
+}
@@ -0,0 +1,101 @@
+#ifndef BORROWARCHIVE_H
+#define BORROWARCHIVE_H
+
+#include "BorrowRecord.h"
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+using namespace std;
+
+class GameDynamicArray;
+class ConsoleRenderer;
+class ThreadPool;
+
+/**
+ * Cold tier for borrow history.
+ * Returned records are written into immutable, compressed, column-oriented
+ * segment files. Only the per-segment summaries stay in memory: row count,
+ * borrow date and user ID ranges from the manifest, plus pre-aggregated
+ * counts from a small .sum file beside each segment (borrows per member, per
+ * game and day, and which members borrowed which games). Leaderboards, the
+ * recommender and per-member counts are built from those counts; segment
+ * contents are decoded lazily only when a query needs the rows themselves.
+ * Collecting queries decode their segments in parallel when a thread pool is
+ * attached.
+ */
+class BorrowArchive {
+public:
+    struct GameDayCount {
+        string gameID;
+        int day;            // yyyymmdd of the borrows
+        int count;
+    };
+
+private:
+    struct Counts {
+        unordered_map<string, int> byUser;      // userID -> borrows
+        vector<GameDayCount> byGameDay;
+        vector<pair<string, string>> borrowers; // distinct (userID, gameID)
+        int highestRecordNumber;
+    };
+
+    struct SegmentInfo {
+        string filename;
+        int rowCount;
+        int minDate;        // yyyymmdd of earliest borrow
+        int maxDate;        // yyyymmdd of latest borrow
+        string minUser;
+        string maxUser;
+        Counts counts;      // from the .sum file (rebuilt from the segment if missing)
+    };
+
+    string manifestFile;
+    string segmentPrefix;
+    vector<SegmentInfo> segments;
+    int totalRecords;
+    mutable atomic<int> segmentsRead;
+    mutable atomic<int> segmentsSkipped;
+    mutable atomic<int> segmentsFailed;     // missing or corrupt segments met by queries
+    ThreadPool* pool;       // decodes segments in parallel; nullptr = one at a time
+
+    bool readSegment(const SegmentInfo& info, vector<BorrowRecord>& rows) const;
+    static bool decodeSegment(const string& data, int expectedRows, vector<BorrowRecord>& rows);
+    static void summarize(const vector<BorrowRecord>& rows, Counts& counts);
+    static bool writeCounts(const string& filename, const Counts& counts);
+    static bool readCounts(const string& filename, Counts& counts);
+    void reportFailures(int failedBefore) const;
+    bool userInRange(const SegmentInfo& info, const string& userID) const;
+
+public:
+    BorrowArchive(const string& manifest = "borrow_archive.idx",
+                  const string& prefix = "borrow_archive_");
+
+    bool load();
+    void attachThreadPool(ThreadPool* workers);
+    bool writeSegment(vector<BorrowRecord>& rows);
+
+    int getRecordCount() const;
+    int getSegmentCount() const;
+    int getSegmentsRead() const;
+    int getSegmentsSkipped() const;
+    int getSegmentsFailed() const;
+    int getHighestRecordNumber() const;
+    int removeArchived(vector<BorrowRecord>& rows) const;
+
+    // Answered from the per-segment counts alone (no segment is opened)
+    int countByUser(const string& userID) const;
+    void collectGameDayCounts(vector<GameDayCount>& out) const;
+    void collectBorrowers(vector<pair<string, string>>& out) const;
+
+    // History queries (only segments whose summaries can match are opened)
+    void printByUser(ConsoleRenderer& out, const string& userID, GameDynamicArray* games = nullptr) const;
+    void printAll(ConsoleRenderer& out, GameDynamicArray* games = nullptr) const;
+    void collectBorrowedBetween(const Date& from, const Date& to, vector<BorrowRecord>& out) const;
+    void collectAll(vector<BorrowRecord>& out) const;
+    bool containsRecord(const string& recordID, const string& userID,
+                        const string& gameID, const Date& borrowDate) const;
+};
+
+#endif
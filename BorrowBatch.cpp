@@ -0,0 +1,256 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Single-Pass Validation: Each operation is checked against the copies left
+ * and a hash index of the loans still out, as the operations before it would
+ * leave them, so conflicts inside one batch are caught too.
+ * - All-or-Nothing Items: Nothing is changed until every operation has been
+ * validated, and applying an accepted operation cannot fail halfway.
+ * - One Durable Write: All applied borrows and returns go into the journal as
+ * one append, and the records and catalog are queued for saving once.
+ * - Per-Item Results: Every operation reports whether it was applied (with its
+ * record ID) or why it was rejected.
+ *****************************************************************************/
+
+#include "BorrowBatch.h"
+#include "CSVHandler.h"
+#include "SessionCache.h"
+#include "Recommender.h"
+#include <cctype>
+#include <chrono>
+#include <sstream>
+#include <unordered_map>
+using namespace std;
+
+// Key of the active-loan index (IDs never contain commas)
+static string loanKey(const string& userID, const string& gameID) {
+    return userID + "," + gameID;
+}
+
+static string lowerCase(string text) {
+    for (size_t i = 0; i < text.size(); i++) text[i] = (char)tolower((unsigned char)text[i]);
+    return text;
+}
+
+static string trimmed(const string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+/**
+ * Constructor.
+ * @param catalog Games whose copies are checked and updated.
+ * @param members Users a borrow must belong to.
+ * @param borrowRecords Borrow records that receive the changes.
+ * @param writer Background writer and journal.
+ */
+BorrowBatch::BorrowBatch(GameDynamicArray& catalog, UserDynamicArray& members,
+    BorrowLinkedList& borrowRecords, PersistenceWorker& writer)
+    : games(catalog), users(members), records(borrowRecords), persistence(writer) {
+    sessions = nullptr;
+    recommender = nullptr;
+}
+
+/** Keeps the warm member sessions' loans and counters in step with the batch. */
+void BorrowBatch::attachSessions(SessionCache* cache) {
+    sessions = cache;
+}
+
+/** Feeds applied borrows into the "also borrowed" recommendations. */
+void BorrowBatch::attachRecommender(Recommender* model) {
+    recommender = model;
+}
+
+/**
+ * Validates every operation, then applies the ones without a conflict.
+ * Operations are judged in order, so a return earlier in the batch frees a
+ * copy for a later borrow, and a borrow earlier in the batch can be returned
+ * later in it.
+ * Time Complexity: O(a + k log n) where a is the number of loans still out
+ * and k the number of operations
+ * @param operations Borrows and returns, in counter order.
+ * @param results Receives one result per operation, in the same order.
+ * @param stats Receives the applied/rejected counts and the throughput.
+ */
+void BorrowBatch::apply(const vector<Operation>& operations, vector<ItemResult>& results, Stats& stats) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int count = (int)operations.size();
+    ItemResult rejected = { NOT_BORROWED, "" };
+    results.assign(count, rejected);
+    stats.applied = stats.rejected = 0;
+    stats.durable = true;
+
+    // --- Pass 1: validate against the shelf and the loans still out ---
+    unordered_map<string, vector<Holding>> holdings;
+    vector<BorrowRecord*> active;
+    records.collectActive(active);
+    holdings.reserve(active.size() + count);
+    for (int i = 0; i < (int)active.size(); i++) {
+        Holding held = { active[i], -1 };
+        holdings[loanKey(active[i]->getUserID(), active[i]->getGameID())].push_back(held);
+    }
+
+    unordered_map<int, int> copiesLeft;     // catalog position -> copies after the earlier operations
+    vector<int> positions(count, -1);
+    vector<Holding> closes(count);          // the loan each accepted return closes
+    for (int i = 0; i < count; i++) {
+        const Operation& op = operations[i];
+        ItemResult& result = results[i];
+        int position = games.findIndexByGameID(op.gameID);
+
+        if (op.action == BORROW && users.findByUserID(op.userID) == nullptr) {
+            result.outcome = UNKNOWN_MEMBER;
+            continue;
+        }
+        if (position == -1) {
+            result.outcome = UNKNOWN_GAME;
+            continue;
+        }
+        unordered_map<int, int>::iterator copies = copiesLeft.find(position);
+        if (copies == copiesLeft.end()) {
+            copies = copiesLeft.insert(make_pair(position, games.get(position).getAvailableCopies())).first;
+        }
+
+        if (op.action == BORROW) {
+            vector<Holding>& held = holdings[loanKey(op.userID, op.gameID)];
+            if (copies->second <= 0) {
+                result.outcome = NO_COPIES;
+                continue;
+            }
+            if (!held.empty()) {
+                result.outcome = ALREADY_BORROWED;
+                continue;
+            }
+            Holding pending = { nullptr, i };
+            held.push_back(pending);
+            copies->second--;
+        }
+        else {
+            unordered_map<string, vector<Holding>>::iterator held = holdings.find(loanKey(op.userID, op.gameID));
+            if (held == holdings.end() || held->second.empty()) {
+                result.outcome = NOT_BORROWED;
+                continue;
+            }
+            closes[i] = held->second.back();    // the most recent loan, as findActiveBorrow picks
+            held->second.pop_back();
+            copies->second++;
+        }
+        result.outcome = APPLIED;
+        positions[i] = position;
+    }
+
+    // --- Pass 2: apply the accepted operations (none of these steps can fail) ---
+    Date today = Date::today();
+    vector<BorrowRecord*> created(count, nullptr);
+    vector<BorrowRecord> changes;
+    vector<pair<string, string>> borrowed;  // (userID, gameID) for the recommender
+    vector<string> changedGames;            // for the catalog snapshot
+    for (int i = 0; i < count; i++) {
+        if (results[i].outcome != APPLIED) {
+            stats.rejected++;
+            continue;
+        }
+        const Operation& op = operations[i];
+        Game& game = games.get(positions[i]);
+        SessionCache::Session* session = (sessions != nullptr) ? sessions->findWarm(op.userID) : nullptr;
+
+        if (op.action == BORROW) {
+            BorrowRecord record(records.nextRecordID(), op.userID, op.gameID, today, Date());
+            created[i] = records.insertFront(record);
+            game.decrementAvailable();
+            if (session != nullptr) sessions->recordBorrow(*session, record);
+            borrowed.push_back(make_pair(op.userID, op.gameID));
+            changes.push_back(record);
+            results[i].recordID = record.getRecordID();
+        }
+        else {
+            BorrowRecord* record = (closes[i].record != nullptr) ? closes[i].record
+                                                                 : created[closes[i].borrowOperation];
+            records.markReturned(record, today);
+            game.incrementAvailable();
+            if (session != nullptr) sessions->recordReturn(*session, *record);
+            changes.push_back(*record);
+            results[i].recordID = record->getRecordID();
+        }
+        changedGames.push_back(op.gameID);
+        stats.applied++;
+    }
+    if (recommender != nullptr && !borrowed.empty()) recommender->recordBorrows(borrowed);
+
+    // --- One journal append and one save for the whole batch ---
+    if (stats.applied > 0) {
+        shared_future<bool> durable = persistence.logBorrowBatch(changes);
+        games.markAvailabilityChanged(changedGames);
+        persistence.markRecordsDirty(records);
+        persistence.markGamesDirty(games);
+        stats.durable = durable.get();
+    }
+
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    stats.operationsPerSecond = (stats.seconds > 0) ? count / stats.seconds : 0;
+}
+
+/**
+ * Reads a batch file with one "action,userID,gameID" line per operation,
+ * where the action is borrow/b or return/r. An optional header line and
+ * blank lines are skipped.
+ * @param operations Receives the operations in file order.
+ * @param malformed Receives the number of lines that could not be read.
+ * @return False if the file cannot be opened.
+ */
+bool BorrowBatch::loadFile(const string& filename, vector<Operation>& operations, int& malformed) {
+    malformed = 0;
+    string contents;
+    if (!CSVHandler::readFile(filename, contents)) return false;
+
+    stringstream lines(contents);
+    string line;
+    bool firstLine = true;
+    while (getline(lines, line)) {
+        bool header = firstLine;
+        firstLine = false;
+        if (trimmed(line).empty()) continue;
+
+        stringstream fields(line);
+        string action, userID, gameID;
+        getline(fields, action, ',');
+        getline(fields, userID, ',');
+        getline(fields, gameID, ',');
+        action = lowerCase(trimmed(action));
+        userID = trimmed(userID);
+        gameID = trimmed(gameID);
+
+        Operation op;
+        if (action == "borrow" || action == "b") op.action = BORROW;
+        else if (action == "return" || action == "r") op.action = RETURN;
+        else {
+            if (!header) malformed++;
+            continue;
+        }
+        if (userID.empty() || gameID.empty()) {
+            malformed++;
+            continue;
+        }
+        op.userID = userID;
+        op.gameID = gameID;
+        operations.push_back(op);
+    }
+    return true;
+}
+
+/** @return Short text for an outcome, as shown in batch reports. */
+string BorrowBatch::describe(Outcome outcome) {
+    switch (outcome) {
+    case APPLIED: return "Applied";
+    case UNKNOWN_MEMBER: return "Unknown member";
+    case UNKNOWN_GAME: return "Unknown game";
+    case NO_COPIES: return "No copies available";
+    case ALREADY_BORROWED: return "Already on loan to this member";
+    case NOT_BORROWED: return "Not on loan to this member";
+    }
+    return "";
+}
@@ -0,0 +1,84 @@
+#ifndef BORROWBATCH_H
+#define BORROWBATCH_H
+
+#include "GameDynamicArray.h"
+#include "UserDynamicArray.h"
+#include "BorrowLinkedList.h"
+#include "PersistenceWorker.h"
+#include <string>
+#include <vector>
+using namespace std;
+
+class SessionCache;
+class Recommender;
+
+/**
+ * Applies many borrows and returns (for one or more members) in one go, as
+ * at the counter when a box of games comes back.
+ * Every operation is first validated, in order, against the copies on the
+ * shelf and an index of the loans still out, as they would stand after the
+ * operations before it. Only then are the accepted operations applied; a
+ * rejected one never leaves a partial change behind. The applied changes are
+ * journaled with one append (one fsync) and the records and catalog are
+ * queued for saving once per batch instead of once per game.
+ */
+class BorrowBatch {
+public:
+    enum Action { BORROW, RETURN };
+
+    enum Outcome {
+        APPLIED,
+        UNKNOWN_MEMBER,     // borrow for a user ID that does not exist
+        UNKNOWN_GAME,       // game ID not in the catalog
+        NO_COPIES,          // no copy left on the shelf
+        ALREADY_BORROWED,   // member already has this game on loan
+        NOT_BORROWED        // return for a game the member does not have on loan
+    };
+
+    struct Operation {
+        Action action;
+        string userID;
+        string gameID;
+    };
+
+    struct ItemResult {
+        Outcome outcome;
+        string recordID;    // borrow record created or closed (applied items only)
+    };
+
+    struct Stats {
+        int applied;
+        int rejected;
+        bool durable;       // the journal confirmed every applied change
+        double seconds;
+        double operationsPerSecond;
+    };
+
+    BorrowBatch(GameDynamicArray& catalog, UserDynamicArray& members,
+                BorrowLinkedList& borrowRecords, PersistenceWorker& writer);
+
+    // Optional collaborators kept in step with applied changes
+    void attachSessions(SessionCache* cache);
+    void attachRecommender(Recommender* model);
+
+    void apply(const vector<Operation>& operations, vector<ItemResult>& results, Stats& stats);
+
+    static bool loadFile(const string& filename, vector<Operation>& operations, int& malformed);
+    static string describe(Outcome outcome);
+
+private:
+    // A loan that is still out: an existing record, or a borrow earlier in the batch
+    struct Holding {
+        BorrowRecord* record;
+        int borrowOperation;
+    };
+
+    GameDynamicArray& games;
+    UserDynamicArray& users;
+    BorrowLinkedList& records;
+    PersistenceWorker& persistence;
+    SessionCache* sessions;
+    Recommender* recommender;
+};
+
+#endif
@@ -8,6 +8,15 @@
  * - Linear Search: O(n) traversal to find active borrows and user-specific records.
  * - Transaction Persistence: Serializes all borrow/return records to CSV for
  * data persistence and audit trail generation.
+ * - Date Index: Ordered indexes on borrow date answer "borrowed between" and
+ * "on loan since before" queries without walking the whole list.
+ * - Overdue Tracking: Active loans are also kept in a due-date min-heap, so the
+ * overdue report only touches overdue loans.
+ * - Live Leaderboards: Every insertion updates the popularity board, so "most
+ * borrowed", "trending" and "how many members borrowed it" never need a pass
+ * over the history.
+ * - Binary Primary Store: With a BorrowLog attached, each insertion appends a
+ * fixed-width entry and each return or archive move updates its entry in place.
  *****************************************************************************/
 
 /// Implementation of BorrowLinkedList - A linked list-based structure for managing borrow records
@@ -16,14 +25,31 @@
 
 #include "BorrowLinkedList.h"
 #include "GameDynamicArray.h"
+#include "BorrowArchive.h"
+#include "BorrowLog.h"
+#include "ConsoleRenderer.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <vector>
 using namespace std;
 
 /// Constructor - Initializes an empty linked list
 /// Time Complexity: O(1)
 BorrowLinkedList::BorrowLinkedList() {
     head = nullptr;  // Empty list starts with nullptr head
+    archive = nullptr;
+    log = nullptr;
+    highestRecordNumber = 0;
+}
+
+/// Numeric part of a record ID such as "BR42" (0 if it has none)
+static int recordNumber(const string& recordID) {
+    int number = 0;
+    for (size_t i = 0; i < recordID.size(); i++) {
+        if (recordID[i] >= '0' && recordID[i] <= '9') number = number * 10 + (recordID[i] - '0');
+    }
+    return number;
 }
 
 /// Destructor - Deallocates all nodes in the linked list
@@ -41,12 +67,106 @@ BorrowLinkedList::~BorrowLinkedList() {
 /// Inserts a new borrow record at the front of the linked list
 /// This is the primary insertion method. New records are always added at the front
 /// for O(1) insertion time. The list is not ordered by date - newest records are at front.
-/// Time Complexity: O(1)
-void BorrowLinkedList::insertFront(const BorrowRecord& br) {
+/// Time Complexity: O(log n) for the indexes
+/// @return The stored record (nodes never move, so the pointer stays valid)
+BorrowRecord* BorrowLinkedList::insertFront(const BorrowRecord& br) {
     Node* newNode = new Node;
     newNode->data = br;
     newNode->next = head;  // Link new node to current head
     head = newNode;        // New node becomes the new head
+
+    // Nodes never move, so the index can point straight at their records
+    int day = br.getBorrowDate().getDays();
+    byBorrowDate.insert(make_pair(day, &newNode->data));
+    if (!br.isReturned()) activeByBorrowDate.insert(make_pair(day, &newNode->data));
+    overdue.add(&newNode->data);
+    popularity.recordBorrow(br.getGameID(), br.getUserID(), br.getBorrowDate());
+    if (log != nullptr) log->append(br);
+
+    int number = recordNumber(br.getRecordID());
+    if (number > highestRecordNumber) highestRecordNumber = number;
+    return &newNode->data;
+}
+
+/// Returns the ID for the next borrow: continues after the highest record ID
+/// seen in memory or in the archive, so a new record never reuses an ID
+/// Time Complexity: O(1)
+string BorrowLinkedList::nextRecordID() const {
+    return "BR" + to_string(highestRecordNumber + 1);
+}
+
+/// Removes one record pointer from a borrow-date index
+/// Time Complexity: O(log n + d) where d is the number of records borrowed that day
+void BorrowLinkedList::unindex(multimap<int, BorrowRecord*>& index, BorrowRecord* record) {
+    pair<multimap<int, BorrowRecord*>::iterator, multimap<int, BorrowRecord*>::iterator> range =
+        index.equal_range(record->getBorrowDate().getDays());
+    for (multimap<int, BorrowRecord*>::iterator it = range.first; it != range.second; ++it) {
+        if (it->second == record) {
+            index.erase(it);
+            return;
+        }
+    }
+}
+
+/// Sets a record's return date and drops it from the active-loan indexes
+/// All returns must go through here (not BorrowRecord::setReturnDate) to keep the index right.
+/// Time Complexity: O(log n + d)
+void BorrowLinkedList::markReturned(BorrowRecord* record, const Date& returnDate) {
+    if (record == nullptr || record->isReturned()) return;
+    record->setReturnDate(returnDate);
+    if (record->isReturned()) {
+        unindex(activeByBorrowDate, record);
+        overdue.remove(record);
+        if (log != nullptr) log->markReturned(*record);
+    }
+}
+
+/// Collects records (including archived ones) borrowed on or between two dates, oldest first
+/// Time Complexity: O(log n + k) for the in-memory records, plus any archive segments in range
+void BorrowLinkedList::findBorrowedBetween(const Date& from, const Date& to, vector<BorrowRecord>& out) const {
+    size_t first = out.size();
+    if (archive != nullptr) archive->collectBorrowedBetween(from, to, out);
+    bool hasArchived = out.size() > first;
+
+    multimap<int, BorrowRecord*>::const_iterator it = byBorrowDate.lower_bound(from.getDays());
+    multimap<int, BorrowRecord*>::const_iterator end = byBorrowDate.upper_bound(to.getDays());
+    for (; it != end; ++it) out.push_back(*it->second);
+
+    // Archived and in-memory records can overlap in date, so merge them into one order
+    if (hasArchived) {
+        stable_sort(out.begin() + first, out.end(), [](const BorrowRecord& a, const BorrowRecord& b) {
+            return a.getBorrowDate() < b.getBorrowDate();
+        });
+    }
+}
+
+/// Collects loans that are still out and were borrowed before the cut-off, oldest first
+/// Used for overdue reports ("on loan for more than N days"). Loans without a
+/// valid borrow date sort first in the index and are skipped: their age is unknown.
+/// Time Complexity: O(log n + k)
+void BorrowLinkedList::findActiveBorrowedBefore(const Date& cutoff, vector<BorrowRecord*>& out) const {
+    multimap<int, BorrowRecord*>::const_iterator it = activeByBorrowDate.upper_bound(Date().getDays());
+    multimap<int, BorrowRecord*>::const_iterator end = activeByBorrowDate.lower_bound(cutoff.getDays());
+    for (; it != end; ++it) {
+        out.push_back(it->second);
+    }
+}
+
+/// Collects a user's loans that are still out, oldest first
+/// Used to warm a member's session at their first login.
+/// Time Complexity: O(a) where a is the number of active loans (all members)
+void BorrowLinkedList::findActiveByUser(const string& userID, vector<BorrowRecord*>& out) const {
+    for (multimap<int, BorrowRecord*>::const_iterator it = activeByBorrowDate.begin(); it != activeByBorrowDate.end(); ++it) {
+        if (it->second->getUserID() == userID) out.push_back(it->second);
+    }
+}
+
+/// Collects every loan that is still out, oldest borrow first
+/// Time Complexity: O(a) where a is the number of active loans
+void BorrowLinkedList::collectActive(vector<BorrowRecord*>& out) const {
+    for (multimap<int, BorrowRecord*>::const_iterator it = activeByBorrowDate.begin(); it != activeByBorrowDate.end(); ++it) {
+        out.push_back(it->second);
+    }
 }
 
 /// Searches for an active (not yet returned) borrow record for a specific user and game
@@ -67,66 +187,187 @@ BorrowRecord* BorrowLinkedList::findActiveBorrow(const string& userID, const str
     return nullptr;  // No active borrow found
 }
 
+/// Searches for the exact record (active or returned) matching all four key fields
+/// Used by journal recovery to tell whether a logged borrow already made it into the CSV.
+/// Time Complexity: O(n) where n is the number of borrow records
+BorrowRecord* BorrowLinkedList::findRecord(const string& recordID, const string& userID,
+                                           const string& gameID, const Date& borrowDate) {
+    Node* cur = head;
+    while (cur != nullptr) {
+        if (cur->data.getRecordID() == recordID &&
+            cur->data.getUserID() == userID &&
+            cur->data.getGameID() == gameID &&
+            cur->data.getBorrowDate() == borrowDate) {
+            return &(cur->data);
+        }
+        cur = cur->next;
+    }
+    return nullptr;
+}
+
+/// Looks up a game title for display ("Unknown" without a catalog or if the game is gone)
+static const string& titleFor(GameDynamicArray* games, const string& gameID) {
+    static const string unknown = "Unknown";
+    if (games == nullptr) return unknown;
+    Game* game = games->findByGameID(gameID);
+    return (game != nullptr) ? game->getTitle() : unknown;
+}
+
 /// Displays all borrow records in the linked list
-/// Traverses the entire linked list and prints each record. If a games array is provided,
-/// it looks up and displays the game title; otherwise shows "Unknown" for the game name.
+/// Traverses the entire linked list and streams each record through one buffered
+/// renderer. If a games array is provided, it looks up and displays the game title;
+/// otherwise shows "Unknown" for the game name. With a page size the listing pauses
+/// every pageSize records and stops early if the admin asks it to.
 /// Used by admin menu to view all borrowing transactions.
-/// Time Complexity: O(n*m) where n is number of records and m is number of games (for lookup)
-void BorrowLinkedList::printAll(GameDynamicArray* games) const {
+/// Time Complexity: O(n) (titles come from the catalog's ID index)
+void BorrowLinkedList::printAll(GameDynamicArray* games, int pageSize) const {
+    ConsoleRenderer out;
+    out.setPageSize(pageSize);
     Node* cur = head;
     while (cur != nullptr) {
-        cout << "---------------------\n";
-        if (games != nullptr) {
-            // Look up the game name by game ID for better readability
-            string gameName = "Unknown";
-            for (int i = 0; i < games->size(); i++) {
-                if (games->get(i).getGameID() == cur->data.getGameID()) {
-                    gameName = games->get(i).getTitle();
-                    break;
-                }
-            }
-            cur->data.print(gameName);
-        } else {
-            cur->data.print();
-        }
+        out.text("---------------------\n");
+        cur->data.render(out, titleFor(games, cur->data.getGameID()));
+        if (!out.endRow()) return;
         cur = cur->next;
     }
+    // Older returned records live in the archive segments
+    if (archive != nullptr) archive->printAll(out, games);
 }
 
 /// Displays all borrow records for a specific user
 /// Traverses the linked list and displays only records belonging to the specified user.
 /// If a games array is provided, it looks up and displays game titles.
 /// Used in the member menu to show individual user's borrow history.
-/// Time Complexity: O(n*m) where n is number of records and m is number of games (for lookup)
+/// Time Complexity: O(n) (titles come from the catalog's ID index)
 void BorrowLinkedList::printByUser(const string& userID, GameDynamicArray* games) const {
+    ConsoleRenderer out;
     Node* cur = head;
     while (cur != nullptr) {
         // Only print records belonging to this user
         if (cur->data.getUserID() == userID) {
-            cout << "---------------------\n";
-            if (games != nullptr) {
-                // Look up the game name by game ID for better readability
-                string gameName = "Unknown";
-                for (int i = 0; i < games->size(); i++) {
-                    if (games->get(i).getGameID() == cur->data.getGameID()) {
-                        gameName = games->get(i).getTitle();
-                        break;
-                    }
-                }
-                cur->data.print(gameName);
-            } else {
-                cur->data.print();
-            }
+            out.text("---------------------\n");
+            cur->data.render(out, titleFor(games, cur->data.getGameID()));
+            out.endRow();
         }
         cur = cur->next;
     }
+    if (archive != nullptr) archive->printByUser(out, userID, games);
+}
+
+/// Collects loans that are past their due date, most overdue first
+/// Time Complexity: O(k log k) for k overdue loans; loans that are not overdue are never visited
+void BorrowLinkedList::findOverdue(const Date& today, vector<BorrowRecord*>& out) const {
+    overdue.findOverdue(today, out);
+}
+
+/// Counts one member's overdue loans (used for the warning at member login)
+/// Time Complexity: O(k log k) for k overdue loans across all members
+int BorrowLinkedList::countOverdueByUser(const string& userID, const Date& today) const {
+    vector<BorrowRecord*> late;
+    overdue.findOverdue(today, late);
+    int count = 0;
+    for (int i = 0; i < (int)late.size(); i++) {
+        if (late[i]->getUserID() == userID) count++;
+    }
+    return count;
+}
+
+/// Copies every record, in-memory and archived (used to build the recommender)
+/// Time Complexity: O(n + a)
+void BorrowLinkedList::collectAll(vector<BorrowRecord>& out) const {
+    for (Node* cur = head; cur != nullptr; cur = cur->next) out.push_back(cur->data);
+    if (archive != nullptr) archive->collectAll(out);
+}
+
+/// Copies the records held in memory (not the archive), newest first
+/// Time Complexity: O(n)
+void BorrowLinkedList::collectInMemory(vector<BorrowRecord>& out) const {
+    for (Node* cur = head; cur != nullptr; cur = cur->next) out.push_back(cur->data);
+}
+
+/// Attaches the binary borrow log that mirrors every later change
+/// The log must already hold the records in memory (loaded from it or created from them).
+void BorrowLinkedList::attachLog(BorrowLog* binary) {
+    log = binary;
+}
+
+/// Attaches the cold tier; history queries, counts and leaderboards will include it
+/// Archived borrows are counted towards the popularity board once, here, from
+/// the archive's per-segment counts (no segment is decoded), and their record
+/// IDs are reserved so nextRecordID() never reissues one.
+/// Time Complexity: O(g + p) for g (game, day) totals and p (member, game) pairs
+void BorrowLinkedList::attachArchive(BorrowArchive* cold) {
+    archive = cold;
+    if (archive == nullptr) return;
+
+    vector<BorrowArchive::GameDayCount> gameDays;
+    archive->collectGameDayCounts(gameDays);
+    for (int i = 0; i < (int)gameDays.size(); i++) {
+        popularity.recordBorrows(gameDays[i].gameID, Date::fromKey(gameDays[i].day), gameDays[i].count);
+    }
+    vector<pair<string, string>> borrowers;
+    archive->collectBorrowers(borrowers);
+    for (int i = 0; i < (int)borrowers.size(); i++) {
+        popularity.recordBorrower(borrowers[i].second, borrowers[i].first);
+    }
+    if (archive->getHighestRecordNumber() > highestRecordNumber) {
+        highestRecordNumber = archive->getHighestRecordNumber();
+    }
 }
+
+/// Lets archive scans (history counts, collectAll) decode segments on a thread pool
+/// Does nothing if no archive is attached; pass nullptr to scan serially again.
+void BorrowLinkedList::attachThreadPool(ThreadPool* workers) {
+    if (archive != nullptr) archive->attachThreadPool(workers);
+}
+
+/// Moves returned records whose return date is before the cut-off into a new archive segment
+/// Active borrows are never archived, so findActiveBorrow and returns stay on the list.
+/// The records are only unlinked after the segment has been written successfully.
+/// Time Complexity: O(n) where n is the number of borrow records
+/// @param cutoff Records returned strictly before this date are archived
+/// @return Number of records moved (0 if no archive is attached or the write failed)
+int BorrowLinkedList::archiveReturnedBefore(const Date& cutoff) {
+    if (archive == nullptr) return 0;
+
+    vector<BorrowRecord> cold;
+    for (Node* cur = head; cur != nullptr; cur = cur->next) {
+        if (cur->data.isReturned() && cur->data.getReturnDate() < cutoff) {
+            cold.push_back(cur->data);
+        }
+    }
+    if (cold.empty()) return 0;
+    int moved = (int)cold.size();
+
+    // Rows left in the live file by a crash after their segment was sealed
+    // are only unlinked, not sealed again
+    archive->removeArchived(cold);
+    if (!archive->writeSegment(cold)) return 0;
+
+    // Unlink the archived nodes (same predicate as above)
+    Node** link = &head;
+    while (*link != nullptr) {
+        Node* cur = *link;
+        if (cur->data.isReturned() && cur->data.getReturnDate() < cutoff) {
+            unindex(byBorrowDate, &cur->data);
+            if (log != nullptr) log->markArchived(cur->data);
+            *link = cur->next;
+            delete cur;
+        }
+        else {
+            link = &cur->next;
+        }
+    }
+    return moved;
+}
+
 /// Writes all borrow records to a CSV file
+/// Only the in-memory (hot) records are written; archived records stay in their segments.
 /// Serializes the entire linked list to CSV format with the following columns:
 /// recordID, userID, gameID, borrowDate, returnDate
 /// This method is used during program shutdown to persist all borrow records.
 /// Time Complexity: O(n) where n is the number of borrow records
-void BorrowLinkedList::writeToCSV(ofstream& file) const {
+void BorrowLinkedList::writeToCSV(ostream& file) const {
     Node* cur = head;
     while (cur != nullptr) {
         BorrowRecord br = cur->data;
@@ -135,8 +376,8 @@ void BorrowLinkedList::writeToCSV(ofstream& file) const {
         file << br.getRecordID() << ","
             << br.getUserID() << ","
             << br.getGameID() << ","
-            << br.getBorrowDate() << ","
-            << br.getReturnDate() << "\n";
+            << br.getBorrowDate().toString() << ","
+            << br.getReturnDate().toString() << "\n";
 
         cur = cur->next;
     }
@@ -155,6 +396,8 @@ int BorrowLinkedList::countBorrowsByUser(const string& userID) const {
         }
         cur = cur->next;
     }
+    // Every archived record is a returned borrow
+    if (archive != nullptr) count += archive->countByUser(userID);
     return count;
 }
 
@@ -171,6 +414,8 @@ int BorrowLinkedList::countReturnsByUser(const string& userID) const {
         }
         cur = cur->next;
     }
+    // Every archived record is a returned borrow
+    if (archive != nullptr) count += archive->countByUser(userID);
     return count;
 }
 
@@ -2,8 +2,16 @@
 #define BORROWLINKEDLIST_H
 
 #include "BorrowRecord.h"
+#include "OverdueTracker.h"
+#include "PopularityBoard.h"
+#include <map>
+#include <ostream>
+#include <vector>
 
 class GameDynamicArray;
+class BorrowArchive;
+class BorrowLog;
+class ThreadPool;
 
 class BorrowLinkedList {
 private:
@@ -13,18 +21,59 @@ private:
     };
 
     Node* head;
+    BorrowArchive* archive;     // cold tier for old returned records (optional)
+    BorrowLog* log;             // binary primary store kept in step (optional)
+    int highestRecordNumber;    // largest numeric part of any record ID seen
+
+    // Borrow-date indexes (day number -> record) for range queries
+    multimap<int, BorrowRecord*> byBorrowDate;
+    multimap<int, BorrowRecord*> activeByBorrowDate;
+    OverdueTracker overdue;     // active loans ordered by due date
+    PopularityBoard popularity; // most borrowed / trending leaderboards
+
+    void unindex(multimap<int, BorrowRecord*>& index, BorrowRecord* record);
 
 public:
     BorrowLinkedList();
     ~BorrowLinkedList();
 
-    void insertFront(const BorrowRecord& br);
+    BorrowRecord* insertFront(const BorrowRecord& br);
+    string nextRecordID() const;
     BorrowRecord* findActiveBorrow(const string& userID, const string& gameID);
+    BorrowRecord* findRecord(const string& recordID, const string& userID,
+                             const string& gameID, const Date& borrowDate);
+    void markReturned(BorrowRecord* record, const Date& returnDate);
+
+    // Date range queries (O(log n + k) over the in-memory records)
+    void findBorrowedBetween(const Date& from, const Date& to, vector<BorrowRecord>& out) const;
+    void findActiveBorrowedBefore(const Date& cutoff, vector<BorrowRecord*>& out) const;
+    void findActiveByUser(const string& userID, vector<BorrowRecord*>& out) const;
+    void collectActive(vector<BorrowRecord*>& out) const;
+
+    // Overdue loans (due date = borrow date + OverdueTracker::LOAN_PERIOD_DAYS)
+    void findOverdue(const Date& today, vector<BorrowRecord*>& out) const;
+    int countOverdueByUser(const string& userID, const Date& today) const;
 
-    void printAll(GameDynamicArray* games = nullptr) const;
+    const PopularityBoard& getPopularity() const { return popularity; }
+    PopularityBoard& getPopularity() { return popularity; }     // for restoring saved sketches
+    void collectAll(vector<BorrowRecord>& out) const;
+    void collectInMemory(vector<BorrowRecord>& out) const;
+
+    // Listings stream through a buffered renderer; pageSize > 0 pauses every pageSize records
+    void printAll(GameDynamicArray* games = nullptr, int pageSize = 0) const;
     void printByUser(const string& userID, GameDynamicArray* games = nullptr) const;
-    void writeToCSV(ofstream& file) const;
+    void writeToCSV(ostream& file) const;
     bool isEmpty() const { return head == nullptr; }
+
+    // Hot/cold tiering: returned records older than the cut-off move to the archive
+    void attachArchive(BorrowArchive* cold);
+    void attachThreadPool(ThreadPool* workers);
+    int archiveReturnedBefore(const Date& cutoff);
+
+    // Binary borrow log as the primary store: borrows are appended to it and
+    // returns and archive moves update it in place (see BorrowLog)
+    void attachLog(BorrowLog* binary);
+    BorrowLog* getLog() const { return log; }
     
     // New helper methods for summary statistics
     int countBorrowsByUser(const string& userID) const;
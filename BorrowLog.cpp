@@ -0,0 +1,520 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Fixed-Width Entries: Each borrow record takes 32 bytes: interned string
+ * indexes for its IDs, day numbers for its dates and a flags word, so the
+ * n-th record sits at a computed offset and nothing has to be parsed.
+ * - Memory Mapping: The log is mapped into memory; reads decode entries
+ * straight from the mapping and the OS writes changed pages back.
+ * - Binary Search: Entries stay in record-number order, and an index of
+ * positions ordered by borrow day covers date ranges.
+ * - In-Place Updates: A return or archive move changes one entry's flags, and
+ * a borrow appends one entry, instead of rewriting a whole CSV file.
+ * - Ordered Appends: A new entry and any string it needs are flushed to disk
+ * before the header's entry count is bumped, so a crash never leaves a
+ * counted entry that was not written.
+ * - Validated Open: Every counted entry carries a checksum and must refer to
+ * strings the table has; a log that fails either check is refused instead
+ * of being loaded.
+ *****************************************************************************/
+
+#include "BorrowLog.h"
+#include "CSVHandler.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+static const char LOG_MAGIC[8] = { 'B', 'R', 'W', 'L', 'O', 'G', '0', '1' };
+static const uint32_t LOG_VERSION = 2;       // 1: entries without checksums
+
+struct BorrowLog::MappedFile {
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int fd;
+#endif
+};
+
+// Numeric part of a record ID ("BR42" -> 42), the order entries are kept in
+static uint32_t recordNumber(const string& recordID) {
+    uint32_t number = 0;
+    for (size_t i = 0; i < recordID.size(); i++) {
+        if (recordID[i] >= '0' && recordID[i] <= '9') number = number * 10 + (uint32_t)(recordID[i] - '0');
+    }
+    return number;
+}
+
+static long long fileSize(const string& name) {
+    ifstream file(name, ios::binary | ios::ate);
+    if (!file.is_open()) return -1;
+    return (long long)file.tellg();
+}
+
+/**
+ * Opens a C stream (fopen_s on MSVC, where fopen is flagged as unsafe).
+ * @return The stream, or nullptr on failure.
+ */
+static FILE* openStream(const string& name, const char* mode) {
+    FILE* stream = nullptr;
+#ifdef _WIN32
+    if (fopen_s(&stream, name.c_str(), mode) != 0) return nullptr;
+#else
+    stream = fopen(name.c_str(), mode);
+#endif
+    return stream;
+}
+
+/**
+ * Constructor; nothing is opened until open() or create().
+ * @param logPath Path of the fixed-width entry file.
+ * @param stringsPath Path of the interned string table (one string per line).
+ */
+BorrowLog::BorrowLog(const string& logPath, const string& stringsPath) {
+    static_assert(sizeof(Entry) == ENTRY_BYTES, "entries must stay fixed-width");
+    static_assert(sizeof(Header) == HEADER_BYTES, "the header must stay fixed-width");
+    filename = logPath;
+    stringFilename = stringsPath;
+    mapped = nullptr;
+    base = nullptr;
+    mappedBytes = 0;
+    stringFile = nullptr;
+}
+
+/** Unmaps the log; changed pages are still written back by the OS. */
+BorrowLog::~BorrowLog() {
+    close();
+}
+
+/** @return True if a log file is present (the binary log is the primary store). */
+bool BorrowLog::exists() const {
+    return fileSize(filename) >= HEADER_BYTES;
+}
+
+/**
+ * Maps the log file read/write, growing it to the given size first.
+ * @param bytes Size to map; 0 maps the file at its current size.
+ */
+bool BorrowLog::mapFile(size_t bytes) {
+    if (bytes == 0) {
+        long long size = fileSize(filename);
+        if (size < HEADER_BYTES) return false;
+        bytes = (size_t)size;
+    }
+    mapped = new MappedFile();
+#ifdef _WIN32
+    mapped->file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+                               OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    mapped->mapping = NULL;
+    if (mapped->file != INVALID_HANDLE_VALUE) {
+        // A mapping larger than the file extends the file to its size
+        mapped->mapping = CreateFileMappingA(mapped->file, NULL, PAGE_READWRITE,
+                                             (DWORD)((unsigned long long)bytes >> 32), (DWORD)bytes, NULL);
+    }
+    if (mapped->mapping != NULL) base = (char*)MapViewOfFile(mapped->mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+#else
+    mapped->fd = ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+    if (mapped->fd >= 0 && fileSize(filename) < (long long)bytes && ftruncate(mapped->fd, (off_t)bytes) != 0) {
+        ::close(mapped->fd);
+        mapped->fd = -1;
+    }
+    if (mapped->fd >= 0) {
+        void* view = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, mapped->fd, 0);
+        base = (view == MAP_FAILED) ? nullptr : (char*)view;
+    }
+#endif
+    if (base == nullptr) {
+        unmapFile();
+        return false;
+    }
+    mappedBytes = bytes;
+    return true;
+}
+
+void BorrowLog::unmapFile() {
+    if (mapped == nullptr) return;
+#ifdef _WIN32
+    if (base != nullptr) UnmapViewOfFile(base);
+    if (mapped->mapping != NULL) CloseHandle(mapped->mapping);
+    if (mapped->file != INVALID_HANDLE_VALUE) CloseHandle(mapped->file);
+#else
+    if (base != nullptr) munmap(base, mappedBytes);
+    if (mapped->fd >= 0) ::close(mapped->fd);
+#endif
+    delete mapped;
+    mapped = nullptr;
+    base = nullptr;
+    mappedBytes = 0;
+}
+
+/** Doubles the entry capacity: the file is extended and mapped again. */
+bool BorrowLog::grow() {
+    uint64_t capacity = header()->capacity * 2;
+    unmapFile();
+    if (!mapFile(HEADER_BYTES + (size_t)capacity * ENTRY_BYTES)) return false;
+    header()->capacity = capacity;
+    return true;
+}
+
+/** Reads the string table and rebuilds its lookup index. */
+bool BorrowLog::loadStrings() {
+    strings.clear();
+    stringIndex.clear();
+    string contents;
+    if (!CSVHandler::readFile(stringFilename, contents)) return false;
+
+    size_t start = 0;
+    while (start < contents.size()) {
+        size_t end = contents.find('\n', start);
+        if (end == string::npos) break;     // torn last line: never referenced by a counted entry
+        string text = contents.substr(start, end - start);
+        stringIndex[text] = (uint32_t)strings.size();
+        strings.push_back(text);
+        start = end + 1;
+    }
+    return true;
+}
+
+/** Forces the string table onto the disk (before any entry that refers to a new string). */
+bool BorrowLog::syncStrings() {
+    if (fflush(stringFile) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(stringFile)) == 0;
+#else
+    return fsync(fileno(stringFile)) == 0;
+#endif
+}
+
+/** Forces a run of mapped entries onto the disk (msync needs a page-aligned start). */
+bool BorrowLog::flushEntries(int first, int count) {
+    char* from = (char*)(entries() + first);
+    size_t bytes = (size_t)count * ENTRY_BYTES;
+#ifdef _WIN32
+    return FlushViewOfFile(from, bytes) != 0 && FlushFileBuffers(mapped->file) != 0;
+#else
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t offset = (size_t)(from - base) % page;
+    return msync(from - offset, bytes + offset, MS_SYNC) == 0;
+#endif
+}
+
+/** FNV-1a over every field but the checksum itself, so an all-zero entry never passes. */
+uint32_t BorrowLog::checksumOf(const Entry& entry) {
+    const unsigned char* bytes = (const unsigned char*)&entry;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(Entry, checksum); i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Maps an existing log and loads its string table. Every counted entry must
+ * pass its checksum and refer to strings the table has; appends flush both
+ * before counting an entry, so a failure means the files are damaged and the
+ * log is refused rather than partly loaded. Logs from version 1 (no
+ * checksums) are upgraded in place.
+ * @return False if there is no valid log.
+ */
+bool BorrowLog::open() {
+    close();
+    if (!mapFile(0)) return false;
+    Header* head = header();
+    bool upgrade = head->version == 1;
+    bool valid = memcmp(head->magic, LOG_MAGIC, sizeof(LOG_MAGIC)) == 0 &&
+                 (head->version == LOG_VERSION || upgrade) &&
+                 head->entryBytes == (uint32_t)ENTRY_BYTES && head->entryCount <= head->capacity &&
+                 HEADER_BYTES + head->capacity * ENTRY_BYTES <= mappedBytes;
+    if (!valid || !loadStrings()) {
+        close();
+        return false;
+    }
+
+    uint64_t count = head->entryCount;
+    for (uint64_t i = 0; i < count; i++) {
+        Entry& entry = entries()[i];
+        if (upgrade) entry.checksum = checksumOf(entry);
+        if (entry.recordID >= strings.size() || entry.userID >= strings.size() ||
+            entry.gameID >= strings.size() || entry.checksum != checksumOf(entry)) {
+            close();
+            return false;
+        }
+    }
+    if (upgrade) head->version = LOG_VERSION;
+    stringFile = openStream(stringFilename, "ab");
+    rebuildDateIndex();
+    return stringFile != nullptr;
+}
+
+/**
+ * Writes a new log holding the given records (replacing any existing log)
+ * and maps it.
+ * Time Complexity: O(n log n)
+ * @param records Records to store, in any order.
+ */
+bool BorrowLog::create(const vector<BorrowRecord>& records) {
+    close();
+    remove(filename.c_str());
+    strings.clear();
+    stringIndex.clear();
+    stringFile = openStream(stringFilename, "wb");
+    if (stringFile == nullptr) return false;
+
+    uint64_t capacity = INITIAL_CAPACITY;
+    while (capacity < records.size()) capacity *= 2;
+    if (!mapFile(HEADER_BYTES + (size_t)capacity * ENTRY_BYTES)) {
+        close();
+        return false;
+    }
+    Header* head = header();
+    memset(head, 0, HEADER_BYTES);
+    head->version = LOG_VERSION;
+    head->entryBytes = ENTRY_BYTES;
+    head->capacity = capacity;
+
+    vector<BorrowRecord> ordered(records);
+    stable_sort(ordered.begin(), ordered.end(), [](const BorrowRecord& a, const BorrowRecord& b) {
+        return recordNumber(a.getRecordID()) < recordNumber(b.getRecordID());
+    });
+    for (int i = 0; i < (int)ordered.size(); i++) fillEntry(entries()[i], ordered[i]);
+    head->entryCount = ordered.size();
+
+    // The magic goes in last: a log torn mid-conversion is never mistaken for a valid one
+    if (!syncStrings() || !flushEntries(0, (int)ordered.size())) {
+        close();
+        return false;
+    }
+    memcpy(head->magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+    rebuildDateIndex();
+    return sync();
+}
+
+/** Unmaps the log and closes the string table. */
+void BorrowLog::close() {
+    lock_guard<mutex> lock(mapLock);
+    unmapFile();
+    if (stringFile != nullptr) fclose(stringFile);
+    stringFile = nullptr;
+    byBorrowDate.clear();
+}
+
+/**
+ * @return The string's index in the table, appending it (to memory and to
+ * the table file) the first time it is seen.
+ */
+uint32_t BorrowLog::intern(const string& text) {
+    unordered_map<string, uint32_t>::iterator it = stringIndex.find(text);
+    if (it != stringIndex.end()) return it->second;
+    uint32_t index = (uint32_t)strings.size();
+    strings.push_back(text);
+    stringIndex[text] = index;
+    fputs(text.c_str(), stringFile);
+    fputc('\n', stringFile);
+    return index;
+}
+
+void BorrowLog::fillEntry(Entry& entry, const BorrowRecord& record) {
+    memset(&entry, 0, sizeof(Entry));
+    entry.recordNumber = recordNumber(record.getRecordID());
+    entry.recordID = intern(record.getRecordID());
+    entry.userID = intern(record.getUserID());
+    entry.gameID = intern(record.getGameID());
+    entry.borrowDay = record.getBorrowDate().getDays();
+    if (record.isReturned()) {
+        entry.returnDay = record.getReturnDate().getDays();
+        entry.flags |= RETURNED;
+    }
+    entry.checksum = checksumOf(entry);
+}
+
+BorrowRecord BorrowLog::toRecord(const Entry& entry) const {
+    Date returned = (entry.flags & RETURNED) ? Date::fromDays(entry.returnDay) : Date();
+    return BorrowRecord(strings[entry.recordID], strings[entry.userID], strings[entry.gameID],
+                        Date::fromDays(entry.borrowDay), returned);
+}
+
+// Entry positions ordered by borrow day (ties in file order)
+void BorrowLog::rebuildDateIndex() {
+    int count = getEntryCount();
+    byBorrowDate.resize(count);
+    for (int i = 0; i < count; i++) byBorrowDate[i] = i;
+    Entry* all = entries();
+    stable_sort(byBorrowDate.begin(), byBorrowDate.end(), [all](int a, int b) {
+        return all[a].borrowDay < all[b].borrowDay;
+    });
+}
+
+/**
+ * Adds a new record. Record IDs are issued in increasing order, so the entry
+ * normally goes at the end; an older ID (e.g. replayed from the journal) is
+ * moved into place.
+ * Time Complexity: O(log n) amortized at the end, O(n) otherwise
+ */
+bool BorrowLog::append(const BorrowRecord& record) {
+    lock_guard<mutex> lock(mapLock);
+    if (base == nullptr) return false;
+    if (header()->entryCount == header()->capacity && !grow()) return false;
+
+    size_t knownStrings = strings.size();
+    Entry entry;
+    fillEntry(entry, record);
+    if (strings.size() != knownStrings && !syncStrings()) return false;
+
+    int count = getEntryCount();
+    Entry* all = entries();
+    Entry* position = upper_bound(all, all + count, entry, [](const Entry& a, const Entry& b) {
+        return a.recordNumber < b.recordNumber;
+    });
+    int index = (int)(position - all);
+    if (index < count) memmove(all + index + 1, all + index, (size_t)(count - index) * sizeof(Entry));
+    all[index] = entry;
+    // The entry (and anything moved) reaches the disk before the count that makes it visible
+    if (!flushEntries(index, count + 1 - index)) return false;
+    header()->entryCount = count + 1;
+
+    if (index == count) {
+        vector<int>::iterator at = upper_bound(byBorrowDate.begin(), byBorrowDate.end(), entry.borrowDay,
+            [all](int day, int other) { return day < all[other].borrowDay; });
+        byBorrowDate.insert(at, index);
+    }
+    else {
+        rebuildDateIndex();
+    }
+    return true;
+}
+
+/**
+ * Finds the entry of a record, skipping entries that already have a flag set.
+ * @return The entry position, or -1.
+ * Time Complexity: O(log n + d) where d is the number of entries sharing the record number
+ */
+int BorrowLog::findEntry(const BorrowRecord& record, uint32_t skipFlag) const {
+    uint32_t number = recordNumber(record.getRecordID());
+    int count = getEntryCount();
+    const Entry* all = entries();
+    const Entry* first = lower_bound(all, all + count, number, [](const Entry& entry, uint32_t key) {
+        return entry.recordNumber < key;
+    });
+    for (const Entry* e = first; e != all + count && e->recordNumber == number; ++e) {
+        if ((e->flags & skipFlag) == 0 && e->borrowDay == record.getBorrowDate().getDays() &&
+            strings[e->recordID] == record.getRecordID() && strings[e->userID] == record.getUserID() &&
+            strings[e->gameID] == record.getGameID()) {
+            return (int)(e - all);
+        }
+    }
+    return -1;
+}
+
+/** Records a return by rewriting the entry's return day and flags in place. */
+bool BorrowLog::markReturned(const BorrowRecord& record) {
+    lock_guard<mutex> lock(mapLock);
+    if (base == nullptr || !record.isReturned()) return false;
+    int index = findEntry(record, RETURNED);
+    if (index < 0) return false;
+    entries()[index].returnDay = record.getReturnDate().getDays();
+    entries()[index].flags |= RETURNED;
+    entries()[index].checksum = checksumOf(entries()[index]);
+    return true;
+}
+
+/** Flags a record that moved to the archive, so it is no longer loaded or exported. */
+bool BorrowLog::markArchived(const BorrowRecord& record) {
+    lock_guard<mutex> lock(mapLock);
+    if (base == nullptr) return false;
+    int index = findEntry(record, ARCHIVED);
+    if (index < 0) return false;
+    entries()[index].flags |= ARCHIVED;
+    entries()[index].checksum = checksumOf(entries()[index]);
+    return true;
+}
+
+/**
+ * Forces the string table and the mapped entries onto the disk (called by
+ * the background writer instead of rewriting borrow_records.csv).
+ */
+bool BorrowLog::sync() {
+    lock_guard<mutex> lock(mapLock);
+    if (base == nullptr) return false;
+    bool ok = fflush(stringFile) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(stringFile)) == 0;
+    ok = ok && FlushViewOfFile(base, mappedBytes) != 0 && FlushFileBuffers(mapped->file) != 0;
+#else
+    ok = ok && fsync(fileno(stringFile)) == 0;
+    ok = ok && msync(base, mappedBytes, MS_SYNC) == 0;
+#endif
+    return ok;
+}
+
+/**
+ * Appends every record with this ID (IDs saved by older versions may repeat),
+ * archived ones included.
+ * Time Complexity: O(log n + k)
+ */
+void BorrowLog::findByRecordID(const string& recordID, vector<BorrowRecord>& out) const {
+    uint32_t number = recordNumber(recordID);
+    int count = getEntryCount();
+    const Entry* all = entries();
+    const Entry* first = lower_bound(all, all + count, number, [](const Entry& entry, uint32_t key) {
+        return entry.recordNumber < key;
+    });
+    for (const Entry* e = first; e != all + count && e->recordNumber == number; ++e) {
+        if (strings[e->recordID] == recordID) out.push_back(toRecord(*e));
+    }
+}
+
+/**
+ * Appends every record borrowed between two dates (inclusive), archived ones
+ * included, oldest borrow first.
+ * Time Complexity: O(log n + k)
+ */
+void BorrowLog::findBorrowedBetween(const Date& from, const Date& to, vector<BorrowRecord>& out) const {
+    const Entry* all = entries();
+    vector<int>::const_iterator it = lower_bound(byBorrowDate.begin(), byBorrowDate.end(), from.getDays(),
+        [all](int position, int day) { return all[position].borrowDay < day; });
+    for (; it != byBorrowDate.end() && all[*it].borrowDay <= to.getDays(); ++it) out.push_back(toRecord(all[*it]));
+}
+
+/**
+ * Appends the records that are not archived, in record-number order (what
+ * the in-memory borrow list is loaded from).
+ * Time Complexity: O(n)
+ */
+void BorrowLog::collectLive(vector<BorrowRecord>& out) const {
+    int count = getEntryCount();
+    const Entry* all = entries();
+    out.reserve(out.size() + count);
+    for (int i = 0; i < count; i++) {
+        if ((all[i].flags & ARCHIVED) == 0) out.push_back(toRecord(all[i]));
+    }
+}
+
+/**
+ * Writes the records that are not archived to a CSV file in the
+ * borrow_records.csv layout, newest first as the borrow list saves them.
+ */
+bool BorrowLog::exportCSV(const string& csvFile) const {
+    vector<BorrowRecord> live;
+    collectLive(live);
+    reverse(live.begin(), live.end());
+    return CSVHandler::writeFile(csvFile, CSVHandler::formatBorrowRecords(live));
+}
+
+int BorrowLog::getEntryCount() const {
+    return (base != nullptr) ? (int)header()->entryCount : 0;
+}
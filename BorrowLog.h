@@ -0,0 +1,118 @@
+#ifndef BORROWLOG_H
+#define BORROWLOG_H
+
+#include "BorrowRecord.h"
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+/**
+ * Binary borrow log: an alternative to borrow_records.csv as the store for
+ * borrow records.
+ * Every record is one fixed-width 32-byte entry in a memory-mapped file. Its
+ * record, user and game IDs are indexes into an append-only table of interned
+ * strings, and its dates are day numbers. Entries are kept in record-number
+ * order, so a record ID is found by binary search on the mapping, and an
+ * in-memory index of entry positions by borrow date answers date ranges by
+ * binary search too. A return or an archive move rewrites the entry's flags
+ * in place, and a new borrow appends one entry, so the file is never
+ * rewritten. CSV is produced only on demand (exportCSV). A new entry (and
+ * any string it needs) is flushed to disk before the header counts it, and
+ * every counted entry carries a checksum that open() verifies.
+ * Integers are stored in the machine's byte order.
+ */
+class BorrowLog {
+public:
+    static const int ENTRY_BYTES = 32;
+    static const int HEADER_BYTES = 64;
+    static const int INITIAL_CAPACITY = 1024;   // entries; the file doubles when full
+
+    BorrowLog(const string& logPath = "borrow_log.bin", const string& stringsPath = "borrow_log.str");
+    ~BorrowLog();
+
+    BorrowLog(const BorrowLog&) = delete;
+    BorrowLog& operator=(const BorrowLog&) = delete;
+
+    bool exists() const;
+    bool open();
+    bool create(const vector<BorrowRecord>& records);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+
+    // In-place updates (called by BorrowLinkedList once the log is attached)
+    bool append(const BorrowRecord& record);
+    bool markReturned(const BorrowRecord& record);
+    bool markArchived(const BorrowRecord& record);
+    bool sync();
+
+    // Binary searches over the mapped entries
+    void findByRecordID(const string& recordID, vector<BorrowRecord>& out) const;
+    void findBorrowedBetween(const Date& from, const Date& to, vector<BorrowRecord>& out) const;
+    void collectLive(vector<BorrowRecord>& out) const;
+    bool exportCSV(const string& csvFile) const;
+
+    int getEntryCount() const;
+    int getStringCount() const { return (int)strings.size(); }
+    size_t getFileBytes() const { return mappedBytes; }
+    const string& getFilename() const { return filename; }
+
+private:
+    enum Flags { RETURNED = 1, ARCHIVED = 2 };
+
+    struct Entry {
+        uint32_t recordNumber;  // numeric part of the record ID (the sort key)
+        uint32_t recordID;      // string table index of the full record ID
+        uint32_t userID;        // string table index
+        uint32_t gameID;        // string table index
+        int32_t borrowDay;      // Date::getDays()
+        int32_t returnDay;      // valid when RETURNED is set
+        uint32_t flags;
+        uint32_t checksum;      // over the fields above; a zeroed or torn entry fails it
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t entryBytes;
+        uint64_t entryCount;
+        uint64_t capacity;
+        char reserved[32];
+    };
+
+    struct MappedFile;      // platform file and mapping handles (see BorrowLog.cpp)
+
+    string filename;
+    string stringFilename;
+    MappedFile* mapped;
+    char* base;             // start of the mapping, nullptr while closed
+    size_t mappedBytes;
+    FILE* stringFile;       // open for appending new strings
+
+    vector<string> strings;
+    unordered_map<string, uint32_t> stringIndex;
+    vector<int> byBorrowDate;   // entry positions ordered by borrow day
+
+    mutable mutex mapLock;  // the writer thread syncs while the menu thread appends
+
+    Header* header() const { return (Header*)base; }
+    Entry* entries() const { return (Entry*)(base + HEADER_BYTES); }
+
+    bool mapFile(size_t bytes);
+    void unmapFile();
+    bool grow();
+    bool loadStrings();
+    bool syncStrings();
+    bool flushEntries(int first, int count);
+    static uint32_t checksumOf(const Entry& entry);
+    uint32_t intern(const string& text);
+    void fillEntry(Entry& entry, const BorrowRecord& record);
+    BorrowRecord toRecord(const Entry& entry) const;
+    int findEntry(const BorrowRecord& record, uint32_t skipFlag) const;
+    void rebuildDateIndex();
+};
+
+#endif
@@ -7,23 +7,24 @@
  * including user ID, game ID, borrow date, and return date for audit trails.
  * - Status Tracking: Distinguishes between active borrows (empty return date)
  * and completed transactions with simple isReturned() check.
+ * - Packed Dates: Borrow and return dates are stored as Date day numbers, so
+ * comparisons need no string parsing.
  * - Flexible Display: Supports printing with optional game names for cleaner
- * human-readable output in reports.
+ * human-readable output in reports, into a shared buffered renderer when
+ * many records are listed.
  *****************************************************************************/
 
 #include "BorrowRecord.h"
-#include <iostream>
+#include "ConsoleRenderer.h"
 using namespace std;
 
 BorrowRecord::BorrowRecord() {
     recordID = "";
     userID = "";
     gameID = "";
-    borrowDate = "";
-    returnDate = "";
 }
 
-BorrowRecord::BorrowRecord(string rid, string uid, string gid, string bDate, string rDate) {
+BorrowRecord::BorrowRecord(string rid, string uid, string gid, Date bDate, Date rDate) {
     recordID = rid;
     userID = uid;
     gameID = gid;
@@ -31,20 +32,29 @@ BorrowRecord::BorrowRecord(string rid, string uid, string gid, string bDate, str
     returnDate = rDate;
 }
 
-string BorrowRecord::getRecordID() const { return recordID; }
-string BorrowRecord::getUserID() const { return userID; }
-string BorrowRecord::getGameID() const { return gameID; }
-string BorrowRecord::getBorrowDate() const { return borrowDate; }
-string BorrowRecord::getReturnDate() const { return returnDate; }
+const string& BorrowRecord::getRecordID() const { return recordID; }
+const string& BorrowRecord::getUserID() const { return userID; }
+const string& BorrowRecord::getGameID() const { return gameID; }
+Date BorrowRecord::getBorrowDate() const { return borrowDate; }
+Date BorrowRecord::getReturnDate() const { return returnDate; }
 
-bool BorrowRecord::isReturned() const { return returnDate != ""; }
+bool BorrowRecord::isReturned() const { return !returnDate.isEmpty(); }
 
-void BorrowRecord::setReturnDate(string rDate) { returnDate = rDate; }
+void BorrowRecord::setReturnDate(const Date& rDate) { returnDate = rDate; }
 
 void BorrowRecord::print(const string& gameName) const {
-    cout << "Record ID: " << recordID << "\n";
-    cout << "Game: " << gameName << "\n";
-    cout << "Game ID: " << gameID << "\n";
-    cout << "Borrow Date: " << borrowDate << "\n";
-    cout << "Return Date: " << (returnDate == "" ? "(not returned)" : returnDate) << "\n";
+    ConsoleRenderer out;
+    render(out, gameName);
+}
+
+/** Formats the record into a renderer (used by listings of many records). */
+void BorrowRecord::render(ConsoleRenderer& out, const string& gameName) const {
+    out.text("Record ID: ").text(recordID).newline();
+    out.text("Game: ").text(gameName).newline();
+    out.text("Game ID: ").text(gameID).newline();
+    out.text("Borrow Date: ").date(borrowDate).newline();
+    out.text("Return Date: ");
+    if (returnDate.isEmpty()) out.text("(not returned)");
+    else out.date(returnDate);
+    out.newline();
 }
@@ -1,31 +1,35 @@
 #ifndef BORROWRECORD_H
 #define BORROWRECORD_H
 
+#include "Date.h"
 #include <string>
 using namespace std;
 
+class ConsoleRenderer;
+
 class BorrowRecord {
 private:
     string recordID;
     string userID;
     string gameID;
-    string borrowDate;
-    string returnDate; // empty = not returned
+    Date borrowDate;
+    Date returnDate;   // empty = not returned
 
 public:
     BorrowRecord();
-    BorrowRecord(string rid, string uid, string gid, string bDate, string rDate);
+    BorrowRecord(string rid, string uid, string gid, Date bDate, Date rDate);
 
-    string getRecordID() const;
-    string getUserID() const;
-    string getGameID() const;
-    string getBorrowDate() const;
-    string getReturnDate() const;
+    const string& getRecordID() const;
+    const string& getUserID() const;
+    const string& getGameID() const;
+    Date getBorrowDate() const;
+    Date getReturnDate() const;
 
     bool isReturned() const;
-    void setReturnDate(string rDate);
+    void setReturnDate(const Date& rDate);
 
     void print(const string& gameName = "Unknown") const;
+    void render(ConsoleRenderer& out, const string& gameName = "Unknown") const;
 };
 
 #endif
@@ -9,10 +9,13 @@
  * to display live inventory instead of stale cached data.
  * - CSV Persistence: Browse history persists per-user across sessions, allowing
  * users to see their viewing history on re-login without data loss.
+ * - View Counting: Once a view counter is attached, every new view is also
+ * added to a shared Count-Min sketch of views per game.
  *****************************************************************************/
 
 #include "BrowseHistory.h"
 #include "GameDynamicArray.h"
+#include "StreamSketches.h"
 #include <iostream>
 using namespace std;
 
@@ -20,6 +23,7 @@ BrowseHistory::BrowseHistory() {
     front = nullptr;
     rear = nullptr;
     count = 0;
+    viewCounter = nullptr;
 }
 
 BrowseHistory::~BrowseHistory() {
@@ -40,7 +44,9 @@ void BrowseHistory::dequeue() {
     }
 }
 
-void BrowseHistory::enqueue(const Game& game, const string& viewedDate) {
+void BrowseHistory::enqueue(const Game& game, const Date& viewedDate) {
+    if (viewCounter != nullptr) viewCounter->add(game.getGameID());
+
     Node* newNode = new Node;
     newNode->game = game;
     newNode->viewedDate = viewedDate;
@@ -63,6 +69,11 @@ void BrowseHistory::enqueue(const Game& game, const string& viewedDate) {
     }
 }
 
+// Attached after a saved history is loaded, so reloading it is not counted again
+void BrowseHistory::attachViewCounter(CountMinSketch* counter) {
+    viewCounter = counter;
+}
+
 bool BrowseHistory::isEmpty() const {
     return front == nullptr;
 }
@@ -136,9 +147,9 @@ Game* BrowseHistory::getGameAt(int index) const {
     return nullptr;
 }
 
-string BrowseHistory::getViewedDateAt(int index) const {
+Date BrowseHistory::getViewedDateAt(int index) const {
     if (index < 0 || index >= count) {
-        return "";
+        return Date();
     }
     
     Node* current = front;
@@ -151,7 +162,7 @@ string BrowseHistory::getViewedDateAt(int index) const {
         current = current->next;
         currentIndex++;
     }
-    return "";
+    return Date();
 }
 
 string BrowseHistory::getGameIDAt(int index) const {
@@ -2,22 +2,25 @@
 #define BROWSEHISTORY_H
 
 #include "Game.h"
+#include "Date.h"
 #include <string>
 using namespace std;
 
 class GameDynamicArray;  // Forward declaration
+class CountMinSketch;
 
 class BrowseHistory {
 private:
     struct Node {
         Game game;
-        string viewedDate;
+        Date viewedDate;
         Node* next;
     };
     
     Node* front;  // Front of queue (oldest item)
     Node* rear;   // Rear of queue (newest item)
     int count;    // Current number of items in queue
+    CountMinSketch* viewCounter;  // counts every enqueued view (optional)
     static const int MAX_HISTORY_SIZE = 5;  // Maximum items to keep
     
     void dequeue();  // Remove oldest item when limit exceeded
@@ -26,13 +29,14 @@ public:
     BrowseHistory();
     ~BrowseHistory();
     
-    void enqueue(const Game& game, const string& viewedDate);  // Add new game to queue
+    void enqueue(const Game& game, const Date& viewedDate);  // Add new game to queue
+    void attachViewCounter(CountMinSketch* counter);        // views from then on are counted
     bool isEmpty() const;
     int getSize() const;
     void displayHistory(GameDynamicArray* games = nullptr) const;
     Game* getGameAt(int index) const;
     string getGameIDAt(int index) const;
-    string getViewedDateAt(int index) const;
+    Date getViewedDateAt(int index) const;
     
     // For CSV persistence
     void clearHistory();
@@ -7,6 +7,15 @@
  * quoted strings, escaped characters, and varied delimiters.
  * - Data Persistence: Full serialization and deserialization for Games,
  * Users, Borrow Records, and Reviews.
+ * - Parallel Parsing: Whole files are parsed in line-aligned chunks on the
+ * shared work-stealing pool, keeping file order.
+ * - Crash-Safe Saves: Every file is written to a temporary copy, synced to
+ * disk and renamed over the original, so a crash leaves either the old or
+ * the new file, never a half-written one.
+ * - Journal Recovery: Re-applies group-commit journal entries that were made
+ * durable but not yet folded into the CSV snapshots.
+ * - Sketch Persistence: View counts and distinct-borrower counters are saved
+ * as one small binary file, so they keep counting across runs.
  * - Selective History Management: Capability to update individual user
  * browsing history while preserving global data.
  * - Manual Type Conversion: Implementation of custom string-to-int logic
@@ -14,10 +23,22 @@
  *****************************************************************************/
 
 #include "CSVHandler.h"
+#include "CatalogSnapshot.h"
+#include "BorrowArchive.h"
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <vector>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -100,9 +121,94 @@ static string parseCSVField(stringstream& ss) {
     return field;
 }
 
+/**
+ * Quotes a field for a CSV file, doubling any quotes inside it so commas and
+ * quotes in titles survive a save and reload.
+ */
+static string quoteField(const string& text) {
+    string quoted = "\"";
+    for (char c : text) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+/**
+ * Parses one games.csv line (name,minplayers,maxplayers,maxplaytime,minplaytime,yearpublished[,gameID]).
+ * @param line Raw line without the trailing newline.
+ * @param row Receives the parsed fields.
+ * @return False for blank lines that should be skipped.
+ */
+bool CSVHandler::parseGameLine(const string& line, GameRow& row) {
+    if (line.length() == 0) return false;
+
+    row.title = "";
+    row.minPlayers = row.maxPlayers = row.year = 0;
+    row.minPlayTime = row.maxPlayTime = 0;
+    row.gameID = "";
+
+    size_t start = 0;
+    size_t end;
+    if (line[0] == '"') {
+        // Quoted title: "" is a literal quote. A lone quote that does not end
+        // the field is kept as is (files saved before quotes were escaped).
+        size_t i = 1;
+        while (i < line.length()) {
+            if (line[i] == '"') {
+                if (i + 1 < line.length() && line[i + 1] == '"') {
+                    row.title += '"';
+                    i += 2;
+                    continue;
+                }
+                if (i + 1 == line.length() || line[i + 1] == ',') break;
+            }
+            row.title += line[i++];
+        }
+        end = (i + 1 < line.length()) ? i + 1 : string::npos;
+    }
+    else {
+        end = line.find(',');
+        row.title = line.substr(start, end - start);
+    }
+    if (end == string::npos) return true;
+
+    start = end + 1;
+    end = line.find(',', start);
+    string minPStr = line.substr(start, end - start);
+
+    start = end + 1;
+    end = line.find(',', start);
+    string maxPStr = line.substr(start, end - start);
+
+    start = end + 1;
+    end = line.find(',', start);
+    string maxTimeStr = line.substr(start, end - start);
+
+    start = end + 1;
+    end = line.find(',', start);
+    string minTimeStr = line.substr(start, end - start);
+
+    start = end + 1;
+    end = line.find(',', start);
+    string yearStr = line.substr(start, end - start);
+
+    // Files written by this version end with the game's ID
+    if (end != string::npos) row.gameID = trim(line.substr(end + 1));
+
+    for (char c : minPStr) if (c >= '0' && c <= '9') row.minPlayers = row.minPlayers * 10 + (c - '0');
+    for (char c : maxPStr) if (c >= '0' && c <= '9') row.maxPlayers = row.maxPlayers * 10 + (c - '0');
+    for (char c : yearStr) if (c >= '0' && c <= '9') row.year = row.year * 10 + (c - '0');
+    for (char c : maxTimeStr) if (c >= '0' && c <= '9') row.maxPlayTime = row.maxPlayTime * 10 + (c - '0');
+    for (char c : minTimeStr) if (c >= '0' && c <= '9') row.minPlayTime = row.minPlayTime * 10 + (c - '0');
+    return true;
+}
+
 /**
  * Loads game data from a CSV file into the Dynamic Array.
- * Generates unique IDs (G001, etc.) during the import process.
+ * Uses the stored gameID column, or generates IDs (G001, etc.) for files
+ * saved before the column existed.
  * @param filename Path to the games CSV.
  * @param games Reference to the storage array.
  * @return True if successful, false otherwise.
@@ -117,53 +223,19 @@ bool CSVHandler::loadGames(const string& filename, GameDynamicArray& games) {
     string line;
     getline(file, line); // Skip header
 
-    int idCounter = 1;
+    GameRow row;
 
     while (getline(file, line)) {
-        if (line.length() == 0) continue;
-
-        string id = "G";
-        if (idCounter < 100) id += "0";
-        if (idCounter < 10) id += "0";
-        id += intToStr(idCounter);
-        idCounter++;
-
-        string title = "";
-        int minP = 0, maxP = 0, year = 0;
-
-        size_t start = 0;
-        size_t end = line.find(',');
-
-        title = line.substr(start, end - start);
-        if (title.length() > 0 && title[0] == '"') {
-            title = title.substr(1, title.length() - 2);
-        }
-
-        start = end + 1;
-        end = line.find(',', start);
-        string minPStr = line.substr(start, end - start);
-
-        start = end + 1;
-        end = line.find(',', start);
-        string maxPStr = line.substr(start, end - start);
-
-        start = end + 1;
-        end = line.find(',', start); // skip maxplaytime
-        start = end + 1;
-        end = line.find(',', start); // skip minplaytime
+        if (!parseGameLine(line, row)) continue;
 
-        start = end + 1;
-        string yearStr = line.substr(start);
-
-        for (char c : minPStr) if (c >= '0' && c <= '9') minP = minP * 10 + (c - '0');
-        for (char c : maxPStr) if (c >= '0' && c <= '9') maxP = maxP * 10 + (c - '0');
-        for (char c : yearStr) if (c >= '0' && c <= '9') year = year * 10 + (c - '0');
-
-        Game g(id, title, minP, maxP, year, 1, 1);
+        string id = (row.gameID != "") ? row.gameID : games.nextGameID();
+        Game g(id, row.title, row.minPlayers, row.maxPlayers, row.year, 1, 1);
+        g.setPlayTime(row.minPlayTime, row.maxPlayTime);
         games.add(g);
     }
 
     file.close();
+    games.buildTitlePrefixes();
     return true;
 }
 
@@ -174,25 +246,80 @@ bool CSVHandler::loadGames(const string& filename, GameDynamicArray& games) {
  * @return True if file was written successfully.
  */
 bool CSVHandler::saveGames(const string& filename, GameDynamicArray& games) {
-    ofstream file(filename);
-    if (!file.is_open()) {
+    if (!writeFile(filename, formatGames(games))) {
         cout << "[ERROR] Unable to write to " << filename << "\n";
         return false;
     }
+    return true;
+}
 
-    file << "name,minplayers,maxplayers,maxplaytime,minplaytime,yearpublished\n";
+/**
+ * Renders the game inventory in games.csv layout without touching the disk.
+ * @param games Reference to the inventory array.
+ * @return Full file contents, header included.
+ */
+string CSVHandler::formatGames(GameDynamicArray& games) {
+    stringstream file;
+    file << "name,minplayers,maxplayers,maxplaytime,minplaytime,yearpublished,gameID\n";
 
     for (int i = 0; i < games.size(); i++) {
-        Game g = games.get(i);
-        file << "\"" << g.getTitle() << "\","
+        const Game& g = games.get(i);
+        file << quoteField(g.getTitle()) << ","
             << g.getMinPlayers() << ","
             << g.getMaxPlayers() << ","
-            << "0" << ","
-            << "0" << ","
-            << g.getYear() << "\n";
+            << g.getMaxPlayTime() << ","
+            << g.getMinPlayTime() << ","
+            << g.getYear() << ","
+            << g.getGameID() << "\n";
     }
+    return file.str();
+}
 
-    file.close();
+/**
+ * Renders a published catalog version in games.csv layout. Safe on any
+ * thread while a CatalogVersions::Reader holds the snapshot.
+ * @param snapshot Read-only catalog version.
+ * @return Full file contents, header included.
+ */
+string CSVHandler::formatGames(const CatalogSnapshot& snapshot) {
+    stringstream file;
+    file << "name,minplayers,maxplayers,maxplaytime,minplaytime,yearpublished,gameID\n";
+
+    for (int i = 0; i < snapshot.size(); i++) {
+        const GameView& g = snapshot.get(i);
+        file << quoteField(g.title) << ","
+            << g.minPlayers << ","
+            << g.maxPlayers << ","
+            << g.maxPlayTime << ","
+            << g.minPlayTime << ","
+            << g.year << ","
+            << g.gameID << "\n";
+    }
+    return file.str();
+}
+
+/**
+ * Parses one users.csv line (userID,name,role).
+ * @param line Raw line without the trailing newline.
+ * @param user Receives the parsed account.
+ * @return False for blank lines that should be skipped.
+ */
+bool CSVHandler::parseUserLine(const string& line, User& user) {
+    if (trim(line) == "") return false;
+    stringstream ss(line);
+    string userID, name, roleStr;
+
+    getline(ss, userID, ',');
+    getline(ss, name, ',');
+    getline(ss, roleStr, ',');
+
+    userID = trim(userID);
+    name = trim(name);
+    roleStr = trim(roleStr);
+
+    Role role = (roleStr == "ADMIN") ? ADMIN : MEMBER;
+
+    user = User(userID, name, role);
     return true;
 }
 
@@ -215,22 +342,9 @@ bool CSVHandler::loadUsers(const string& filename, UserDynamicArray& users) {
         return false;
     }
 
+    User u;
     while (getline(file, line)) {
-        if (trim(line) == "") continue;
-        stringstream ss(line);
-        string userID, name, roleStr;
-
-        getline(ss, userID, ',');
-        getline(ss, name, ',');
-        getline(ss, roleStr, ',');
-
-        userID = trim(userID);
-        name = trim(name);
-        roleStr = trim(roleStr);
-
-        Role role = (roleStr == "ADMIN") ? ADMIN : MEMBER;
-
-        User u(userID, name, role);
+        if (!parseUserLine(line, u)) continue;
         users.add(u);
     }
 
@@ -245,22 +359,50 @@ bool CSVHandler::loadUsers(const string& filename, UserDynamicArray& users) {
  * @return True if write successful.
  */
 bool CSVHandler::saveUsers(const string& filename, UserDynamicArray& users) {
-    ofstream file(filename);
-    if (!file.is_open()) {
+    if (!writeFile(filename, formatUsers(users))) {
         cout << "[ERROR] Unable to write to " << filename << "\n";
         return false;
     }
+    return true;
+}
 
+/**
+ * Renders all user accounts in users.csv layout without touching the disk.
+ * @param users Reference to the user directory array.
+ * @return Full file contents, header included.
+ */
+string CSVHandler::formatUsers(UserDynamicArray& users) {
+    stringstream file;
     file << "userID,name,role\n";
 
     for (int i = 0; i < users.size(); i++) {
-        User u = users.get(i);
+        const User& u = users.get(i);
         file << u.getUserID() << ","
             << u.getName() << ","
             << (u.getRole() == ADMIN ? "ADMIN" : "MEMBER") << "\n";
     }
+    return file.str();
+}
 
-    file.close();
+/**
+ * Parses one borrow_records.csv line (recordID,userID,gameID,borrowDate,returnDate).
+ * @param line Raw line without the trailing newline.
+ * @param record Receives the parsed record.
+ * @return False for blank lines that should be skipped.
+ */
+bool CSVHandler::parseBorrowLine(const string& line, BorrowRecord& record) {
+    if (trim(line) == "") return false;
+    stringstream ss(line);
+    string recordID, userID, gameID, borrowDate, returnDate;
+
+    getline(ss, recordID, ',');
+    getline(ss, userID, ',');
+    getline(ss, gameID, ',');
+    getline(ss, borrowDate, ',');
+    getline(ss, returnDate, ',');
+
+    record = BorrowRecord(trim(recordID), trim(userID), trim(gameID),
+        Date::parse(borrowDate), Date::parse(returnDate));
     return true;
 }
 
@@ -283,18 +425,9 @@ bool CSVHandler::loadBorrowRecords(const string& filename, BorrowLinkedList& rec
         return false;
     }
 
+    BorrowRecord br;
     while (getline(file, line)) {
-        if (trim(line) == "") continue;
-        stringstream ss(line);
-        string recordID, userID, gameID, borrowDate, returnDate;
-
-        getline(ss, recordID, ',');
-        getline(ss, userID, ',');
-        getline(ss, gameID, ',');
-        getline(ss, borrowDate, ',');
-        getline(ss, returnDate, ',');
-
-        BorrowRecord br(trim(recordID), trim(userID), trim(gameID), trim(borrowDate), trim(returnDate));
+        if (!parseBorrowLine(line, br)) continue;
         records.insertFront(br);
     }
 
@@ -309,16 +442,77 @@ bool CSVHandler::loadBorrowRecords(const string& filename, BorrowLinkedList& rec
  * @return True if successful.
  */
 bool CSVHandler::saveBorrowRecords(const string& filename, BorrowLinkedList& records) {
-    ofstream file(filename);
-    if (!file.is_open()) {
+    if (!writeFile(filename, formatBorrowRecords(records))) {
         cout << "[ERROR] Unable to write to " << filename << "\n";
         return false;
     }
+    return true;
+}
 
+/**
+ * Renders the borrow record list in borrow_records.csv layout.
+ * @param records Reference to the Linked List.
+ * @return Full file contents, header included.
+ */
+string CSVHandler::formatBorrowRecords(BorrowLinkedList& records) {
+    stringstream file;
     file << "recordID,userID,gameID,borrowDate,returnDate\n";
     records.writeToCSV(file);
+    return file.str();
+}
 
-    file.close();
+/**
+ * Renders records in borrow_records.csv layout, in the given order.
+ * @param records Records to write (e.g. exported from the binary borrow log).
+ * @return Full file contents, header included.
+ */
+string CSVHandler::formatBorrowRecords(const vector<BorrowRecord>& records) {
+    stringstream file;
+    file << "recordID,userID,gameID,borrowDate,returnDate\n";
+    for (int i = 0; i < (int)records.size(); i++) {
+        const BorrowRecord& br = records[i];
+        file << br.getRecordID() << ","
+            << br.getUserID() << ","
+            << br.getGameID() << ","
+            << br.getBorrowDate().toString() << ","
+            << br.getReturnDate().toString() << "\n";
+    }
+    return file.str();
+}
+
+/**
+ * Parses one reviews.csv line (gameID,memberName,rating,comment).
+ * @param line Raw line without the trailing newline.
+ * @param row Receives the parsed review.
+ * @return False for blank lines that should be skipped.
+ */
+bool CSVHandler::parseReviewLine(const string& line, ReviewRow& row) {
+    if (trim(line) == "") return false;
+    stringstream ss(line);
+    string rateStr;
+
+    getline(ss, row.gameID, ',');
+    getline(ss, row.memberName, ',');
+    getline(ss, rateStr, ',');
+    getline(ss, row.comment);
+
+    row.gameID = trim(row.gameID);
+    row.memberName = trim(row.memberName);
+    row.comment = trim(row.comment);
+
+    // saveReviews() wraps comments in quotes; unwrap so they don't pile up on every save
+    if (row.comment.length() >= 2 && row.comment[0] == '"' && row.comment[row.comment.length() - 1] == '"') {
+        string inner = row.comment.substr(1, row.comment.length() - 2);
+        row.comment = "";
+        for (int i = 0; i < (int)inner.length(); i++) {
+            row.comment += inner[i];
+            if (inner[i] == '"' && i + 1 < (int)inner.length() && inner[i + 1] == '"') i++;
+        }
+    }
+
+    row.rating = 0;
+    string tRate = trim(rateStr);
+    for (char c : tRate) if (c >= '0' && c <= '9') row.rating = row.rating * 10 + (c - '0');
     return true;
 }
 
@@ -335,29 +529,15 @@ bool CSVHandler::loadReviews(const string& filename, GameDynamicArray& games) {
     string line;
     if (!getline(file, line)) return false;
 
+    ReviewRow row;
     while (getline(file, line)) {
-        if (trim(line) == "") continue;
-        stringstream ss(line);
-        string gID, name, rateStr, comm;
-
-        getline(ss, gID, ',');
-        getline(ss, name, ',');
-        getline(ss, rateStr, ',');
-        getline(ss, comm);
-
-        gID = trim(gID);
-        name = trim(name);
-        comm = trim(comm);
-
-        int rate = 0;
-        string tRate = trim(rateStr);
-        for (char c : tRate) if (c >= '0' && c <= '9') rate = rate * 10 + (c - '0');
+        if (!parseReviewLine(line, row)) continue;
 
         for (int i = 0; i < games.size(); i++) {
-            if (games.get(i).getGameID() == gID) {
+            if (games.get(i).getGameID() == row.gameID) {
                 Game* targetGame = games.getPtr(i);
                 if (targetGame != nullptr) {
-                    targetGame->addReview(name, comm, rate);
+                    targetGame->addReview(row.memberName, row.comment, row.rating);
                 }
                 break;
             }
@@ -374,21 +554,170 @@ bool CSVHandler::loadReviews(const string& filename, GameDynamicArray& games) {
  * @return True if successful.
  */
 bool CSVHandler::saveReviews(const string& filename, GameDynamicArray& games) {
-    ofstream file(filename);
-    if (!file.is_open()) {
+    if (!writeFile(filename, formatReviews(games))) {
         cout << "[ERROR] Unable to write reviews to " << filename << "\n";
         return false;
     }
+    return true;
+}
 
+/**
+ * Renders every game's review BST (pre-order) in reviews.csv layout.
+ * @param games Reference to games inventory.
+ * @return Full file contents, header included.
+ */
+string CSVHandler::formatReviews(GameDynamicArray& games) {
+    stringstream file;
     file << "gameID,memberName,rating,comment\n";
     for (int i = 0; i < games.size(); i++) {
         games.get(i).saveReviews(file);
     }
+    return file.str();
+}
 
-    file.close();
+/**
+ * Parses one play_sessions.csv line (sessionID,gameID,date,players,winnerID).
+ * Players are pipe-separated user IDs; the winner may be empty.
+ * @param line Raw line without the trailing newline.
+ * @param session Receives the parsed session.
+ * @return False for blank or incomplete lines that should be skipped.
+ */
+bool CSVHandler::parsePlaySessionLine(const string& line, PlaySession& session) {
+    if (trim(line) == "") return false;
+    stringstream ss(line);
+    string date, players;
+
+    getline(ss, session.sessionID, ',');
+    getline(ss, session.gameID, ',');
+    getline(ss, date, ',');
+    getline(ss, players, ',');
+    getline(ss, session.winnerID, ',');
+
+    session.sessionID = trim(session.sessionID);
+    session.gameID = trim(session.gameID);
+    session.date = Date::parse(date);
+    session.winnerID = trim(session.winnerID);
+
+    session.players.clear();
+    stringstream names(players);
+    string player;
+    while (getline(names, player, '|')) {
+        player = trim(player);
+        if (player != "") session.players.push_back(player);
+    }
+    return session.sessionID != "" && session.gameID != "" && !session.players.empty();
+}
+
+/**
+ * Loads play sessions and feeds each one into the statistics store.
+ * The file is parsed in parallel chunks; sessions are recorded in file order.
+ * Rows the store refuses are kept (see PlayStats::keepRejected) and counted
+ * in a warning, so saving never silently deletes them.
+ * @param filename Path to the play sessions CSV.
+ * @param stats Store that receives the sessions (and updates its aggregates).
+ * @param pool Workers for parsing (nullptr parses on the calling thread).
+ * @return True if the file was read.
+ */
+bool CSVHandler::loadPlaySessions(const string& filename, PlayStats& stats, ThreadPool* pool) {
+    string contents;
+    if (!readFile(filename, contents) || contents.empty()) return false;
+
+    vector<PlaySession> sessions;
+    parseChunked(pool, contents, &CSVHandler::parsePlaySessionRows, sessions);
+    int rejected = 0;
+    for (int i = 0; i < (int)sessions.size(); i++) {
+        if (stats.record(sessions[i])) continue;
+        // Invalid or duplicated: kept for the next save, left out of the statistics
+        stats.keepRejected(sessions[i]);
+        rejected++;
+    }
+    if (rejected > 0) {
+        cout << "[WARNING] " << rejected << " play session row(s) in " << filename
+             << " are invalid or duplicated; they are kept in the file but not counted.\n";
+    }
     return true;
 }
 
+/**
+ * Saves every recorded play session back to the CSV.
+ * @param filename Path to the play sessions CSV.
+ * @param stats Store holding the sessions.
+ * @return True if successful.
+ */
+bool CSVHandler::savePlaySessions(const string& filename, PlayStats& stats) {
+    if (!writeFile(filename, formatPlaySessions(stats))) {
+        cout << "[ERROR] Unable to write to " << filename << "\n";
+        return false;
+    }
+    return true;
+}
+
+static const char SKETCH_MAGIC[4] = { 'S', 'K', 'T', '1' };
+
+/**
+ * Restores the sketches saved by saveSketches. The view counts replace the
+ * current ones; the borrower counters are merged into the board's.
+ * @param filename Path to the sketch file.
+ * @param views Receives the view counts.
+ * @param board Leaderboards whose distinct-borrower counters are merged.
+ * @return False if the file is missing, damaged or from another format (the
+ * view counts are then left as they were).
+ */
+bool CSVHandler::loadSketches(const string& filename, CountMinSketch& views, PopularityBoard& board) {
+    string contents;
+    if (!readFile(filename, contents)) return false;
+    if (contents.size() < 4 || contents.compare(0, 4, string(SKETCH_MAGIC, 4)) != 0) return false;
+
+    size_t pos = 4;
+    CountMinSketch loaded;
+    if (!loaded.readFrom(contents, pos)) return false;
+    if (!board.readBorrowerSketches(contents, pos) || pos != contents.size()) return false;
+    views = loaded;
+    return true;
+}
+
+/**
+ * Saves the view counts and distinct-borrower counters (written atomically).
+ * @param filename Path to the sketch file.
+ * @return True if successful.
+ */
+bool CSVHandler::saveSketches(const string& filename, const CountMinSketch& views, const PopularityBoard& board) {
+    string contents(SKETCH_MAGIC, 4);
+    views.writeTo(contents);
+    board.writeBorrowerSketches(contents);
+    if (!writeFile(filename, contents)) {
+        cout << "[ERROR] Unable to write to " << filename << "\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Renders the recorded sessions, then any rejected file rows, in
+ * play_sessions.csv layout.
+ * @param stats Store holding the sessions.
+ * @return Full file contents, header included.
+ */
+string CSVHandler::formatPlaySessions(PlayStats& stats) {
+    stringstream file;
+    file << "sessionID,gameID,date,players,winnerID\n";
+    // Rejected rows go last so the valid copy of a duplicated ID loads first
+    const vector<PlaySession>* groups[2] = { &stats.getSessions(), &stats.getRejected() };
+    for (int g = 0; g < 2; g++) {
+        const vector<PlaySession>& sessions = *groups[g];
+        for (size_t i = 0; i < sessions.size(); i++) {
+            const PlaySession& s = sessions[i];
+            file << s.sessionID << "," << s.gameID << "," << s.date.toString() << ",";
+            for (size_t p = 0; p < s.players.size(); p++) {
+                if (p > 0) file << "|";
+                file << s.players[p];
+            }
+            file << "," << s.winnerID << "\n";
+        }
+    }
+    return file.str();
+}
+
 /**
  * Loads the browsing history queue for a specific user ID.
  * @param filename Path to history CSV.
@@ -420,7 +749,7 @@ bool CSVHandler::loadBrowseHistory(const string& filename, const string& userID,
         if (trim(loadedUserID) == userID) {
             Game* game = games.findByGameID(trim(gameID));
             if (game != nullptr) {
-                history.enqueue(*game, trim(viewedDate));
+                history.enqueue(*game, Date::parse(viewedDate));
             }
         }
     }
@@ -438,6 +767,37 @@ bool CSVHandler::loadBrowseHistory(const string& filename, const string& userID,
  */
 bool CSVHandler::saveBrowseHistory(const string& filename, const string& userID,
     BrowseHistory& history) {
+    return mergeBrowseHistory(filename, userID, formatBrowseHistory(userID, history));
+}
+
+/**
+ * Renders one user's browse history as browse_history.csv rows (no header).
+ * @param userID The ID of the current user.
+ * @param history The history queue to render.
+ * @return The rows, oldest view first.
+ */
+string CSVHandler::formatBrowseHistory(const string& userID, BrowseHistory& history) {
+    stringstream rows;
+    int historySize = history.getSize();
+    for (int i = 0; i < historySize; i++) {
+        Game* game = history.getGameAt(i);
+        if (game != nullptr) {
+            rows << userID << "," << game->getGameID() << ","
+                << history.getViewedDateAt(i) << "\n";
+        }
+    }
+    return rows.str();
+}
+
+/**
+ * Replaces one user's rows in the history file, keeping everyone else's.
+ * @param filename Path to history CSV.
+ * @param userID The user whose rows are replaced.
+ * @param rows Pre-rendered rows from formatBrowseHistory().
+ * @return True if file updated.
+ */
+bool CSVHandler::mergeBrowseHistory(const string& filename, const string& userID,
+    const string& rows) {
     ifstream inFile(filename);
     vector<string> allLines;
 
@@ -459,9 +819,7 @@ bool CSVHandler::saveBrowseHistory(const string& filename, const string& userID,
         inFile.close();
     }
 
-    ofstream outFile(filename);
-    if (!outFile.is_open()) return false;
-
+    stringstream outFile;
     if (allLines.empty()) {
         outFile << "userID,gameID,viewedDate\n";
     }
@@ -472,16 +830,300 @@ bool CSVHandler::saveBrowseHistory(const string& filename, const string& userID,
     for (int i = 1; i < (int)allLines.size(); i++) {
         outFile << allLines[i] << "\n";
     }
+    outFile << rows;
 
-    int historySize = history.getSize();
-    for (int i = 0; i < historySize; i++) {
-        Game* game = history.getGameAt(i);
-        if (game != nullptr) {
-            outFile << userID << "," << game->getGameID() << ","
-                << history.getViewedDateAt(i) << "\n";
+    return writeFile(filename, outFile.str());
+}
+
+/**
+ * Opens a C stream (fopen_s on MSVC, where fopen is flagged as unsafe).
+ * @return The stream, or nullptr on failure.
+ */
+static FILE* openStream(const string& name, const char* mode) {
+    FILE* stream = nullptr;
+#ifdef _WIN32
+    if (fopen_s(&stream, name.c_str(), mode) != 0) return nullptr;
+#else
+    stream = fopen(name.c_str(), mode);
+#endif
+    return stream;
+}
+
+/**
+ * Renames a fully written file over the target and makes the rename itself
+ * durable (write-through move on Windows, a sync of the directory elsewhere).
+ * @return True if the target now holds the new file.
+ */
+static bool replaceFile(const string& from, const string& to) {
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (rename(from.c_str(), to.c_str()) != 0) return false;
+    size_t slash = to.find_last_of('/');
+    string directory = (slash == string::npos) ? "." : (slash == 0 ? "/" : to.substr(0, slash));
+    int fd = open(directory.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool synced = fsync(fd) == 0;
+    close(fd);
+    return synced;
+#endif
+}
+
+/**
+ * Writes a pre-rendered snapshot to disk, replacing the file atomically:
+ * the bytes go to filename.tmp, are synced to disk, and the temporary file
+ * is renamed over the original. Callers may checkpoint the journal once
+ * this returns true.
+ * @param filename Destination path.
+ * @param contents Bytes to write.
+ * @return False if the file could not be written, synced or renamed (the
+ * original is then left untouched).
+ */
+bool CSVHandler::writeFile(const string& filename, const string& contents) {
+    string temporary = filename + ".tmp";
+    FILE* file = openStream(temporary, "wb");
+    if (file == nullptr) return false;
+
+    bool ok = fwrite(contents.data(), 1, contents.size(), file) == contents.size() && fflush(file) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    ok = (fclose(file) == 0) && ok;
+    if (!ok || !replaceFile(temporary, filename)) {
+        remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+// --- JOURNAL RECOVERY ---
+
+/**
+ * Journal payload for a new borrow: B,recordID,userID,gameID,borrowDate
+ * @param record The record that was just inserted.
+ */
+string CSVHandler::formatBorrowEntry(const BorrowRecord& record) {
+    return "B," + record.getRecordID() + "," + record.getUserID() + ","
+        + record.getGameID() + "," + record.getBorrowDate().toString();
+}
+
+/**
+ * Journal payload for a return: R,recordID,userID,gameID,borrowDate,returnDate
+ * @param record The record that was just marked returned.
+ */
+string CSVHandler::formatReturnEntry(const BorrowRecord& record) {
+    return "R," + record.getRecordID() + "," + record.getUserID() + ","
+        + record.getGameID() + "," + record.getBorrowDate().toString() + ","
+        + record.getReturnDate().toString();
+}
+
+/**
+ * Journal payload for a review: V,gameID,memberName,rating,comment
+ * The comment is last so it may contain commas.
+ */
+string CSVHandler::formatReviewEntry(const string& gameID, const string& memberName,
+    int rating, const string& comment) {
+    return "V," + gameID + "," + memberName + "," + intToStr(rating) + "," + comment;
+}
+
+/**
+ * Re-applies journal entries that did not reach the CSV snapshots before the
+ * last shutdown. Entries whose effect is already present are skipped, so a
+ * crash between a snapshot write and the journal checkpoint is harmless.
+ * @param filename Path of the journal.
+ * @param games Catalog to update (reviews, availability).
+ * @param records Borrow history to update.
+ * @param archive Cold tier; borrows already archived are not re-applied.
+ * @return Number of entries that changed something.
+ */
+int CSVHandler::replayJournal(const string& filename, GameDynamicArray& games, BorrowLinkedList& records,
+                              const BorrowArchive* archive) {
+    vector<JournalEntry> entries;
+    if (!CommitJournal::readEntries(filename, entries)) return 0;
+
+    int applied = 0;
+    vector<string> changedGames;
+    for (int i = 0; i < (int)entries.size(); i++) {
+        stringstream ss(entries[i].payload);
+        string type;
+        getline(ss, type, ',');
+
+        if (type == "B" || type == "R") {
+            string recordID, userID, gameID, borrowDate, returnDate;
+            getline(ss, recordID, ',');
+            getline(ss, userID, ',');
+            getline(ss, gameID, ',');
+            getline(ss, borrowDate, ',');
+            getline(ss, returnDate, ',');
+
+            BorrowRecord* existing = records.findRecord(recordID, userID, gameID, Date::parse(borrowDate));
+            Game* game = games.findByGameID(gameID);
+            if (existing == nullptr && archive != nullptr &&
+                archive->containsRecord(recordID, userID, gameID, Date::parse(borrowDate))) {
+                continue;  // already returned and archived; the entry predates that
+            }
+            if (type == "B" && existing == nullptr) {
+                records.insertFront(BorrowRecord(recordID, userID, gameID, Date::parse(borrowDate), Date()));
+                if (game != nullptr) game->decrementAvailable();
+                changedGames.push_back(gameID);
+                applied++;
+            }
+            else if (type == "R" && existing != nullptr && !existing->isReturned()) {
+                records.markReturned(existing, Date::parse(returnDate));
+                if (game != nullptr) game->incrementAvailable();
+                changedGames.push_back(gameID);
+                applied++;
+            }
+        }
+        else if (type == "V") {
+            string gameID, memberName, rateStr, comment;
+            getline(ss, gameID, ',');
+            getline(ss, memberName, ',');
+            getline(ss, rateStr, ',');
+            getline(ss, comment);
+
+            int rate = 0;
+            for (char c : rateStr) if (c >= '0' && c <= '9') rate = rate * 10 + (c - '0');
+
+            Game* game = games.findByGameID(gameID);
+            if (game != nullptr && !game->hasReview(memberName, comment, rate)) {
+                game->addReview(memberName, comment, rate);
+                changedGames.push_back(gameID);
+                applied++;
+            }
         }
     }
+    if (applied > 0) games.markAvailabilityChanged(changedGames);
+    return applied;
+}
+
+// --- CHUNKED LOADING ---
+
+/**
+ * Reads an entire file into memory in one call.
+ * @param filename Path to the file.
+ * @param contents Receives the raw bytes.
+ * @return False if the file could not be opened.
+ */
+bool CSVHandler::readFile(const string& filename, string& contents) {
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) return false;
+
+    file.seekg(0, ios::end);
+    streamoff length = file.tellg();
+    file.seekg(0, ios::beg);
 
-    outFile.close();
+    contents.assign((size_t)(length > 0 ? length : 0), '\0');
+    if (length > 0) file.read(&contents[0], length);
+    file.close();
     return true;
+}
+
+/**
+ * Finds the first byte after the header line.
+ * @param contents Whole file contents.
+ * @return Offset of the first data line (contents.size() if there is none).
+ */
+size_t CSVHandler::findDataStart(const string& contents) {
+    size_t newline = contents.find('\n');
+    return (newline == string::npos) ? contents.size() : newline + 1;
+}
+
+/**
+ * Splits [begin, end of file) into roughly equal byte ranges, moving each
+ * cut forward to the next line start so no row is split across chunks.
+ * @param contents Whole file contents.
+ * @param begin Offset of the first data line.
+ * @param parts Desired number of chunks.
+ * @param cuts Receives parts + 1 offsets; chunk i is [cuts[i], cuts[i + 1]).
+ */
+void CSVHandler::splitAtLines(const string& contents, size_t begin, int parts, vector<size_t>& cuts) {
+    cuts.clear();
+    cuts.push_back(begin);
+    if (parts < 1) parts = 1;
+
+    size_t length = contents.size() - begin;
+    for (int i = 1; i < parts; i++) {
+        size_t cut = begin + (length * i) / parts;
+        if (cut < cuts.back()) cut = cuts.back();
+        if (cut > begin && contents[cut - 1] != '\n') {
+            size_t newline = contents.find('\n', cut);
+            cut = (newline == string::npos) ? contents.size() : newline + 1;
+        }
+        cuts.push_back(cut);
+    }
+    cuts.push_back(contents.size());
+}
+
+/**
+ * Walks the lines in [begin, end) the same way getline() would.
+ * @param onLine Called with each line (newline stripped).
+ */
+template <class F>
+static void forEachLine(const string& contents, size_t begin, size_t end, F onLine) {
+    string line;
+    size_t pos = begin;
+    while (pos < end) {
+        size_t newline = contents.find('\n', pos);
+        if (newline == string::npos || newline > end) newline = end;
+        line.assign(contents, pos, newline - pos);
+        onLine(line);
+        pos = newline + 1;
+    }
+}
+
+/** Parses every games.csv row inside a chunk, in file order. */
+void CSVHandler::parseGameRows(const string& contents, size_t begin, size_t end, vector<GameRow>& rows) {
+    GameRow row;
+    forEachLine(contents, begin, end, [&](const string& line) {
+        if (parseGameLine(line, row)) rows.push_back(row);
+    });
+}
+
+/** Parses every users.csv row inside a chunk, in file order. */
+void CSVHandler::parseUserRows(const string& contents, size_t begin, size_t end, vector<User>& rows) {
+    User user;
+    forEachLine(contents, begin, end, [&](const string& line) {
+        if (parseUserLine(line, user)) rows.push_back(user);
+    });
+}
+
+/** Parses every borrow_records.csv row inside a chunk, in file order. */
+void CSVHandler::parseBorrowRows(const string& contents, size_t begin, size_t end, vector<BorrowRecord>& rows) {
+    BorrowRecord record;
+    forEachLine(contents, begin, end, [&](const string& line) {
+        if (parseBorrowLine(line, record)) rows.push_back(record);
+    });
+}
+
+/** Parses every browse_history.csv row (all members) inside a chunk, in file order. */
+void CSVHandler::parseBrowseRows(const string& contents, size_t begin, size_t end, vector<BrowseRow>& rows) {
+    forEachLine(contents, begin, end, [&](const string& line) {
+        if (trim(line) == "") return;
+        stringstream ss(line);
+        BrowseRow row;
+        getline(ss, row.userID, ',');
+        getline(ss, row.gameID, ',');
+        row.userID = trim(row.userID);
+        row.gameID = trim(row.gameID);
+        if (row.userID != "" && row.gameID != "") rows.push_back(row);
+    });
+}
+
+/** Parses every play_sessions.csv row inside a chunk, in file order. */
+void CSVHandler::parsePlaySessionRows(const string& contents, size_t begin, size_t end, vector<PlaySession>& rows) {
+    forEachLine(contents, begin, end, [&](const string& line) {
+        PlaySession session;
+        if (parsePlaySessionLine(line, session)) rows.push_back(session);
+    });
+}
+
+/** Parses every reviews.csv row inside a chunk, in file order. */
+void CSVHandler::parseReviewRows(const string& contents, size_t begin, size_t end, vector<ReviewRow>& rows) {
+    ReviewRow row;
+    forEachLine(contents, begin, end, [&](const string& line) {
+        if (parseReviewLine(line, row)) rows.push_back(row);
+    });
 }
\ No newline at end of file
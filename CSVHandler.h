@@ -2,14 +2,54 @@
 #define CSVHANDLER_H
 
 #include <string>
+#include <vector>
 using namespace std;
 
 #include "GameDynamicArray.h"
 #include "UserDynamicArray.h"
 #include "BorrowLinkedList.h"
 #include "BrowseHistory.h"
+#include "CommitJournal.h"
+#include "PlayStats.h"
+#include "ThreadPool.h"
+
+class CatalogSnapshot;
+class BorrowArchive;
+
+// Raw games.csv row; rows saved before IDs were stored get one assigned in row order
+struct GameRow {
+    string title;
+    int minPlayers;
+    int maxPlayers;
+    int year;
+    int minPlayTime;
+    int maxPlayTime;
+    string gameID;      // empty if the file has no gameID column
+};
+
+// Raw reviews.csv row, kept until the catalog is ready to attach it
+struct ReviewRow {
+    string gameID;
+    string memberName;
+    int rating;
+    string comment;
+};
+
+// Raw browse_history.csv row for every member (see Recommender)
+struct BrowseRow {
+    string userID;
+    string gameID;
+};
 
 class CSVHandler {
+private:
+    // Single-line parsers shared by the streaming and chunked loaders
+    static bool parseGameLine(const string& line, GameRow& row);
+    static bool parseUserLine(const string& line, User& user);
+    static bool parseBorrowLine(const string& line, BorrowRecord& record);
+    static bool parseReviewLine(const string& line, ReviewRow& row);
+    static bool parsePlaySessionLine(const string& line, PlaySession& session);
+
 public:
     static bool loadGames(const string& filename, GameDynamicArray& games);
     static bool saveGames(const string& filename, GameDynamicArray& games);
@@ -21,12 +61,92 @@ public:
     static bool saveBorrowRecords(const string& filename, BorrowLinkedList& records);
     static bool loadReviews(const string& filename, GameDynamicArray& games);
     static bool saveReviews(const string& filename, GameDynamicArray& games);
+
+    // Play sessions (see PlayStats); the file is parsed in chunks on the pool if one is given
+    static bool loadPlaySessions(const string& filename, PlayStats& stats, ThreadPool* pool = nullptr);
+    static bool savePlaySessions(const string& filename, PlayStats& stats);
+
+    // View counts and distinct-borrower counters, kept between runs in one binary file
+    static bool loadSketches(const string& filename, CountMinSketch& views, PopularityBoard& board);
+    static bool saveSketches(const string& filename, const CountMinSketch& views, const PopularityBoard& board);
     
     // Browse History methods
     static bool loadBrowseHistory(const string& filename, const string& userID, 
                                   BrowseHistory& history, GameDynamicArray& games);
     static bool saveBrowseHistory(const string& filename, const string& userID, 
                                   BrowseHistory& history);
+
+    // Snapshot formatting and raw writes (see PersistenceWorker)
+    static string formatGames(GameDynamicArray& games);
+    static string formatGames(const CatalogSnapshot& snapshot);
+    static string formatUsers(UserDynamicArray& users);
+    static string formatBorrowRecords(BorrowLinkedList& records);
+    static string formatBorrowRecords(const vector<BorrowRecord>& records);
+    static string formatReviews(GameDynamicArray& games);
+    static string formatBrowseHistory(const string& userID, BrowseHistory& history);
+    static string formatPlaySessions(PlayStats& stats);
+    static bool writeFile(const string& filename, const string& contents);
+    static bool mergeBrowseHistory(const string& filename, const string& userID, const string& rows);
+
+    // Group-commit journal entries (see CommitJournal) and crash recovery
+    static string formatBorrowEntry(const BorrowRecord& record);
+    static string formatReturnEntry(const BorrowRecord& record);
+    static string formatReviewEntry(const string& gameID, const string& memberName,
+                                    int rating, const string& comment);
+    static int replayJournal(const string& filename, GameDynamicArray& games, BorrowLinkedList& records,
+                             const BorrowArchive* archive = nullptr);
+
+    // Chunked loading support (see StartupPipeline)
+    static const size_t MIN_CHUNK_BYTES = 64 * 1024;    // smaller chunks are not worth a task
+
+    template <class Row>
+    static void parseChunked(ThreadPool* pool, const string& contents,
+                             void (*parse)(const string&, size_t, size_t, vector<Row>&), vector<Row>& rows);
+
+    static bool readFile(const string& filename, string& contents);
+    static size_t findDataStart(const string& contents);
+    static void splitAtLines(const string& contents, size_t begin, int parts, vector<size_t>& cuts);
+    static void parseGameRows(const string& contents, size_t begin, size_t end, vector<GameRow>& rows);
+    static void parseUserRows(const string& contents, size_t begin, size_t end, vector<User>& rows);
+    static void parseBorrowRows(const string& contents, size_t begin, size_t end, vector<BorrowRecord>& rows);
+    static void parseReviewRows(const string& contents, size_t begin, size_t end, vector<ReviewRow>& rows);
+    static void parseBrowseRows(const string& contents, size_t begin, size_t end, vector<BrowseRow>& rows);
+    static void parsePlaySessionRows(const string& contents, size_t begin, size_t end, vector<PlaySession>& rows);
 };
 
+/**
+ * Parses the data rows of a whole file: the text after the header is cut
+ * into line-aligned byte ranges that are parsed in parallel (inline if pool
+ * is null). Each range fills its own list, and the lists are appended in
+ * order, so rows keep their file order.
+ * @param parse One of the parse*Rows functions.
+ * @param rows Receives the parsed rows.
+ */
+template <class Row>
+void CSVHandler::parseChunked(ThreadPool* pool, const string& contents,
+    void (*parse)(const string&, size_t, size_t, vector<Row>&), vector<Row>& rows) {
+    size_t begin = findDataStart(contents);
+    size_t bytes = contents.size() - begin;
+
+    int parts = (int)(bytes / MIN_CHUNK_BYTES) + 1;
+    int maxParts = (pool != nullptr) ? pool->getThreadCount() * 2 : 1;
+    if (parts > maxParts) parts = maxParts;
+
+    vector<size_t> cuts;
+    splitAtLines(contents, begin, parts, cuts);
+    vector<vector<Row>> chunks(parts);
+    parallelFor(pool, 0, parts, 1, [&](int first, int last) {
+        for (int c = first; c < last; c++) parse(contents, cuts[c], cuts[c + 1], chunks[c]);
+    });
+
+    if (parts == 1 && rows.empty()) {
+        rows.swap(chunks[0]);
+        return;
+    }
+    size_t total = rows.size();
+    for (int c = 0; c < parts; c++) total += chunks[c].size();
+    rows.reserve(total);
+    for (int c = 0; c < parts; c++) rows.insert(rows.end(), chunks[c].begin(), chunks[c].end());
+}
+
 #endif
@@ -0,0 +1,311 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Lock-Free Reads: A reader announces the epoch it entered in its own padded
+ * slot and loads the current version pointer; no lock is taken and no shared
+ * counter is written, so reads scale with the number of cores.
+ * - Atomic Publication: The writer builds a complete new version beside the
+ * old one and swaps it in with a single atomic store, so readers see either
+ * the old catalog or the new one, never a mix.
+ * - Epoch-Based Reclamation: Replaced versions are kept until every reader
+ * that might still hold them has left its read-side section.
+ * - Copy-on-Write Chunks: Rows are stored in chunks of 256 games and the ID
+ * index in 64 shards; the catalog reports which positions changed, so a new
+ * version copies only those chunks and shards and shares the rest.
+ *****************************************************************************/
+
+#include "CatalogSnapshot.h"
+#include "Game.h"
+#include "GameDynamicArray.h"
+#include "MemoryFootprint.h"
+#include <algorithm>
+#include <climits>
+#include <thread>
+using namespace std;
+
+// Spreads threads over the reader slots (each thread remembers its last slot)
+static atomic<unsigned int> nextSlotHint(0);
+
+void GameView::copyFrom(const Game& game) {
+    gameID = game.getGameID();
+    title = game.getTitle();
+    minPlayers = game.getMinPlayers();
+    maxPlayers = game.getMaxPlayers();
+    minPlayTime = game.getMinPlayTime();
+    maxPlayTime = game.getMaxPlayTime();
+    year = game.getYear();
+    totalCopies = game.getTotalCopies();
+    availableCopies = game.getAvailableCopies();
+    reviewCount = game.getReviewCount();
+    averageRating = game.getAverageRating();
+}
+
+void CatalogChanges::clear() {
+    rebuild = false;
+    recheckRows = false;
+    positions.clear();
+    removedIDs.clear();
+}
+
+/** @return True if the live game still matches this frozen copy. */
+bool GameView::sameAs(const Game& game) const {
+    return availableCopies == game.getAvailableCopies() && reviewCount == game.getReviewCount() &&
+           totalCopies == game.getTotalCopies() && averageRating == game.getAverageRating() &&
+           minPlayers == game.getMinPlayers() && maxPlayers == game.getMaxPlayers() &&
+           minPlayTime == game.getMinPlayTime() && maxPlayTime == game.getMaxPlayTime() &&
+           year == game.getYear() && gameID == game.getGameID() && title == game.getTitle();
+}
+
+CatalogSnapshot::CatalogSnapshot() {
+    count = 0;
+    version = 0;
+}
+
+/** @return The ID index shard that holds this game ID. */
+int CatalogSnapshot::shardOf(const string& gameID) {
+    return (int)(hash<string>()(gameID) % ID_SHARDS);
+}
+
+/** @return The game at a catalog position (as of this version). */
+const GameView& CatalogSnapshot::get(int position) const {
+    return chunks[position / CHUNK_SIZE]->rows[position % CHUNK_SIZE];
+}
+
+/**
+ * Looks a game up by ID in this version.
+ * Time Complexity: O(1) average
+ * @return The game, or nullptr if it was not in the catalog at this version.
+ */
+const GameView* CatalogSnapshot::findByGameID(const string& gameID) const {
+    const unordered_map<string, int>& positions = ids[shardOf(gameID)]->positions;
+    unordered_map<string, int>::const_iterator it = positions.find(gameID);
+    if (it == positions.end()) return nullptr;
+    return &get(it->second);
+}
+
+CatalogVersions::CatalogVersions() : current(nullptr), globalEpoch(1) {
+    for (int i = 0; i < MAX_READERS; i++) {
+        slots[i].busy = false;
+        slots[i].epoch = 0;
+    }
+    published = reclaimed = 0;
+    chunksCopied = chunksShared = shardsCopied = 0;
+}
+
+/** Frees every version; no reader may still be inside a section. */
+CatalogVersions::~CatalogVersions() {
+    for (int i = 0; i < (int)retired.size(); i++) release(retired[i].snapshot);
+    if (current.load() != nullptr) release(current.load());
+}
+
+/**
+ * Starts a read-side section on a free slot (normally the one this thread
+ * used last) and announces the epoch it started in.
+ * @return The slot index.
+ */
+int CatalogVersions::beginRead() {
+    static thread_local int hint = -1;
+    if (hint < 0) hint = (int)(nextSlotHint.fetch_add(1) % MAX_READERS);
+    for (int attempt = 0; ; attempt++) {
+        int slot = (hint + attempt) % MAX_READERS;
+        bool expected = false;
+        if (!slots[slot].busy.load(memory_order_relaxed) &&
+            slots[slot].busy.compare_exchange_strong(expected, true, memory_order_acquire)) {
+            hint = slot;
+            // Must be visible before the version pointer is read (see reclaimRetired)
+            slots[slot].epoch.store(globalEpoch.load());
+            return slot;
+        }
+        if (attempt % MAX_READERS == MAX_READERS - 1) this_thread::yield();   // every slot busy
+    }
+}
+
+void CatalogVersions::endRead(int slot) {
+    slots[slot].epoch.store(0, memory_order_release);
+    slots[slot].busy.store(false, memory_order_release);
+}
+
+CatalogVersions::Reader::Reader(CatalogVersions& owner) : versions(owner) {
+    slot = versions.beginRead();
+    current = versions.current.load();
+}
+
+CatalogVersions::Reader::~Reader() {
+    versions.endRead(slot);
+}
+
+/**
+ * Publishes the catalog's current state as a new version. Only the chunks
+ * holding changed positions and the index shards holding changed IDs are
+ * copied; everything else is shared with the previous version.
+ * Time Complexity: O(k * CHUNK_SIZE + k * n / ID_SHARDS) for k changed
+ * positions (O(n) for the first version or a rebuild)
+ * @param games The live catalog (read on the writer's thread).
+ * @param changes What changed since the last publication.
+ */
+void CatalogVersions::publish(const GameDynamicArray& games, const CatalogChanges& changes) {
+    lock_guard<mutex> lock(writerLock);
+    CatalogSnapshot* old = current.load();
+    CatalogSnapshot* next = new CatalogSnapshot();
+    next->count = games.size();
+    next->version = (old != nullptr) ? old->version + 1 : 1;
+    bool rebuild = changes.rebuild || old == nullptr;
+
+    int chunkCount = (next->count + CatalogSnapshot::CHUNK_SIZE - 1) / CatalogSnapshot::CHUNK_SIZE;
+    vector<bool> dirty(chunkCount, rebuild);
+    for (int i = 0; i < (int)changes.positions.size(); i++) {
+        int position = changes.positions[i];
+        if (position < next->count) dirty[position / CatalogSnapshot::CHUNK_SIZE] = true;
+    }
+    for (int c = 0; c < chunkCount; c++) {
+        int first = c * CatalogSnapshot::CHUNK_SIZE;
+        int last = min(next->count, first + CatalogSnapshot::CHUNK_SIZE);
+
+        CatalogSnapshot::Chunk* previous = (old != nullptr && c < (int)old->chunks.size()) ? old->chunks[c] : nullptr;
+        bool same = !dirty[c] && previous != nullptr && (int)previous->rows.size() == last - first;
+        if (same && changes.recheckRows) {
+            for (int i = first; same && i < last; i++) same = previous->rows[i - first].sameAs(games.get(i));
+        }
+        if (same) {
+            previous->refs++;
+            next->chunks.push_back(previous);
+            chunksShared++;
+            continue;
+        }
+
+        CatalogSnapshot::Chunk* chunk = new CatalogSnapshot::Chunk();
+        chunk->refs = 1;
+        chunk->rows.resize(last - first);
+        for (int i = first; i < last; i++) chunk->rows[i - first].copyFrom(games.get(i));
+        next->chunks.push_back(chunk);
+        chunksCopied++;
+    }
+
+    if (rebuild) {
+        for (int s = 0; s < CatalogSnapshot::ID_SHARDS; s++) {
+            next->ids.push_back(new CatalogSnapshot::IdShard());
+            next->ids[s]->refs = 1;
+        }
+        for (int i = 0; i < next->count; i++) {
+            const string& gameID = games.get(i).getGameID();
+            next->ids[CatalogSnapshot::shardOf(gameID)]->positions[gameID] = i;
+        }
+    }
+    else {
+        next->ids = old->ids;
+        for (int s = 0; s < CatalogSnapshot::ID_SHARDS; s++) next->ids[s]->refs++;
+
+        // Copies a shard the first time this version changes one of its entries
+        vector<bool> owned(CatalogSnapshot::ID_SHARDS, false);
+        auto writable = [&](int s) -> unordered_map<string, int>& {
+            if (!owned[s]) {
+                CatalogSnapshot::IdShard* copy = new CatalogSnapshot::IdShard(*next->ids[s]);
+                copy->refs = 1;
+                next->ids[s]->refs--;
+                next->ids[s] = copy;
+                owned[s] = true;
+                shardsCopied++;
+            }
+            return next->ids[s]->positions;
+        };
+        // Removals first, so an ID removed and re-added ends up present
+        for (int i = 0; i < (int)changes.removedIDs.size(); i++) {
+            int s = CatalogSnapshot::shardOf(changes.removedIDs[i]);
+            if (next->ids[s]->positions.count(changes.removedIDs[i])) writable(s).erase(changes.removedIDs[i]);
+        }
+        for (int i = 0; i < (int)changes.positions.size(); i++) {
+            int position = changes.positions[i];
+            if (position >= next->count) continue;
+            const string& gameID = games.get(position).getGameID();
+            int s = CatalogSnapshot::shardOf(gameID);
+            unordered_map<string, int>::const_iterator it = next->ids[s]->positions.find(gameID);
+            if (it == next->ids[s]->positions.end() || it->second != position) writable(s)[gameID] = position;
+        }
+    }
+
+    // Readers that load the pointer from here on get the new version; the old
+    // one is retired in the epoch it was replaced in
+    current.store(next);
+    published++;
+    if (old != nullptr) {
+        Retired entry = { old, globalEpoch.fetch_add(1) };
+        retired.push_back(entry);
+    }
+    reclaimRetired();
+}
+
+/** Frees the retired versions whose grace period has ended. */
+void CatalogVersions::reclaim() {
+    lock_guard<mutex> lock(writerLock);
+    reclaimRetired();
+}
+
+/**
+ * A version retired in epoch E can only be held by a reader that announced
+ * an epoch <= E: a reader announcing E + 1 or later read the global epoch
+ * after the new version was stored, so it loaded the new pointer.
+ */
+void CatalogVersions::reclaimRetired() {
+    unsigned long long oldestReader = ULLONG_MAX;
+    for (int i = 0; i < MAX_READERS; i++) {
+        unsigned long long epoch = slots[i].epoch.load();
+        if (epoch != 0 && epoch < oldestReader) oldestReader = epoch;
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < retired.size(); i++) {
+        if (retired[i].epoch < oldestReader) {
+            release(retired[i].snapshot);
+            reclaimed++;
+        }
+        else {
+            retired[kept++] = retired[i];
+        }
+    }
+    retired.resize(kept);
+}
+
+// Drops a version's references to its chunks and index, freeing unshared ones
+void CatalogVersions::release(CatalogSnapshot* snapshot) {
+    for (int c = 0; c < (int)snapshot->chunks.size(); c++) {
+        if (--snapshot->chunks[c]->refs == 0) delete snapshot->chunks[c];
+    }
+    for (int s = 0; s < (int)snapshot->ids.size(); s++) {
+        if (--snapshot->ids[s]->refs == 0) delete snapshot->ids[s];
+    }
+    delete snapshot;
+}
+
+void CatalogVersions::getStats(Stats& stats) {
+    lock_guard<mutex> lock(writerLock);
+    stats.published = published;
+    stats.reclaimed = reclaimed;
+    stats.pending = (int)retired.size();
+    stats.chunksCopied = chunksCopied;
+    stats.chunksShared = chunksShared;
+    stats.shardsCopied = shardsCopied;
+}
+
+size_t CatalogVersions::memoryUsage() {
+    lock_guard<mutex> lock(writerLock);
+    const CatalogSnapshot* snapshot = current.load();
+    if (snapshot == nullptr) return 0;
+    size_t bytes = sizeof(CatalogSnapshot) + vectorHeapBytes(snapshot->chunks);
+    for (int c = 0; c < (int)snapshot->chunks.size(); c++) {
+        const vector<GameView>& rows = snapshot->chunks[c]->rows;
+        bytes += sizeof(CatalogSnapshot::Chunk) + vectorHeapBytes(rows);
+        for (int i = 0; i < (int)rows.size(); i++) {
+            bytes += stringHeapBytes(rows[i].gameID) + stringHeapBytes(rows[i].title);
+        }
+    }
+    bytes += vectorHeapBytes(snapshot->ids);
+    for (int s = 0; s < (int)snapshot->ids.size(); s++) {
+        const unordered_map<string, int>& positions = snapshot->ids[s]->positions;
+        bytes += sizeof(CatalogSnapshot::IdShard) + hashMapHeapBytes(positions);
+        for (unordered_map<string, int>::const_iterator it = positions.begin(); it != positions.end(); ++it) {
+            bytes += stringHeapBytes(it->first);
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,165 @@
+#ifndef CATALOGSNAPSHOT_H
+#define CATALOGSNAPSHOT_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+class Game;
+class GameDynamicArray;
+
+// Frozen copy of one game's catalog fields (reviews stay in the live catalog)
+struct GameView {
+    string gameID;
+    string title;
+    int minPlayers;
+    int maxPlayers;
+    int minPlayTime;
+    int maxPlayTime;
+    int year;
+    int totalCopies;
+    int availableCopies;
+    int reviewCount;
+    double averageRating;
+
+    void copyFrom(const Game& game);
+    bool sameAs(const Game& game) const;
+};
+
+// What changed in the live catalog since the last publication (kept by GameDynamicArray)
+struct CatalogChanges {
+    bool rebuild;               // copy every chunk and rebuild the ID index
+    bool recheckRows;           // some rows changed without naming them: compare every row
+    vector<int> positions;      // positions whose game changed, arrived or moved
+    vector<string> removedIDs;  // games removed from the catalog
+
+    CatalogChanges() : rebuild(false), recheckRows(false) {}
+    void clear();
+};
+
+/**
+ * One published version of the catalog. It never changes after publication,
+ * so any number of threads can read it without locks while they hold a
+ * CatalogVersions::Reader. Versions share unchanged chunks of rows and
+ * unchanged shards of the ID index with the version before them
+ * (copy-on-write per chunk and per shard).
+ */
+class CatalogSnapshot {
+public:
+    static const int CHUNK_SIZE = 256;
+    static const int ID_SHARDS = 64;
+
+    int size() const { return count; }
+    const GameView& get(int position) const;
+    const GameView* findByGameID(const string& gameID) const;
+    unsigned long long getVersion() const { return version; }
+
+private:
+    friend class CatalogVersions;
+
+    // Reference counts are only touched by the (single) writer
+    struct Chunk {
+        vector<GameView> rows;
+        int refs;
+    };
+    // One shard of the ID index; copied only when one of its entries changes
+    struct IdShard {
+        unordered_map<string, int> positions;   // gameID -> position
+        int refs;
+    };
+
+    vector<Chunk*> chunks;
+    vector<IdShard*> ids;   // ID_SHARDS shards, chosen by hash of the game ID
+    int count;
+    unsigned long long version;
+
+    CatalogSnapshot();
+    static int shardOf(const string& gameID);
+};
+
+/**
+ * Read-copy-update publisher for catalog snapshots with epoch-based reclamation.
+ * Readers enter a read-side section (Reader) by announcing the current epoch in
+ * a slot of their own and loading the current version; they take no lock and
+ * write no shared cache line. The writer builds a new version next to the old
+ * one, publishes it with one atomic store and retires the old version tagged
+ * with the epoch it was replaced in. A retired version is freed once every
+ * reader still inside a section entered after that epoch (the grace period).
+ */
+class CatalogVersions {
+public:
+    static const int MAX_READERS = 64;      // concurrent read-side sections
+
+    // Read-side section: the snapshot stays valid until the Reader is destroyed
+    class Reader {
+    public:
+        explicit Reader(CatalogVersions& owner);
+        ~Reader();
+        const CatalogSnapshot& snapshot() const { return *current; }
+
+    private:
+        CatalogVersions& versions;
+        int slot;
+        const CatalogSnapshot* current;
+
+    public:
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+    };
+
+    struct Stats {
+        long long published;
+        long long reclaimed;
+        int pending;            // retired versions still inside their grace period
+        long long chunksCopied;
+        long long chunksShared;
+        long long shardsCopied; // ID index shards copied because an entry changed
+    };
+
+    CatalogVersions();
+    ~CatalogVersions();
+
+    CatalogVersions(const CatalogVersions&) = delete;
+    CatalogVersions& operator=(const CatalogVersions&) = delete;
+
+    // Writer side (see GameDynamicArray::attachSnapshots)
+    void publish(const GameDynamicArray& games, const CatalogChanges& changes);
+    void reclaim();
+
+    void getStats(Stats& stats);
+    size_t memoryUsage();       // bytes held by the current version (see MemoryFootprint.h)
+
+private:
+    // Padded so every reader's slot sits on its own cache line
+    struct ReaderSlot {
+        atomic<bool> busy;
+        atomic<unsigned long long> epoch;   // 0 = not reading
+        char padding[48];
+    };
+    struct Retired {
+        CatalogSnapshot* snapshot;
+        unsigned long long epoch;
+    };
+
+    atomic<CatalogSnapshot*> current;
+    atomic<unsigned long long> globalEpoch;
+    ReaderSlot slots[MAX_READERS];
+
+    mutex writerLock;
+    vector<Retired> retired;
+    long long published;
+    long long reclaimed;
+    long long chunksCopied;
+    long long chunksShared;
+    long long shardsCopied;
+
+    int beginRead();
+    void endRead(int slot);
+    void reclaimRetired();
+    void release(CatalogSnapshot* snapshot);
+};
+
+#endif
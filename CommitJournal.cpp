@@ -0,0 +1,303 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Group Commit: Entries appended close together share one write and one
+ * fsync, so throughput is not capped at one disk sync per borrow.
+ * - Completion Signals: Each append returns a future that turns true once
+ * that entry is durable (false if the write or sync failed).
+ * - Crash Recovery: Entries carry a log sequence number and torn trailing
+ * lines are ignored when the journal is read back at startup. A batch whose
+ * write or sync fails is cut back out of the file, so later batches never
+ * start in the middle of a torn line.
+ * - Checkpointing: The journal is truncated once the CSV snapshots cover
+ * every entry in it.
+ *****************************************************************************/
+
+#include "CommitJournal.h"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+using namespace std;
+
+/**
+ * Opens a C stream (fopen_s on MSVC, where fopen is flagged as unsafe).
+ * @return The stream, or nullptr on failure.
+ */
+static FILE* openStream(const string& name, const char* mode) {
+    FILE* stream = nullptr;
+#ifdef _WIN32
+    if (fopen_s(&stream, name.c_str(), mode) != 0) return nullptr;
+#else
+    stream = fopen(name.c_str(), mode);
+#endif
+    return stream;
+}
+
+/**
+ * Pushes buffered bytes to the OS and forces them onto the disk.
+ * @return True if both the flush and the sync succeeded.
+ */
+static bool syncStream(FILE* stream) {
+    if (fflush(stream) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(stream)) == 0;
+#else
+    return fsync(fileno(stream)) == 0;
+#endif
+}
+
+/**
+ * Removes a failed batch: the file is cut back to the offset the batch
+ * started at and reopened for appending. If it cannot be cut, the journal is
+ * closed instead, so the fragment stays a torn last line (which readEntries
+ * ignores) and later appends report failure rather than follow it.
+ * @return The reopened stream, or nullptr.
+ */
+static FILE* discardBatch(FILE* stream, const string& name, long offset) {
+    fclose(stream);     // anything still buffered is cut off below
+    if (offset < 0) return nullptr;
+    FILE* cutting = openStream(name, "r+b");
+    if (cutting == nullptr) return nullptr;
+#ifdef _WIN32
+    bool cut = _chsize_s(_fileno(cutting), offset) == 0;
+#else
+    bool cut = ftruncate(fileno(cutting), (off_t)offset) == 0;
+#endif
+    fclose(cutting);
+    return cut ? openStream(name, "ab") : nullptr;
+}
+
+/**
+ * Opens (or creates) the journal and starts the committer thread.
+ * LSNs continue from the highest one already in the file.
+ * @param journalFile Path of the journal.
+ * @param windowMs How long the committer gathers entries before each fsync.
+ */
+CommitJournal::CommitJournal(const string& journalFile, int windowMs) {
+    filename = journalFile;
+    commitWindowMs = windowMs;
+    lastLSN = 0;
+    committing = false;
+    stopping = false;
+    entriesCommitted = 0;
+    entriesFailed = 0;
+    bufferedEntries = 0;
+    batchesCommitted = 0;
+
+    vector<JournalEntry> existing;
+    readEntries(filename, existing);
+    for (int i = 0; i < (int)existing.size(); i++) {
+        if (existing[i].lsn > lastLSN) lastLSN = existing[i].lsn;
+    }
+    durableLSN = lastLSN;
+    batchLost = false;
+
+    file = openStream(filename, "ab");
+    committer = thread(&CommitJournal::committerLoop, this);
+}
+
+/** Commits whatever is still buffered and closes the file. */
+CommitJournal::~CommitJournal() {
+    stop();
+}
+
+/**
+ * Adds one entry to the current batch.
+ * @param payload CSV payload (must not contain a newline).
+ * @return Future that becomes true once the entry has been fsynced.
+ */
+shared_future<bool> CommitJournal::append(const string& payload) {
+    lock_guard<mutex> lock(journalMutex);
+    promise<bool> done;
+    shared_future<bool> result = done.get_future().share();
+
+    if (file == nullptr || stopping) {
+        done.set_value(false);
+        return result;
+    }
+
+    lastLSN++;
+    stringstream line;
+    line << lastLSN << "," << payload << "\n";
+    buffer += line.str();
+    bufferedEntries++;
+    waiters.push_back(move(done));
+    wake.notify_one();
+    return result;
+}
+
+/**
+ * Adds several entries to the current batch as one unit: they get
+ * consecutive LSNs and always land in the same write and fsync.
+ * @param payloads CSV payloads (none may contain a newline).
+ * @return Future that becomes true once every entry has been fsynced.
+ */
+shared_future<bool> CommitJournal::appendBatch(const vector<string>& payloads) {
+    lock_guard<mutex> lock(journalMutex);
+    promise<bool> done;
+    shared_future<bool> result = done.get_future().share();
+
+    if (file == nullptr || stopping) {
+        done.set_value(false);
+        return result;
+    }
+
+    stringstream lines;
+    for (int i = 0; i < (int)payloads.size(); i++) {
+        lastLSN++;
+        lines << lastLSN << "," << payloads[i] << "\n";
+    }
+    buffer += lines.str();
+    bufferedEntries += (long long)payloads.size();
+    waiters.push_back(move(done));
+    wake.notify_one();
+    return result;
+}
+
+/**
+ * Empties the journal once the on-disk snapshots cover every entry.
+ * Skipped (left for a later checkpoint) while a batch is still in flight,
+ * and for the rest of the run once a batch has been lost.
+ * @param coveredLSN Highest LSN whose effects are saved in the CSV files.
+ */
+void CommitJournal::checkpoint(long long coveredLSN) {
+    lock_guard<mutex> lock(journalMutex);
+    if (file == nullptr || committing || !buffer.empty()) return;
+    if (coveredLSN < lastLSN || durableLSN < lastLSN) return;
+
+    fclose(file);
+    file = openStream(filename, "wb");
+}
+
+/** Commits the last batch and stops the committer thread. Safe to call twice. */
+void CommitJournal::stop() {
+    {
+        lock_guard<mutex> lock(journalMutex);
+        if (stopping) return;
+        stopping = true;
+    }
+    wake.notify_one();
+    if (committer.joinable()) committer.join();
+    if (file != nullptr) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+/**
+ * Committer thread: once entries arrive, waits out the commit window so
+ * nearby appends join the batch, then writes and fsyncs the batch once and
+ * completes every waiter with the result.
+ */
+void CommitJournal::committerLoop() {
+    unique_lock<mutex> lock(journalMutex);
+    while (true) {
+        wake.wait(lock, [this]() { return stopping || !buffer.empty(); });
+        if (buffer.empty() && stopping) break;
+
+        if (commitWindowMs > 0 && !stopping) {
+            chrono::steady_clock::time_point closeAt =
+                chrono::steady_clock::now() + chrono::milliseconds(commitWindowMs);
+            wake.wait_until(lock, closeAt, [this]() { return stopping; });
+        }
+
+        string batch;
+        batch.swap(buffer);
+        vector<promise<bool>> batchWaiters;
+        batchWaiters.swap(waiters);
+        long long batchEntries = bufferedEntries;
+        bufferedEntries = 0;
+        long long batchLSN = lastLSN;
+        committing = true;
+        lock.unlock();
+
+        long startOffset = (file != nullptr && fseek(file, 0, SEEK_END) == 0) ? ftell(file) : -1;
+        bool ok = file != nullptr && startOffset >= 0
+            && fwrite(batch.data(), 1, batch.size(), file) == batch.size()
+            && syncStream(file);
+
+        for (int i = 0; i < (int)batchWaiters.size(); i++) batchWaiters[i].set_value(ok);
+
+        lock.lock();
+        if (ok) {
+            // LSNs after a lost batch are on disk, but the lost ones are not
+            if (!batchLost) durableLSN = batchLSN;
+            entriesCommitted += batchEntries;
+            batchesCommitted++;
+        }
+        else {
+            batchLost = true;
+            entriesFailed += batchEntries;
+            if (file != nullptr) file = discardBatch(file, filename, startOffset);
+        }
+        committing = false;
+    }
+}
+
+long long CommitJournal::getLastLSN() {
+    lock_guard<mutex> lock(journalMutex);
+    return lastLSN;
+}
+
+long long CommitJournal::getEntriesCommitted() {
+    lock_guard<mutex> lock(journalMutex);
+    return entriesCommitted;
+}
+
+long long CommitJournal::getEntriesFailed() {
+    lock_guard<mutex> lock(journalMutex);
+    return entriesFailed;
+}
+
+long long CommitJournal::getBatchesCommitted() {
+    lock_guard<mutex> lock(journalMutex);
+    return batchesCommitted;
+}
+
+/**
+ * Reads every complete entry from a journal file.
+ * A trailing line without a newline is a torn write and is ignored.
+ * @param journalFile Path of the journal.
+ * @param entries Receives the entries in LSN order.
+ * @return False if the file does not exist.
+ */
+bool CommitJournal::readEntries(const string& journalFile, vector<JournalEntry>& entries) {
+    ifstream in(journalFile, ios::binary);
+    if (!in.is_open()) return false;
+
+    stringstream raw;
+    raw << in.rdbuf();
+    string contents = raw.str();
+
+    size_t pos = 0;
+    while (pos < contents.size()) {
+        size_t newline = contents.find('\n', pos);
+        if (newline == string::npos) break;  // torn write
+
+        string line = contents.substr(pos, newline - pos);
+        pos = newline + 1;
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+
+        size_t comma = line.find(',');
+        if (comma == string::npos || comma == 0) continue;
+
+        JournalEntry entry;
+        entry.lsn = 0;
+        bool numeric = true;
+        for (size_t i = 0; i < comma; i++) {
+            if (line[i] < '0' || line[i] > '9') { numeric = false; break; }
+            entry.lsn = entry.lsn * 10 + (line[i] - '0');
+        }
+        if (!numeric) continue;
+        entry.payload = line.substr(comma + 1);
+        entries.push_back(entry);
+    }
+    return true;
+}
@@ -0,0 +1,71 @@
+#ifndef COMMITJOURNAL_H
+#define COMMITJOURNAL_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// One durable journal line: log sequence number + CSV payload
+struct JournalEntry {
+    long long lsn;
+    string payload;
+};
+
+/**
+ * Append-only group-commit journal.
+ * append() copies the entry into a shared buffer and returns at once; a
+ * committer thread writes everything buffered during the commit window with
+ * one write and one fsync, then completes every caller's future together.
+ * Entries are dropped by checkpoint() once the CSV snapshots cover them.
+ */
+class CommitJournal {
+private:
+    string filename;
+    FILE* file;
+    int commitWindowMs;
+
+    string buffer;                      // entries waiting for the next batch
+    vector<promise<bool>> waiters;      // one per append/appendBatch call
+    long long bufferedEntries;          // entries in the buffer
+    long long lastLSN;                  // highest LSN handed out
+    long long durableLSN;               // every LSN up to this one is on disk
+    bool batchLost;                     // a batch failed; durableLSN stays below it
+    bool committing;
+    bool stopping;
+
+    long long entriesCommitted;
+    long long entriesFailed;            // entries whose batch could not be written
+    long long batchesCommitted;
+
+    mutex journalMutex;
+    condition_variable wake;
+    thread committer;
+
+    void committerLoop();
+
+public:
+    CommitJournal(const string& journalFile = "journal.log", int windowMs = 2);
+    ~CommitJournal();
+
+    CommitJournal(const CommitJournal&) = delete;
+    CommitJournal& operator=(const CommitJournal&) = delete;
+
+    shared_future<bool> append(const string& payload);
+    shared_future<bool> appendBatch(const vector<string>& payloads);
+    void checkpoint(long long coveredLSN);
+    void stop();
+
+    long long getLastLSN();
+    long long getEntriesCommitted();
+    long long getEntriesFailed();
+    long long getBatchesCommitted();
+
+    static bool readEntries(const string& journalFile, vector<JournalEntry>& entries);
+};
+
+#endif
@@ -0,0 +1,173 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Chunked Output: Listings are assembled in a 64 KB buffer and written in
+ * large blocks, so a million-row report costs a few hundred writes instead of
+ * millions of small, flushed ones.
+ * - Direct Formatting: Numbers and dates are turned into digits inside the
+ * buffer, with no temporary strings or stream formatting state.
+ * - Streaming and Paging: Rows pass through the buffer as they are produced;
+ * optional paging stops the producer as soon as the reader quits.
+ *****************************************************************************/
+
+#include "ConsoleRenderer.h"
+#include "Date.h"
+#include <cstring>
+using namespace std;
+
+ConsoleRenderer::ConsoleRenderer(ostream& output) : out(output) {
+    buffer = new char[BUFFER_SIZE];
+    used = 0;
+    pageInput = nullptr;
+    pageSize = 0;
+    rowsOnPage = 0;
+    rowCount = 0;
+    stopped = false;
+}
+
+ConsoleRenderer::~ConsoleRenderer() {
+    flush();
+    delete[] buffer;
+}
+
+/** Makes room for 'bytes' more characters, writing out the buffer if needed. */
+void ConsoleRenderer::reserve(int bytes) {
+    if (used + bytes > BUFFER_SIZE) {
+        out.write(buffer, used);
+        used = 0;
+    }
+}
+
+/** Writes everything buffered so far to the output stream. */
+void ConsoleRenderer::flush() {
+    if (used > 0) out.write(buffer, used);
+    used = 0;
+    out.flush();
+}
+
+ConsoleRenderer& ConsoleRenderer::text(const char* value) {
+    int length = (int)strlen(value);
+    if (length > BUFFER_SIZE) {
+        // Too large to buffer: write it through directly
+        flush();
+        out.write(value, length);
+        return *this;
+    }
+    reserve(length);
+    memcpy(buffer + used, value, length);
+    used += length;
+    return *this;
+}
+
+ConsoleRenderer& ConsoleRenderer::text(const string& value) {
+    return text(value.c_str());
+}
+
+ConsoleRenderer& ConsoleRenderer::ch(char value) {
+    reserve(1);
+    buffer[used++] = value;
+    return *this;
+}
+
+/** Appends a number in decimal. Time Complexity: O(digits) */
+ConsoleRenderer& ConsoleRenderer::number(long long value) {
+    char digits[24];
+    int length = 0;
+    unsigned long long magnitude = (value < 0) ? 0ull - (unsigned long long)value : (unsigned long long)value;
+    do {
+        digits[length++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) digits[length++] = '-';
+
+    reserve(length);
+    while (length > 0) buffer[used++] = digits[--length];
+    return *this;
+}
+
+/** Appends a date as YYYY-MM-DD (nothing for an empty date). */
+ConsoleRenderer& ConsoleRenderer::date(const Date& value) {
+    int key = value.toKey();
+    if (key == 0) return *this;
+    reserve(10);
+    char* p = buffer + used;
+    int year = key / 10000, month = key / 100 % 100, day = key % 100;
+    p[0] = (char)('0' + year / 1000 % 10);
+    p[1] = (char)('0' + year / 100 % 10);
+    p[2] = (char)('0' + year / 10 % 10);
+    p[3] = (char)('0' + year % 10);
+    p[4] = '-';
+    p[5] = (char)('0' + month / 10);
+    p[6] = (char)('0' + month % 10);
+    p[7] = '-';
+    p[8] = (char)('0' + day / 10);
+    p[9] = (char)('0' + day % 10);
+    used += 10;
+    return *this;
+}
+
+ConsoleRenderer& ConsoleRenderer::repeat(char value, int times) {
+    while (times > 0) {
+        int chunk = (times < BUFFER_SIZE) ? times : BUFFER_SIZE;
+        reserve(chunk);
+        memset(buffer + used, value, chunk);
+        used += chunk;
+        times -= chunk;
+    }
+    return *this;
+}
+
+/**
+ * Appends text left-aligned in a column of the given width; text longer than
+ * the column is written in full.
+ */
+ConsoleRenderer& ConsoleRenderer::column(const string& value, int width) {
+    text(value);
+    if ((int)value.size() < width) repeat(' ', width - (int)value.size());
+    return *this;
+}
+
+ConsoleRenderer& ConsoleRenderer::newline() {
+    return ch('\n');
+}
+
+/**
+ * Turns paging on or off.
+ * @param rows Rows shown before pausing (0 = never pause).
+ * @param input Stream the "more?" answer is read from.
+ */
+void ConsoleRenderer::setPageSize(int rows, istream& input) {
+    pageSize = (rows > 0) ? rows : 0;
+    pageInput = (rows > 0) ? &input : nullptr;
+    rowsOnPage = 0;
+}
+
+/**
+ * Marks the end of one listed row. When a page is full the buffer is shown
+ * and the reader is asked whether to continue.
+ * @return False if the reader chose to stop; callers should stop producing rows.
+ */
+bool ConsoleRenderer::endRow() {
+    rowCount++;
+    if (stopped) return false;
+    if (pageInput == nullptr || ++rowsOnPage < pageSize) return true;
+
+    rowsOnPage = 0;
+    text("-- ").number(rowCount).text(" shown. Press Enter for more, or q to stop: ");
+    flush();
+    string answer;
+    if (!getline(*pageInput, answer) || (!answer.empty() && (answer[0] == 'q' || answer[0] == 'Q'))) {
+        stopped = true;
+    }
+    return !stopped;
+}
+
+bool ConsoleRenderer::isStopped() const {
+    return stopped;
+}
+
+long long ConsoleRenderer::getRowCount() const {
+    return rowCount;
+}
@@ -0,0 +1,59 @@
+#ifndef CONSOLERENDERER_H
+#define CONSOLERENDERER_H
+
+#include <iostream>
+#include <string>
+using namespace std;
+
+class Date;
+
+/**
+ * Buffered writer for long console listings.
+ * Text and numbers are formatted straight into one reusable buffer that is
+ * written out in large chunks, instead of one stream call (and, with endl,
+ * one flush) per field. Rows stream through the buffer, so memory use does
+ * not grow with the length of the listing. With a page size set, endRow()
+ * pauses every N rows and lets the reader stop the listing early.
+ */
+class ConsoleRenderer {
+private:
+    static const int BUFFER_SIZE = 1 << 16;
+
+    ostream& out;
+    char* buffer;
+    int used;
+
+    istream* pageInput;     // where "more?" answers are read, nullptr = no paging
+    int pageSize;
+    int rowsOnPage;
+    long long rowCount;
+    bool stopped;
+
+    void reserve(int bytes);
+
+public:
+    ConsoleRenderer(ostream& output = cout);
+    ~ConsoleRenderer();
+
+    ConsoleRenderer(const ConsoleRenderer&) = delete;
+    ConsoleRenderer& operator=(const ConsoleRenderer&) = delete;
+
+    ConsoleRenderer& text(const char* value);
+    ConsoleRenderer& text(const string& value);
+    ConsoleRenderer& ch(char value);
+    ConsoleRenderer& number(long long value);
+    ConsoleRenderer& date(const Date& value);               // YYYY-MM-DD, nothing if empty
+    ConsoleRenderer& repeat(char value, int times);
+    ConsoleRenderer& column(const string& value, int width);  // left-aligned, space padded
+    ConsoleRenderer& newline();
+
+    // Paging: pause after every 'rows' rows (0 turns paging off)
+    void setPageSize(int rows, istream& input = cin);
+    bool endRow();          // false once the reader has asked to stop
+    bool isStopped() const;
+    long long getRowCount() const;
+
+    void flush();
+};
+
+#endif
@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Packed Dates: A date is a single day number, so comparisons and date
+ * arithmetic are integer operations instead of string parsing.
+ * - Tolerant Parsing: Accepts both the old unpadded "2026-2-8" form and the
+ * zero-padded "2026-02-08" form written from now on.
+ * - Sortable Text: Saved dates are zero-padded so they also sort as text.
+ *****************************************************************************/
+
+#include "Date.h"
+#include <ctime>
+#include <sstream>
+using namespace std;
+
+// Civil calendar <-> day number conversions (proleptic Gregorian calendar)
+
+static int daysFromCivil(int y, int m, int d) {
+    y -= m <= 2 ? 1 : 0;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static void civilFromDays(int z, int& y, int& m, int& d) {
+    z += 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp + (mp < 10 ? 3 : -9);
+    y = yoe + era * 400 + (m <= 2 ? 1 : 0);
+}
+
+static bool isLeapYear(int y) {
+    return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+}
+
+static int daysInMonth(int y, int m) {
+    static const int lengths[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return (m == 2 && isLeapYear(y)) ? 29 : lengths[m - 1];
+}
+
+Date::Date() {
+    days = EMPTY;
+}
+
+/**
+ * @param year Full year (e.g. 2026).
+ * @param month 1-12.
+ * @param day 1-31; out-of-range values give an empty date.
+ */
+Date::Date(int year, int month, int day) {
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        days = EMPTY;
+        return;
+    }
+    days = daysFromCivil(year, month, day);
+}
+
+Date Date::fromDays(int dayNumber) {
+    Date date;
+    date.days = dayNumber;
+    return date;
+}
+
+/**
+ * Parses "Y-M-D" with or without zero padding; surrounding spaces are ignored.
+ * @return The date, or an empty date for blank or malformed text.
+ */
+Date Date::parse(const string& text) {
+    int parts[3] = { 0, 0, 0 };
+    int digits[3] = { 0, 0, 0 };
+    int part = 0;
+    for (char c : text) {
+        if (c >= '0' && c <= '9') {
+            if (digits[part] >= 9) return Date();
+            parts[part] = parts[part] * 10 + (c - '0');
+            digits[part]++;
+        }
+        else if (c == '-' && part < 2 && digits[part] > 0) part++;
+        else if (c != ' ' && c != '\t' && c != '\r') return Date();
+    }
+    if (part != 2 || digits[2] == 0) return Date();
+    return Date(parts[0], parts[1], parts[2]);
+}
+
+/** @return Today's local date. */
+Date Date::today() {
+    time_t now = time(0);
+    tm timeinfo;
+    localtime_s(&timeinfo, &now);
+    return Date(1900 + timeinfo.tm_year, timeinfo.tm_mon + 1, timeinfo.tm_mday);
+}
+
+int Date::getYear() const {
+    int y, m, d;
+    civilFromDays(days, y, m, d);
+    return y;
+}
+
+int Date::getMonth() const {
+    int y, m, d;
+    civilFromDays(days, y, m, d);
+    return m;
+}
+
+int Date::getDay() const {
+    int y, m, d;
+    civilFromDays(days, y, m, d);
+    return d;
+}
+
+/** @return The date count days later (earlier if negative); empty stays empty. */
+Date Date::addDays(int count) const {
+    if (isEmpty()) return *this;
+    return fromDays(days + count);
+}
+
+/** @return Number of days from this date to later (negative if later is earlier). */
+int Date::daysUntil(const Date& later) const {
+    return later.days - days;
+}
+
+string Date::toString() const {
+    if (isEmpty()) return "";
+    int y, m, d;
+    civilFromDays(days, y, m, d);
+    stringstream ss;
+    ss << y << "-" << (m < 10 ? "0" : "") << m << "-" << (d < 10 ? "0" : "") << d;
+    return ss.str();
+}
+
+int Date::toKey() const {
+    if (isEmpty()) return 0;
+    int y, m, d;
+    civilFromDays(days, y, m, d);
+    return y * 10000 + m * 100 + d;
+}
+
+Date Date::fromKey(int key) {
+    if (key == 0) return Date();
+    return Date(key / 10000, key / 100 % 100, key % 100);
+}
+
+ostream& operator<<(ostream& out, const Date& date) {
+    return out << date.toString();
+}
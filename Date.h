@@ -0,0 +1,51 @@
+#ifndef DATE_H
+#define DATE_H
+
+#include <climits>
+#include <ostream>
+#include <string>
+using namespace std;
+
+/**
+ * Calendar date packed into one int (days since 1970-01-01).
+ * Dates compare, sort and subtract as plain integers; text is only produced
+ * when printing or saving. A default-constructed Date is empty, which is how
+ * "not returned yet" is represented.
+ */
+class Date {
+private:
+    static const int EMPTY = INT_MIN;
+    int days;
+
+public:
+    Date();
+    Date(int year, int month, int day);
+
+    static Date fromDays(int dayNumber);
+    static Date parse(const string& text);   // "Y-M-D", zero padding optional
+    static Date today();
+
+    bool isEmpty() const { return days == EMPTY; }
+    int getDays() const { return days; }
+    int getYear() const;
+    int getMonth() const;
+    int getDay() const;
+
+    Date addDays(int count) const;
+    int daysUntil(const Date& later) const;
+
+    string toString() const;                 // "YYYY-MM-DD", "" when empty
+    int toKey() const;                       // yyyymmdd, 0 when empty
+    static Date fromKey(int key);
+
+    bool operator==(const Date& other) const { return days == other.days; }
+    bool operator!=(const Date& other) const { return days != other.days; }
+    bool operator<(const Date& other) const { return days < other.days; }
+    bool operator<=(const Date& other) const { return days <= other.days; }
+    bool operator>(const Date& other) const { return days > other.days; }
+    bool operator>=(const Date& other) const { return days >= other.days; }
+};
+
+ostream& operator<<(ostream& out, const Date& date);
+
+#endif
@@ -8,26 +8,41 @@
  * - Persistence: Custom non-STL CSV serialization/deserialization logic.
  * - Dynamic Memory Management: Deep copy implementation for BST nodes during
  * object duplication and assignment.
+ * - Hot/Cold Layout: Player counts, year and copies are packed with a pointer
+ * to the title, ID and reviews into a 16-byte record, so scans over many
+ * games touch a quarter of a cache line each.
+ * - Buffered Display: Details and reviews are formatted into a shared
+ * ConsoleRenderer, so listing many games does not flush after every line.
  *****************************************************************************/
 
 #include "Game.h"
-#include <iostream>
+#include "ConsoleRenderer.h"
+#include "MemoryFootprint.h"
 
 using namespace std;
 
+// Clamps a value into the range of a packed field
+static int clampTo(int value, int low, int high) {
+    return (value < low) ? low : (value > high) ? high : value;
+}
+
 /**
  * Default Constructor.
  * Initializes an empty Game object with null/zero values.
  */
 Game::Game() {
-    gameID = ""; title = "";
-    minPlayers = maxPlayers = year = 0;
+    details = new GameDetails();
+    details->reviewRoot = nullptr;
+    details->ratingTotal = details->reviewCount = 0;
+    details->minPlayTime = details->maxPlayTime = 0;
+    minPlayers = maxPlayers = 0;
+    year = 0;
     totalCopies = availableCopies = 0;
-    reviewRoot = nullptr;
 }
 
 /**
  * Parameterized Constructor.
+ * Numeric fields are clamped to the ranges of the packed hot record.
  * @param id Unique Game ID.
  * @param t Title of the board game.
  * @param minP Minimum players.
@@ -37,28 +52,32 @@ Game::Game() {
  * @param avail Currently available copies.
  */
 Game::Game(string id, string t, int minP, int maxP, int y, int total, int avail) {
-    gameID = id; title = t;
-    minPlayers = minP; maxPlayers = maxP;
-    year = y;
-    totalCopies = total;
-    availableCopies = avail;
-    reviewRoot = nullptr;
+    details = new GameDetails();
+    details->gameID = id;
+    details->title = t;
+    details->reviewRoot = nullptr;
+    details->ratingTotal = details->reviewCount = 0;
+    details->minPlayTime = details->maxPlayTime = 0;
+    minPlayers = (unsigned char)clampTo(minP, 0, 255);
+    maxPlayers = (unsigned char)clampTo(maxP, 0, 255);
+    year = (short)clampTo(y, -32767, 32767);
+    totalCopies = (unsigned short)clampTo(total, 0, 65535);
+    availableCopies = (unsigned short)clampTo(avail, 0, 65535);
 }
 
 /**
  * Copy Constructor (Deep Copy).
- * Ensures that when a Game object is copied, a new BST of reviews is
- * created rather than sharing a pointer to the original tree.
+ * Ensures that when a Game object is copied, new details and a new BST of
+ * reviews are created rather than sharing pointers with the original.
  */
 Game::Game(const Game& other) {
-    gameID = other.gameID;
-    title = other.title;
+    details = new GameDetails(*other.details);
+    details->reviewRoot = copyTree(other.details->reviewRoot);
     minPlayers = other.minPlayers;
     maxPlayers = other.maxPlayers;
     year = other.year;
     totalCopies = other.totalCopies;
     availableCopies = other.availableCopies;
-    reviewRoot = copyTree(other.reviewRoot);
 }
 
 /**
@@ -68,26 +87,26 @@ Game::Game(const Game& other) {
 Game& Game::operator=(const Game& other) {
     if (this == &other) return *this;
 
-    clearTree(reviewRoot);
+    clearTree(details->reviewRoot);
 
-    gameID = other.gameID;
-    title = other.title;
+    *details = *other.details;
+    details->reviewRoot = copyTree(other.details->reviewRoot);
     minPlayers = other.minPlayers;
     maxPlayers = other.maxPlayers;
     year = other.year;
     totalCopies = other.totalCopies;
     availableCopies = other.availableCopies;
-    reviewRoot = copyTree(other.reviewRoot);
 
     return *this;
 }
 
 /**
  * Destructor.
- * Triggers a recursive cleanup of the review BST to prevent memory leaks.
+ * Triggers a recursive cleanup of the review BST and frees the details.
  */
 Game::~Game() {
-    clearTree(reviewRoot);
+    clearTree(details->reviewRoot);
+    delete details;
 }
 
 // --- BST LOGIC ---
@@ -117,7 +136,7 @@ ReviewNode* Game::copyTree(ReviewNode* node) const {
  */
 ReviewNode* Game::insertRecursive(ReviewNode* node, string name, string comm, int rate) {
     if (node == nullptr) {
-        return new ReviewNode(gameID, name, comm, rate);
+        return new ReviewNode(details->gameID, name, comm, rate);
     }
     if (rate < node->rating)
         node->left = insertRecursive(node->left, name, comm, rate);
@@ -130,11 +149,11 @@ ReviewNode* Game::insertRecursive(ReviewNode* node, string name, string comm, in
  * Performs an In-Order traversal to print reviews sorted by rating (Ascending).
  * @param node The current node being visited.
  */
-void Game::printInOrder(ReviewNode* node) const {
+void Game::renderInOrder(ConsoleRenderer& out, ReviewNode* node) const {
     if (node == nullptr) return;
-    printInOrder(node->left);
-    cout << "    [" << node->rating << "/5] " << node->memberName << ": " << node->comment << endl;
-    printInOrder(node->right);
+    renderInOrder(out, node->left);
+    out.text("    [").number(node->rating).text("/5] ").text(node->memberName).text(": ").text(node->comment).newline();
+    renderInOrder(out, node->right);
 }
 
 /**
@@ -148,6 +167,13 @@ void Game::clearTree(ReviewNode* node) {
     delete node;
 }
 
+/** Heap bytes of a review subtree (nodes and their out-of-line strings). */
+size_t Game::treeBytes(ReviewNode* node) const {
+    if (node == nullptr) return 0;
+    return sizeof(ReviewNode) + stringHeapBytes(node->gameID) + stringHeapBytes(node->memberName) +
+           stringHeapBytes(node->comment) + treeBytes(node->left) + treeBytes(node->right);
+}
+
 // --- PERSISTENCE LOGIC ---
 
 /**
@@ -155,10 +181,10 @@ void Game::clearTree(ReviewNode* node) {
  * Pre-order is used so that when the file is read, the tree is rebuilt
  * with the same root and structure as before.
  */
-void Game::saveReviewsRecursive(ofstream& file, ReviewNode* node) const {
+void Game::saveReviewsRecursive(ostream& file, ReviewNode* node) const {
     if (node == nullptr) return;
 
-    file << gameID << "," << node->memberName << ","
+    file << details->gameID << "," << node->memberName << ","
         << node->rating << ",\"" << node->comment << "\"\n";
 
     saveReviewsRecursive(file, node->left);
@@ -168,9 +194,9 @@ void Game::saveReviewsRecursive(ofstream& file, ReviewNode* node) const {
 /**
  * Interface function to initiate saving the review tree to a file stream.
  */
-void Game::saveReviews(ofstream& file) const {
-    if (reviewRoot != nullptr) {
-        saveReviewsRecursive(file, reviewRoot);
+void Game::saveReviews(ostream& file) const {
+    if (details->reviewRoot != nullptr) {
+        saveReviewsRecursive(file, details->reviewRoot);
     }
 }
 
@@ -178,42 +204,92 @@ void Game::saveReviews(ofstream& file) const {
 
 /** Adds a new review to the game's internal BST. */
 void Game::addReview(string name, string comm, int rate) {
-    reviewRoot = insertRecursive(reviewRoot, name, comm, rate);
+    details->reviewRoot = insertRecursive(details->reviewRoot, name, comm, rate);
+    details->ratingTotal += rate;
+    details->reviewCount++;
+}
+
+/**
+ * Checks whether an identical review is already in the BST.
+ * Only the subtree matching the rating's ordering needs to be searched.
+ */
+bool Game::hasReview(const string& name, const string& comm, int rate) const {
+    ReviewNode* node = details->reviewRoot;
+    while (node != nullptr) {
+        if (node->rating == rate && node->memberName == name && node->comment == comm) return true;
+        node = (rate < node->rating) ? node->left : node->right;
+    }
+    return false;
 }
 
 /** Displays all reviews for this game, sorted by rating score. */
 void Game::displayReviews() const {
-    if (reviewRoot == nullptr) cout << "   (No reviews yet)\n";
-    else printInOrder(reviewRoot);
+    ConsoleRenderer out;
+    if (details->reviewRoot == nullptr) out.text("   (No reviews yet)\n");
+    else renderInOrder(out, details->reviewRoot);
 }
 
 // --- GETTERS ---
-string Game::getGameID() const { return gameID; }
-string Game::getTitle() const { return title; }
+const string& Game::getGameID() const { return details->gameID; }
+const string& Game::getTitle() const { return details->title; }
 int Game::getMinPlayers() const { return minPlayers; }
 int Game::getMaxPlayers() const { return maxPlayers; }
 int Game::getYear() const { return year; }
 int Game::getTotalCopies() const { return totalCopies; }
 int Game::getAvailableCopies() const { return availableCopies; }
+int Game::getReviewCount() const { return details->reviewCount; }
+int Game::getMinPlayTime() const { return details->minPlayTime; }
+int Game::getMaxPlayTime() const { return details->maxPlayTime; }
+
+/** @return Mean review rating, kept as a running total (0 if there are no reviews). */
+double Game::getAverageRating() const {
+    return (details->reviewCount == 0) ? 0.0 : (double)details->ratingTotal / details->reviewCount;
+}
+
+/** @return Heap bytes owned through the details record (excluding the 16-byte hot record). */
+size_t Game::detailBytes() const {
+    return sizeof(GameDetails) + stringHeapBytes(details->gameID) + stringHeapBytes(details->title) +
+           treeBytes(details->reviewRoot);
+}
 
 // --- SETTERS / UPDATERS ---
-void Game::setAvailableCopies(int avail) { availableCopies = avail; }
+void Game::setAvailableCopies(int avail) { availableCopies = (unsigned short)clampTo(avail, 0, 65535); }
+void Game::setPlayTime(int minMinutes, int maxMinutes) {
+    details->minPlayTime = minMinutes;
+    details->maxPlayTime = maxMinutes;
+}
 void Game::incrementAvailable() { if (availableCopies < totalCopies) availableCopies++; }
 void Game::decrementAvailable() { if (availableCopies > 0) availableCopies--; }
 
 /** Prints full game details, including inventory status and all reviews. */
 void Game::print() const {
-    cout << "ID: " << gameID << " | Title: " << title << endl;
-    cout << "Players: " << minPlayers << "-" << maxPlayers << " | Year: " << year << endl;
-    cout << "Stock: " << availableCopies << "/" << totalCopies << endl;
-    cout << "Reviews:" << endl;
-    displayReviews();
-    cout << "-------------------------------" << endl;
+    ConsoleRenderer out;
+    render(out, true);
 }
 
 /** Prints game details without reviews (for search results display). */
 void Game::printWithoutReviews() const {
-    cout << "ID: " << gameID << " | Title: " << title << endl;
-    cout << "Players: " << minPlayers << "-" << maxPlayers << " | Year: " << year << endl;
-    cout << "Stock: " << availableCopies << "/" << totalCopies << endl;
+    ConsoleRenderer out;
+    render(out, false);
+}
+
+/**
+ * Formats the game's details (and optionally its reviews) into a renderer,
+ * so listings of many games share one output buffer.
+ */
+void Game::render(ConsoleRenderer& out, bool withReviews) const {
+    out.text("ID: ").text(details->gameID).text(" | Title: ").text(details->title).newline();
+    out.text("Players: ").number(minPlayers).ch('-').number(maxPlayers).text(" | Year: ").number(year);
+    if (details->maxPlayTime > 0) {
+        out.text(" | Time: ");
+        if (details->minPlayTime > 0 && details->minPlayTime < details->maxPlayTime) out.number(details->minPlayTime).ch('-');
+        out.number(details->maxPlayTime).text(" min");
+    }
+    out.newline();
+    out.text("Stock: ").number(availableCopies).ch('/').number(totalCopies).newline();
+    if (!withReviews) return;
+    out.text("Reviews:").newline();
+    if (details->reviewRoot == nullptr) out.text("   (No reviews yet)\n");
+    else renderInOrder(out, details->reviewRoot);
+    out.text("-------------------------------").newline();
 }
\ No newline at end of file
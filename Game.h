@@ -4,6 +4,8 @@
 #include <string>
 #include <fstream>
 
+class ConsoleRenderer;
+
 using namespace std;
 
 struct ReviewNode {
@@ -20,28 +22,44 @@ struct ReviewNode {
     }
 };
 
-class Game {
-private:
+// Rarely scanned parts of a game: text, reviews, rating totals and play time
+struct GameDetails {
     string gameID;
     string title;
-    int minPlayers;
-    int maxPlayers;
-    int year;
-    int totalCopies;
-    int availableCopies;
-
     ReviewNode* reviewRoot;
+    int ratingTotal;    // running sum of review ratings, for the average
+    int reviewCount;
+    int minPlayTime;    // minutes, 0 if unknown
+    int maxPlayTime;
+};
+
+/**
+ * A board game, split into a packed hot record and a cold GameDetails record.
+ * The fields filters and availability checks read on every scan (players,
+ * year, copies) use small integer types and sit next to the pointer to the
+ * details, so a Game is 16 bytes and four fit in a cache line. Player counts
+ * are capped at 255, years at +/-32767 and copies at 65535.
+ */
+class Game {
+private:
+    GameDetails* details;
+    short year;
+    unsigned short totalCopies;
+    unsigned short availableCopies;
+    unsigned char minPlayers;
+    unsigned char maxPlayers;
 
     // Private Recursive Helpers for BST
     ReviewNode* insertRecursive(ReviewNode* node, string name, string comm, int rate);
-    void printInOrder(ReviewNode* node) const;
+    void renderInOrder(ConsoleRenderer& out, ReviewNode* node) const;
     void clearTree(ReviewNode* node);
     
     // Helper to deep copy BST
     ReviewNode* copyTree(ReviewNode* node) const;
+    size_t treeBytes(ReviewNode* node) const;
 
     // Recursive Helper for saving to CSV
-    void saveReviewsRecursive(ofstream& file, ReviewNode* node) const;
+    void saveReviewsRecursive(ostream& file, ReviewNode* node) const;
 
 public:
     Game();
@@ -51,28 +69,40 @@ public:
     ~Game();
 
     // Getters
-    string getGameID() const;
-    string getTitle() const;
+    const string& getGameID() const;
+    const string& getTitle() const;
     int getMinPlayers() const;
     int getMaxPlayers() const;
     int getYear() const;
     int getTotalCopies() const;
     int getAvailableCopies() const;
+    int getReviewCount() const;
+    int getMinPlayTime() const;
+    int getMaxPlayTime() const;
+    double getAverageRating() const;
+
+    // Approximate heap bytes owned by this game (details, strings, reviews)
+    size_t detailBytes() const;
 
     // Setters
     void setAvailableCopies(int avail);
+    void setPlayTime(int minMinutes, int maxMinutes);
     void incrementAvailable();
     void decrementAvailable();
 
     void print() const;
     void printWithoutReviews() const;  // New method for search results
+    void render(ConsoleRenderer& out, bool withReviews) const;
 
     // Review Interface
     void addReview(string name, string comm, int rate);
     void displayReviews() const;
+    bool hasReview(const string& name, const string& comm, int rate) const;
 
     //File Persistence Interface
-    void saveReviews(ofstream& file) const;
+    void saveReviews(ostream& file) const;
 };
 
+static_assert(sizeof(Game) <= 16, "Game's hot record must stay within 16 bytes");
+
 #endif
\ No newline at end of file
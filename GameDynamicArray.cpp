@@ -4,16 +4,42 @@
  * Student IDs: S10267643, S10267163
  * Highlighted Features:
  * - Dynamic Memory Management: Manages a heap-allocated array of pointers to
- * Game objects, allowing for polymorphic behavior if extended.
+ * Game objects, which are constructed in place in fixed blocks of slots so
+ * their packed hot records are contiguous and never move.
+ * - Memory Footprint: Reports the bytes held by each catalog structure, to
+ * check bytes per game as the catalog grows.
  * - Deep Copy Addition: Uses the Game copy constructor when adding elements
  * to ensure the BST and other internal structures are properly duplicated.
- * - Optimized Removal: Implements element shifting to maintain a contiguous
- * array, ensuring search operations remain consistent.
+ * - Generational Slot Map: Games keep their slot for life; removal swaps the
+ * last game into the gap and recycles the slot through a free list, so add,
+ * remove and lookup by ID are all O(1), and stale handles are detected.
+ * - Collision-Free IDs: New game IDs continue after the highest ID ever seen,
+ * so removing a game never makes its ID (or a live one) available again.
+ * - Fuzzy Title Search: A lazily built TitleIndex answers typo-tolerant
+ * searches and is updated on every add and removal afterwards.
+ * - Title Autocomplete: A radix trie of normalized titles lists the titles
+ * starting with a typed prefix without scanning the catalog.
+ * - Compound Queries: Filters on players, year, title, availability and
+ * rating are planned and evaluated by a QueryEngine over this catalog.
+ * - Result Cache: Repeated queries are served from a versioned LRU cache of
+ * game handles; version counters make stale entries detectable in O(1).
+ * - Published Snapshots: After every change a read-only version of the catalog
+ * is published to CatalogVersions, so other threads read it without locks.
  *****************************************************************************/
 
 #include "GameDynamicArray.h"
+#include "TitleIndex.h"
+#include "TitleTrie.h"
+#include "QueryEngine.h"
+#include "QueryCache.h"
+#include "ConsoleRenderer.h"
+#include "MemoryFootprint.h"
+#include "CatalogSnapshot.h"
 #include <iostream>
 #include <cassert>
+#include <cctype>
+#include <cstdlib>
+#include <new>
 
 using namespace std;
 
@@ -25,7 +51,23 @@ GameDynamicArray::GameDynamicArray() {
     capacity = 10;
     count = 0;
     data = new Game * [capacity];
+    dataSlot = new int[capacity];
     for (int i = 0; i < capacity; ++i) data[i] = nullptr;
+
+    slotCapacity = 10;
+    slotCount = 0;
+    freeHead = -1;
+    slots = new Slot[slotCapacity];
+
+    highestIdNumber = 0;
+    titleIndex = nullptr;
+    titlePrefixes = nullptr;
+    queryEngine = nullptr;
+    queryCache = new QueryCache();
+    threadPool = nullptr;
+    snapshots = nullptr;
+    bulkAdding = false;
+    catalogVersion = availabilityVersion = 0;
 }
 
 /**
@@ -34,13 +76,27 @@ GameDynamicArray::GameDynamicArray() {
  */
 GameDynamicArray::~GameDynamicArray() {
     for (int i = 0; i < count; i++) {
-        delete data[i]; // free each allocated Game object
+        data[i]->~Game(); // destroy each game in place; the blocks are freed below
         data[i] = nullptr;
     }
+    for (int b = 0; b < (int)blocks.size(); b++) ::operator delete(blocks[b]);
+    blocks.clear();
     delete[] data;
+    delete[] dataSlot;
+    delete[] slots;
     data = nullptr;
+    dataSlot = nullptr;
+    slots = nullptr;
     capacity = 0;
     count = 0;
+    delete titleIndex;
+    titleIndex = nullptr;
+    delete titlePrefixes;
+    titlePrefixes = nullptr;
+    delete queryEngine;
+    queryEngine = nullptr;
+    delete queryCache;
+    queryCache = nullptr;
 }
 
 /**
@@ -50,17 +106,52 @@ GameDynamicArray::~GameDynamicArray() {
 void GameDynamicArray::resize() {
     int newCapacity = (capacity > 0) ? capacity * 2 : 10;
     Game** newData = new Game * [newCapacity];
+    int* newDataSlot = new int[newCapacity];
     for (int i = 0; i < newCapacity; ++i) newData[i] = nullptr;
 
     for (int i = 0; i < count; i++) {
         newData[i] = data[i];
+        newDataSlot[i] = dataSlot[i];
     }
 
     delete[] data;
+    delete[] dataSlot;
     data = newData;
+    dataSlot = newDataSlot;
     capacity = newCapacity;
 }
 
+/** @return Where the game of a slot is (or will be) constructed. */
+Game* GameDynamicArray::storageFor(int slot) const {
+    return blocks[slot / GAMES_PER_BLOCK] + slot % GAMES_PER_BLOCK;
+}
+
+/**
+ * Takes a slot from the free list, or a fresh one (doubling the slot array
+ * when it is full, and adding a storage block every GAMES_PER_BLOCK slots).
+ * @return Index of an unused slot.
+ */
+int GameDynamicArray::allocateSlot() {
+    if (freeHead != -1) {
+        int slot = freeHead;
+        freeHead = slots[slot].nextFree;
+        return slot;
+    }
+    if (slotCount >= slotCapacity) {
+        int newCapacity = slotCapacity * 2;
+        Slot* newSlots = new Slot[newCapacity];
+        for (int i = 0; i < slotCount; i++) newSlots[i] = slots[i];
+        delete[] slots;
+        slots = newSlots;
+        slotCapacity = newCapacity;
+    }
+    if (slotCount % GAMES_PER_BLOCK == 0) {
+        blocks.push_back(static_cast<Game*>(::operator new(sizeof(Game) * GAMES_PER_BLOCK)));
+    }
+    slots[slotCount].generation = 0;
+    return slotCount++;
+}
+
 /** @return The current number of elements in the array. */
 int GameDynamicArray::size() const {
     return count;
@@ -102,31 +193,59 @@ Game* GameDynamicArray::getPtr(int index) {
     return data[index];
 }
 
+/** Numeric part of an ID like "G042" (0 if it has none). */
+static int idNumber(const string& gameID) {
+    size_t digits = gameID.size();
+    while (digits > 0 && isdigit((unsigned char)gameID[digits - 1])) digits--;
+    return (digits < gameID.size()) ? atoi(gameID.c_str() + digits) : 0;
+}
+
 /**
- * Adds a copy of a Game object to the array.
+ * Adds a copy of a Game object to the catalog.
  * Triggers resize() if necessary and allocates the Game on the heap.
  * @param g The Game object to duplicate and add.
+ * @return Handle to the stored game, or slot -1 if its ID is already taken.
+ * Time Complexity: O(1) amortized
  */
-void GameDynamicArray::add(const Game& g) {
+GameDynamicArray::Handle GameDynamicArray::add(const Game& g) {
+    Handle handle = { -1, 0 };
+    if (idSlots.count(g.getGameID())) return handle;
+
     if (count >= capacity) {
         resize();
     }
-    data[count] = new Game(g); // allocate a new Game on the heap
+    int slot = allocateSlot();
+    slots[slot].game = new (storageFor(slot)) Game(g); // deep copy into the slot's storage
+    slots[slot].position = count;
+    data[count] = slots[slot].game;
+    dataSlot[count] = slot;
+    idSlots[g.getGameID()] = slot;
+
+    int number = idNumber(g.getGameID());
+    if (number > highestIdNumber) highestIdNumber = number;
+
+    if (titleIndex != nullptr) titleIndex->add(data[count]);
+    if (titlePrefixes != nullptr) titlePrefixes->insert(data[count]);
+    if (queryEngine != nullptr) queryEngine->markStale();
+    catalogVersion++;
     ++count;
+    noteSnapshotChange(count - 1);
+    publishSnapshot();
+
+    handle.slot = slot;
+    handle.generation = slots[slot].generation;
+    return handle;
 }
 
 /**
- * Linear search for a game's index by its unique ID.
+ * Finds a game's position in iteration order by its unique ID.
  * @param gameID The string ID to search for.
  * @return The index if found, -1 otherwise.
+ * Time Complexity: O(1) average
  */
 int GameDynamicArray::findIndexByGameID(const string& gameID) const {
-    for (int i = 0; i < count; i++) {
-        if (data[i] != nullptr && data[i]->getGameID() == gameID) {
-            return i;
-        }
-    }
-    return -1;
+    unordered_map<string, int>::const_iterator it = idSlots.find(gameID);
+    return (it == idSlots.end()) ? -1 : slots[it->second].position;
 }
 
 /**
@@ -143,36 +262,299 @@ Game* GameDynamicArray::findByGameID(const string& gameID) {
 }
 
 /**
- * Removes a game from the array and shifts remaining elements to fill the gap.
+ * Removes a game: the last game in iteration order moves into its place and
+ * its slot goes back on the free list with a new generation.
  * Frees the memory of the removed Game object.
  * @param gameID The string ID of the game to delete.
  * @return True if successful, false if the ID was not found.
+ * Time Complexity: O(1) average
  */
 bool GameDynamicArray::removeByGameID(const string& gameID) {
-    int index = findIndexByGameID(gameID);
-    if (index == -1) {
+    unordered_map<string, int>::iterator it = idSlots.find(gameID);
+    if (it == idSlots.end()) {
         return false;
     }
+    int slot = it->second;
+    int index = slots[slot].position;
+    idSlots.erase(it);
+    if (snapshots != nullptr) snapshotChanges.removedIDs.push_back(gameID);
 
-    delete data[index];
-    data[index] = nullptr;
+    if (titleIndex != nullptr) titleIndex->remove(data[index]);
+    if (titlePrefixes != nullptr) titlePrefixes->remove(data[index]);
+    if (queryEngine != nullptr) queryEngine->markStale();
+    catalogVersion++;
+    data[index]->~Game();
 
-    for (int i = index; i < count - 1; i++) {
-        data[i] = data[i + 1];
-    }
-    data[count - 1] = nullptr;
+    int last = count - 1;
+    data[index] = data[last];
+    dataSlot[index] = dataSlot[last];
+    slots[dataSlot[index]].position = index;
+    data[last] = nullptr;
     --count;
+
+    slots[slot].game = nullptr;
+    slots[slot].generation++;       // invalidates every outstanding handle
+    slots[slot].nextFree = freeHead;
+    freeHead = slot;
+    noteSnapshotChange(index);      // the last game moved into the hole
+    publishSnapshot();
     return true;
 }
 
+/** @return A handle to the game at an index that stays valid until it is removed. */
+GameDynamicArray::Handle GameDynamicArray::getHandle(int index) const {
+    assert(index >= 0 && index < count);
+    Handle handle = { dataSlot[index], slots[dataSlot[index]].generation };
+    return handle;
+}
+
+/** @return A handle to a game in this catalog (slot -1 if it is not one). */
+GameDynamicArray::Handle GameDynamicArray::handleOf(const Game* game) const {
+    Handle handle = { -1, 0 };
+    unordered_map<string, int>::const_iterator it = idSlots.find(game->getGameID());
+    if (it != idSlots.end() && slots[it->second].game == game) {
+        handle.slot = it->second;
+        handle.generation = slots[it->second].generation;
+    }
+    return handle;
+}
+
+/**
+ * @return The game a handle refers to, or nullptr if that game has since
+ * been removed (even if its slot now holds another game).
+ */
+Game* GameDynamicArray::resolve(const Handle& handle) {
+    if (handle.slot < 0 || handle.slot >= slotCount) return nullptr;
+    if (slots[handle.slot].generation != handle.generation) return nullptr;
+    return slots[handle.slot].game;
+}
+
+/** Swaps two games in iteration order; their slots, IDs and handles stay put. */
+void GameDynamicArray::swapPositions(int a, int b) {
+    assert(a >= 0 && a < count && b >= 0 && b < count);
+    Game* tempGame = data[a];
+    data[a] = data[b];
+    data[b] = tempGame;
+    int tempSlot = dataSlot[a];
+    dataSlot[a] = dataSlot[b];
+    dataSlot[b] = tempSlot;
+    slots[dataSlot[a]].position = a;
+    slots[dataSlot[b]].position = b;
+    if (queryEngine != nullptr) queryEngine->markStale();
+    noteSnapshotChange(a);
+    noteSnapshotChange(b);
+    publishSnapshot();
+}
+
+/** @return The ID after the highest one ever added (G001 style, zero-padded to 3 digits). */
+string GameDynamicArray::nextGameID() const {
+    int number = highestIdNumber + 1;
+    string id = "G";
+    if (number < 100) id += "0";
+    if (number < 10) id += "0";
+    return id + to_string(number);
+}
+
 /**
  * Iterates through the array and calls the print() method for each valid Game.
  */
 void GameDynamicArray::printAll() const {
+    ConsoleRenderer out;
     for (int i = 0; i < count; i++) {
         if (data[i] != nullptr) {
-            data[i]->print();
-            cout << "----------------------\n";
+            data[i]->render(out, true);
+            out.text("----------------------\n");
         }
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Searches titles allowing small typos ("Catann", "Wonder Duel"); a query
+ * word also matches any title word it is a prefix of.
+ * @param query Text typed by the user.
+ * @param maxResults Upper bound on the number of games returned.
+ * @param out Receives matching games, best matches first.
+ */
+void GameDynamicArray::searchTitles(const string& query, int maxResults, vector<Game*>& out) {
+    if (titleIndex == nullptr) {
+        titleIndex = new TitleIndex();
+        for (int i = 0; i < count; i++) titleIndex->add(data[i]);
+    }
+
+    vector<TitleIndex::Match> matches;
+    titleIndex->search(query, maxResults, matches);
+    for (int i = 0; i < (int)matches.size(); i++) out.push_back(matches[i].game);
+}
+
+/**
+ * Starts a bulk load: the title index and trie are discarded so the adds
+ * that follow do not maintain them one game at a time.
+ */
+void GameDynamicArray::beginBulkAdd() {
+    bulkAdding = true;
+    delete titleIndex;
+    titleIndex = nullptr;
+    delete titlePrefixes;
+    titlePrefixes = nullptr;
+}
+
+/**
+ * Ends a bulk load with a single rebuild of the title trie and a single
+ * snapshot publication. The fuzzy index and the query indexes rebuild
+ * themselves on their next use.
+ */
+void GameDynamicArray::endBulkAdd() {
+    buildTitlePrefixes();
+    bulkAdding = false;
+    publishSnapshot();
+}
+
+/**
+ * Builds the title trie from the current catalog (called once the CSV is
+ * loaded); later adds and removals keep it up to date.
+ */
+void GameDynamicArray::buildTitlePrefixes() {
+    delete titlePrefixes;
+    titlePrefixes = new TitleTrie();
+    for (int i = 0; i < count; i++) titlePrefixes->insert(data[i]);
+}
+
+/**
+ * Lists games whose title starts with the given text, ignoring case and
+ * punctuation ("7 wonders d" -> "7 Wonders: Duel").
+ * @param prefix Start of a title typed by the user.
+ * @param maxResults Upper bound on the number of games returned.
+ * @param out Receives matching games in alphabetical order.
+ */
+void GameDynamicArray::completeTitles(const string& prefix, int maxResults, vector<Game*>& out) {
+    if (titlePrefixes == nullptr) buildTitlePrefixes();
+    titlePrefixes->complete(prefix, maxResults, out);
+}
+
+/**
+ * Runs a compound query (filters, ordering, page) over the catalog.
+ * @param query Predicates and presentation options.
+ * @param result Receives the requested page and the total match count.
+ */
+void GameDynamicArray::runQuery(const GameQuery& query, QueryResult& result) {
+    string key = QueryCache::keyFor(query);
+    const QueryCache::Entry* cached = queryCache->find(key, catalogVersion, availabilityVersion);
+    if (cached != nullptr) {
+        result.games.clear();
+        for (int i = 0; i < (int)cached->games.size(); i++) result.games.push_back(resolve(cached->games[i]));
+        result.totalMatches = cached->totalMatches;
+        result.pageCount = cached->pageCount;
+        result.plan = "result cache (" + cached->plan + ")";
+        return;
+    }
+
+    if (queryEngine == nullptr) {
+        queryEngine = new QueryEngine(*this);
+        queryEngine->attachThreadPool(threadPool);
+    }
+    queryEngine->run(query, result);
+
+    QueryCache::Entry entry;
+    entry.games.reserve(result.games.size());
+    for (int i = 0; i < (int)result.games.size(); i++) entry.games.push_back(handleOf(result.games[i]));
+    entry.totalMatches = result.totalMatches;
+    entry.pageCount = result.pageCount;
+    entry.plan = result.plan;
+    queryCache->store(key, QueryCache::readsAvailability(query), catalogVersion, availabilityVersion, entry);
+}
+
+/**
+ * Lets the query engine rebuild its indexes and scan large candidate sets on
+ * a thread pool. Pass nullptr to go back to serial evaluation.
+ */
+void GameDynamicArray::attachThreadPool(ThreadPool* workers) {
+    threadPool = workers;
+    if (queryEngine != nullptr) queryEngine->attachThreadPool(workers);
+}
+
+/**
+ * Starts publishing read-only versions of the catalog, beginning with its
+ * current state. Pass nullptr to stop.
+ */
+void GameDynamicArray::attachSnapshots(CatalogVersions* versions) {
+    snapshots = versions;
+    snapshotChanges.clear();
+    snapshotChanges.rebuild = true;
+    publishSnapshot();
+}
+
+/** @return The attached snapshot publisher, or nullptr. */
+CatalogVersions* GameDynamicArray::getSnapshots() const {
+    return snapshots;
+}
+
+// Publishes the current state unless a bulk load will publish it at its end
+void GameDynamicArray::publishSnapshot() {
+    if (snapshots == nullptr || bulkAdding) return;
+    snapshots->publish(*this, snapshotChanges);
+    snapshotChanges.clear();
+}
+
+// Records a position whose row the next snapshot must copy
+void GameDynamicArray::noteSnapshotChange(int position) {
+    if (snapshots != nullptr) snapshotChanges.positions.push_back(position);
+}
+
+/**
+ * Invalidates cached results that depend on copies or ratings (O(1)) and
+ * publishes a snapshot with the new copies and ratings.
+ * @param changed The game that changed; the snapshot then copies only its
+ * chunk. nullptr makes the snapshot compare every row instead.
+ */
+void GameDynamicArray::markAvailabilityChanged(const Game* changed) {
+    availabilityVersion++;
+    unordered_map<string, int>::const_iterator it =
+        (changed != nullptr) ? idSlots.find(changed->getGameID()) : idSlots.end();
+    if (it != idSlots.end()) noteSnapshotChange(slots[it->second].position);
+    else if (snapshots != nullptr) snapshotChanges.recheckRows = true;
+    publishSnapshot();
+}
+
+/**
+ * Same as above for several games at once (batch borrows, journal replay),
+ * publishing one snapshot for all of them.
+ * @param changedIDs IDs of the games whose copies or ratings changed.
+ */
+void GameDynamicArray::markAvailabilityChanged(const vector<string>& changedIDs) {
+    availabilityVersion++;
+    for (int i = 0; i < (int)changedIDs.size(); i++) {
+        unordered_map<string, int>::const_iterator it = idSlots.find(changedIDs[i]);
+        if (it != idSlots.end()) noteSnapshotChange(slots[it->second].position);
+    }
+    publishSnapshot();
+}
+
+/** @return The query result cache, for its hit/miss statistics. */
+const QueryCache& GameDynamicArray::getQueryCache() const {
+    return *queryCache;
+}
+
+/**
+ * Lists the bytes held by each catalog structure. Search indexes that have
+ * not been built yet report 0.
+ * @param out Receives (structure, approximate bytes) pairs.
+ */
+void GameDynamicArray::memoryFootprint(vector<pair<string, size_t>>& out) const {
+    size_t details = 0;
+    for (int i = 0; i < count; i++) details += data[i]->detailBytes();
+
+    out.push_back(make_pair(string("Game hot records (block storage)"), blocks.size() * GAMES_PER_BLOCK * sizeof(Game)));
+    out.push_back(make_pair(string("Game details (ID, title, reviews)"), details));
+    out.push_back(make_pair(string("Slot map (slots, dense arrays)"),
+        (size_t)slotCapacity * sizeof(Slot) + (size_t)capacity * (sizeof(Game*) + sizeof(int)) + vectorHeapBytes(blocks)));
+    size_t idIndex = hashMapHeapBytes(idSlots);
+    for (unordered_map<string, int>::const_iterator it = idSlots.begin(); it != idSlots.end(); ++it) {
+        idIndex += stringHeapBytes(it->first);
+    }
+    out.push_back(make_pair(string("Game ID index"), idIndex));
+    out.push_back(make_pair(string("Fuzzy title index"), (titleIndex != nullptr) ? titleIndex->memoryUsage() : (size_t)0));
+    out.push_back(make_pair(string("Title autocomplete trie"), (titlePrefixes != nullptr) ? titlePrefixes->memoryUsage() : (size_t)0));
+    out.push_back(make_pair(string("Query engine indexes"), (queryEngine != nullptr) ? queryEngine->memoryUsage() : (size_t)0));
+    out.push_back(make_pair(string("Query result cache"), queryCache->memoryUsage()));
+    out.push_back(make_pair(string("Published catalog snapshot"), (snapshots != nullptr) ? snapshots->memoryUsage() : (size_t)0));
+}
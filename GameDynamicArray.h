@@ -1,15 +1,81 @@
 #pragma once
 #include "Game.h"
+#include "CatalogSnapshot.h"
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <cassert>
 
+class TitleIndex;
+class TitleTrie;
+class QueryEngine;
+class ThreadPool;
+class CatalogVersions;
+class QueryCache;
+struct GameQuery;
+struct QueryResult;
+
+/**
+ * Game catalog stored as a generational slot map.
+ * Each Game lives in a slot that keeps its address for as long as the game
+ * exists; freed slots go on a free list and get a new generation when they
+ * are reused, so a Handle to a removed game is detected instead of silently
+ * pointing at whatever replaced it. A dense array of pointers keeps index
+ * based iteration (size()/get(i)) contiguous; removal swaps the last entry
+ * into the gap, so add and remove are O(1).
+ */
 class GameDynamicArray {
+public:
+    // Stable reference to a game; resolve() returns nullptr once it is removed
+    struct Handle {
+        int slot;
+        unsigned int generation;
+    };
+
 private:
-    Game** data;
+    // Games are constructed in place in fixed blocks indexed by slot, so the
+    // 16-byte hot records sit next to each other and never move
+    static const int GAMES_PER_BLOCK = 256;
+
+    struct Slot {
+        Game* game;                 // nullptr while the slot is free
+        unsigned int generation;    // bumped every time the slot is freed
+        int position;               // index in 'data' while in use
+        int nextFree;               // free list link while unused
+    };
+
+    Game** data;                // dense, in iteration order
+    int* dataSlot;              // dense index -> slot index
     int capacity;
     int count;
 
+    Slot* slots;
+    std::vector<Game*> blocks;  // raw storage for GAMES_PER_BLOCK games each
+    int slotCapacity;
+    int slotCount;              // slots handed out so far (used or free)
+    int freeHead;               // first free slot, -1 if none
+
+    std::unordered_map<std::string, int> idSlots;   // gameID -> slot index
+    int highestIdNumber;        // largest numeric part of any game ID seen
+
+    TitleIndex* titleIndex;     // built on the first title search, then kept in sync
+    TitleTrie* titlePrefixes;   // built by buildTitlePrefixes(), then kept in sync
+    QueryEngine* queryEngine;   // created on the first query; reindexes after any reshape
+    QueryCache* queryCache;     // recent query results, checked against the versions below
+    ThreadPool* threadPool;     // handed to the query engine; nullptr = serial
+    CatalogVersions* snapshots; // published read-only versions (optional)
+    bool bulkAdding;            // between beginBulkAdd and endBulkAdd: publish once at the end
+    CatalogChanges snapshotChanges; // what the next publication must copy
+
+    // Bumped when games are added or removed, and when copies or ratings change
+    unsigned long long catalogVersion;
+    unsigned long long availabilityVersion;
+
     void resize();
+    int allocateSlot();
+    Game* storageFor(int slot) const;
+    void publishSnapshot();
+    void noteSnapshotChange(int position);
 
 public:
     GameDynamicArray();
@@ -29,13 +95,56 @@ public:
     // Pointer access
     Game* getPtr(int index);
 
-    // Ownership: add allocates a new Game on the heap
-    void add(const Game& g);
+    // Ownership: add allocates a new Game on the heap.
+    // Returns an invalid handle (slot -1) if the game ID is already in use.
+    Handle add(const Game& g);
 
     int findIndexByGameID(const std::string& gameID) const;
     Game* findByGameID(const std::string& gameID);
 
     bool removeByGameID(const std::string& gameID);
 
+    // Stable handles
+    Handle getHandle(int index) const;
+    Handle handleOf(const Game* game) const;
+    Game* resolve(const Handle& handle);
+
+    // Reorders the iteration sequence (used by sorting); handles are unaffected
+    void swapPositions(int a, int b);
+
+    // New game IDs continue after the highest ID ever seen, so they never collide
+    std::string nextGameID() const;
+
+    // Typo-tolerant title search, best matches first
+    void searchTitles(const std::string& query, int maxResults, std::vector<Game*>& out);
+
+    // Bulk loading: search indexes are dropped by beginBulkAdd() and rebuilt
+    // once by endBulkAdd() instead of being updated on every add
+    void beginBulkAdd();
+    void endBulkAdd();
+
+    // Title autocomplete, alphabetical
+    void buildTitlePrefixes();
+    void completeTitles(const std::string& prefix, int maxResults, std::vector<Game*>& out);
+
+    // Compound filter/sort/page query (see QueryEngine); repeated queries are
+    // answered from the result cache until the catalog or availability changes
+    void runQuery(const GameQuery& query, QueryResult& result);
+    void attachThreadPool(ThreadPool* workers);
+
+    // Read-copy-update snapshots for readers on other threads (see CatalogVersions);
+    // a new version is published after every add, remove and availability change
+    void attachSnapshots(CatalogVersions* versions);
+    CatalogVersions* getSnapshots() const;
+
+    // Called after a borrow, return or review changes a game's copies or rating;
+    // naming the game lets the snapshot copy only its chunk (nullptr = unknown)
+    void markAvailabilityChanged(const Game* changed = nullptr);
+    void markAvailabilityChanged(const std::vector<std::string>& changedIDs);
+    const QueryCache& getQueryCache() const;
+
+    // Memory footprint per structure: (structure name, approximate bytes)
+    void memoryFootprint(std::vector<std::pair<std::string, size_t>>& out) const;
+
     void printAll() const;
 };
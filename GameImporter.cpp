@@ -0,0 +1,275 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Streaming Import: Dumps are read one record at a time through a 1 MB
+ * stream buffer and added in batches, so memory stays bounded however large
+ * the file is.
+ * - Header Mapping: Columns are found by name (name/title, minplayers,
+ * maxplayers, minplaytime, maxplaytime, yearpublished/year), in any order;
+ * quoted fields may contain commas, doubled quotes and line breaks. Line
+ * breaks and tabs in titles become spaces, since games.csv keeps one game
+ * per line.
+ * - Hash Deduplication: Titles are reduced to a 64-bit hash of their
+ * lowercase words and checked against the catalog and the rows imported so
+ * far in O(1).
+ * - Single Index Rebuild: The catalog's search indexes are rebuilt once at the
+ * end instead of being updated for every imported game.
+ *****************************************************************************/
+
+#include "GameImporter.h"
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+/**
+ * Reads one CSV record. A quoted field can span lines, so lines are joined
+ * until every opened quote is closed.
+ * @return False at end of file.
+ */
+bool GameImporter::readRecord(istream& in, string& record) {
+    if (!getline(in, record)) return false;
+    bool inQuotes = false;
+    size_t scanned = 0;
+    string more;
+    while (true) {
+        for (; scanned < record.size(); scanned++) {
+            if (record[scanned] == '"') inQuotes = !inQuotes;
+        }
+        if (!inQuotes || !getline(in, more)) break;
+        record += '\n';
+        record += more;
+    }
+    if (!record.empty() && record[record.size() - 1] == '\r') record.erase(record.size() - 1);
+    return true;
+}
+
+/**
+ * Splits a record into fields, reusing the strings already in 'fields'.
+ * Quoted fields may contain commas and "" for a literal quote.
+ * @return Number of fields, or -1 if a quote is never closed.
+ */
+int GameImporter::splitFields(const string& record, vector<string>& fields) {
+    int count = 0;
+    size_t i = 0;
+    while (true) {
+        if (count == (int)fields.size()) fields.push_back(string());
+        string& field = fields[count++];
+        field.clear();
+
+        while (i < record.size() && (record[i] == ' ' || record[i] == '\t')) i++;
+        if (i < record.size() && record[i] == '"') {
+            i++;
+            bool closed = false;
+            while (i < record.size()) {
+                if (record[i] == '"') {
+                    if (i + 1 < record.size() && record[i + 1] == '"') {
+                        field += '"';
+                        i += 2;
+                        continue;
+                    }
+                    closed = true;
+                    i++;
+                    break;
+                }
+                field += record[i++];
+            }
+            if (!closed) return -1;
+            while (i < record.size() && record[i] != ',') i++;
+        }
+        else {
+            size_t start = i;
+            while (i < record.size() && record[i] != ',') i++;
+            size_t end = i;
+            while (end > start && (record[end - 1] == ' ' || record[end - 1] == '\t')) end--;
+            field.assign(record, start, end - start);
+        }
+
+        if (i >= record.size()) return count;
+        i++;    // skip the comma
+    }
+}
+
+/**
+ * Finds the columns the catalog uses by header name (case, spaces and
+ * underscores are ignored).
+ * @return False if there is no title column.
+ */
+bool GameImporter::mapColumns(const vector<string>& header, int count, ColumnMap& columns) {
+    columns.title = columns.minPlayers = columns.maxPlayers = -1;
+    columns.minPlayTime = columns.maxPlayTime = columns.year = -1;
+
+    for (int c = 0; c < count; c++) {
+        string name;
+        for (char ch : header[c]) {
+            unsigned char u = (unsigned char)ch;
+            if (isalnum(u)) name += (char)tolower(u);
+        }
+        if ((name == "name" || name == "title" || name == "primaryname") && columns.title == -1) columns.title = c;
+        else if (name == "minplayers") columns.minPlayers = c;
+        else if (name == "maxplayers") columns.maxPlayers = c;
+        else if (name == "minplaytime") columns.minPlayTime = c;
+        else if (name == "maxplaytime") columns.maxPlayTime = c;
+        else if (name == "yearpublished" || name == "year") columns.year = c;
+    }
+    return columns.title != -1;
+}
+
+/**
+ * Copies a title with line breaks, tabs and other control characters turned
+ * into single spaces and the ends trimmed, so games.csv can store it on one
+ * line (quotes and commas are escaped when it is saved).
+ * @return False if nothing is left of the title.
+ */
+bool GameImporter::cleanTitle(const string& raw, string& title) {
+    title.clear();
+    bool pendingSpace = false;
+    for (char c : raw) {
+        unsigned char u = (unsigned char)c;
+        if (u < 0x20 || u == 0x7f || c == ' ') {
+            pendingSpace = !title.empty();
+            continue;
+        }
+        if (pendingSpace) title += ' ';
+        pendingSpace = false;
+        title += c;
+    }
+    return !title.empty();
+}
+
+/** @return The leading integer of a field ("4", "-500", "2.0"), 0 if absent or empty. */
+int GameImporter::fieldInt(const vector<string>& fields, int count, int column) {
+    if (column < 0 || column >= count) return 0;
+    const string& text = fields[column];
+    size_t i = 0;
+    bool negative = (i < text.size() && text[i] == '-');
+    if (negative) i++;
+    int value = 0;
+    for (; i < text.size() && text[i] >= '0' && text[i] <= '9' && value < 100000000; i++) {
+        value = value * 10 + (text[i] - '0');
+    }
+    return negative ? -value : value;
+}
+
+/**
+ * 64-bit FNV-1a hash of a title's lowercase words joined by single spaces,
+ * so "Catan", "CATAN" and " Catan! " are the same title.
+ */
+unsigned long long GameImporter::titleHash(const string& title) {
+    unsigned long long h = 14695981039346656037ull;
+    bool pendingSpace = false;
+    bool anyWord = false;
+    for (char c : title) {
+        unsigned char u = (unsigned char)c;
+        if (!isalnum(u)) {
+            pendingSpace = anyWord;
+            continue;
+        }
+        if (pendingSpace) {
+            h ^= (unsigned char)' ';
+            h *= 1099511628211ull;
+            pendingSpace = false;
+        }
+        h ^= (unsigned char)tolower(u);
+        h *= 1099511628211ull;
+        anyWord = true;
+    }
+    return h;
+}
+
+/** Adds a batch of new games to the catalog with fresh IDs. */
+void GameImporter::flushBatch(vector<PendingGame>& batch, GameDynamicArray& games, Stats& stats) {
+    for (int i = 0; i < (int)batch.size(); i++) {
+        const PendingGame& row = batch[i];
+        Game game(games.nextGameID(), row.title, row.minPlayers, row.maxPlayers, row.year, 1, 1);
+        game.setPlayTime(row.minPlayTime, row.maxPlayTime);
+        games.add(game);
+        stats.imported++;
+    }
+    batch.clear();
+}
+
+/**
+ * Imports every new game from a CSV dump into the catalog.
+ * @param filename Path to the dump; its first line must be a header.
+ * @param games Catalog that receives the new games.
+ * @param stats Receives row counts, elapsed time and throughput.
+ * @return False if the file cannot be opened or has no title column.
+ */
+bool GameImporter::importFile(const string& filename, GameDynamicArray& games, Stats& stats) {
+    stats.rowsRead = stats.imported = stats.duplicates = stats.rejected = 0;
+    stats.seconds = stats.rowsPerSecond = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    vector<char> streamBuffer(1 << 20);
+    ifstream file;
+    file.rdbuf()->pubsetbuf(streamBuffer.data(), (streamsize)streamBuffer.size());
+    file.open(filename);
+    if (!file.is_open()) {
+        cout << "[ERROR] Could not open " << filename << "\n";
+        return false;
+    }
+
+    string record;
+    vector<string> fields;
+    ColumnMap columns;
+    if (!readRecord(file, record)) {
+        cout << "[ERROR] " << filename << " is empty.\n";
+        return false;
+    }
+    if (record.compare(0, 3, "\xEF\xBB\xBF") == 0) record.erase(0, 3);     // UTF-8 byte order mark
+    int headerCount = splitFields(record, fields);
+    if (headerCount < 0 || !mapColumns(fields, headerCount, columns)) {
+        cout << "[ERROR] " << filename << " has no name/title column.\n";
+        return false;
+    }
+
+    // Titles already in the catalog count as duplicates
+    unordered_set<unsigned long long> seen;
+    seen.reserve((size_t)games.size() * 2 + BATCH_SIZE);
+    for (int i = 0; i < games.size(); i++) seen.insert(titleHash(games.get(i).getTitle()));
+
+    games.beginBulkAdd();
+    vector<PendingGame> batch;
+    batch.reserve(BATCH_SIZE);
+    string title;
+    while (readRecord(file, record)) {
+        if (record.empty()) continue;
+        stats.rowsRead++;
+
+        int count = splitFields(record, fields);
+        if (count < 0 || columns.title >= count || !cleanTitle(fields[columns.title], title)) {
+            stats.rejected++;
+        }
+        else if (!seen.insert(titleHash(title)).second) {
+            stats.duplicates++;
+        }
+        else {
+            PendingGame row;
+            row.title = title;
+            row.minPlayers = fieldInt(fields, count, columns.minPlayers);
+            row.maxPlayers = fieldInt(fields, count, columns.maxPlayers);
+            if (row.maxPlayers < row.minPlayers) row.maxPlayers = row.minPlayers;
+            row.minPlayTime = fieldInt(fields, count, columns.minPlayTime);
+            row.maxPlayTime = fieldInt(fields, count, columns.maxPlayTime);
+            row.year = fieldInt(fields, count, columns.year);
+            batch.push_back(row);
+            if ((int)batch.size() == BATCH_SIZE) flushBatch(batch, games, stats);
+        }
+
+        if (stats.rowsRead % PROGRESS_INTERVAL == 0) {
+            double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            cout << "[IMPORT] " << stats.rowsRead << " rows read, " << stats.imported + (long long)batch.size()
+                 << " new (" << (long long)(stats.rowsRead / (elapsed > 0 ? elapsed : 1)) << " rows/s)\n";
+        }
+    }
+    flushBatch(batch, games, stats);
+    games.endBulkAdd();
+
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    stats.rowsPerSecond = (stats.seconds > 0) ? stats.rowsRead / stats.seconds : 0;
+    return true;
+}
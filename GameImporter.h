@@ -0,0 +1,65 @@
+#ifndef GAMEIMPORTER_H
+#define GAMEIMPORTER_H
+
+#include "GameDynamicArray.h"
+#include <istream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+/**
+ * Streaming importer for external board-game dumps (millions of rows).
+ * Columns are matched by header name, so any column order works and extra
+ * columns are ignored. Rows are read one record at a time and added to the
+ * catalog in batches, so memory use does not depend on the file size. A
+ * title already in the catalog (or earlier in the file) is skipped; titles
+ * are compared by a 64-bit hash of their normalized words. Search indexes
+ * are rebuilt once at the end (see GameDynamicArray::beginBulkAdd).
+ */
+class GameImporter {
+public:
+    static const int BATCH_SIZE = 8192;
+    static const int PROGRESS_INTERVAL = 250000;   // rows between progress lines
+
+    struct Stats {
+        long long rowsRead;
+        long long imported;
+        long long duplicates;
+        long long rejected;     // no title, or a malformed record
+        double seconds;
+        double rowsPerSecond;
+    };
+
+    static bool importFile(const string& filename, GameDynamicArray& games, Stats& stats);
+
+private:
+    // Column positions in the dump, -1 when the column is absent
+    struct ColumnMap {
+        int title;
+        int minPlayers;
+        int maxPlayers;
+        int minPlayTime;
+        int maxPlayTime;
+        int year;
+    };
+
+    struct PendingGame {
+        string title;
+        int minPlayers;
+        int maxPlayers;
+        int minPlayTime;
+        int maxPlayTime;
+        int year;
+    };
+
+    static bool readRecord(istream& in, string& record);
+    static int splitFields(const string& record, vector<string>& fields);
+    static bool mapColumns(const vector<string>& header, int count, ColumnMap& columns);
+    static bool cleanTitle(const string& raw, string& title);
+    static int fieldInt(const vector<string>& fields, int count, int column);
+    static unsigned long long titleHash(const string& title);
+    static void flushBatch(vector<PendingGame>& batch, GameDynamicArray& games, Stats& stats);
+};
+
+#endif
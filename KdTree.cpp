@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Implicit Layout: The tree is a single array ordered by median splits, so
+ * it needs no child pointers and is built in O(n log n) with nth_element.
+ * - Box Pruning: A range query skips every subtree that lies entirely on the
+ * wrong side of a split, so only nodes near the box are visited.
+ *****************************************************************************/
+
+#include "KdTree.h"
+#include "MemoryFootprint.h"
+#include <algorithm>
+using namespace std;
+
+/**
+ * Builds the tree from a set of points (the vector is emptied).
+ * Time Complexity: O(n log n)
+ */
+void KdTree::build(vector<Point>& points) {
+    nodes.swap(points);
+    points.clear();
+    buildRange(0, (int)nodes.size(), 0);
+}
+
+/** Places the median of [lo, hi) on this level's dimension in the middle, then recurses. */
+void KdTree::buildRange(int lo, int hi, int depth) {
+    if (hi - lo <= 1) return;
+    int mid = lo + (hi - lo) / 2;
+    int dim = depth % DIMENSIONS;
+    nth_element(nodes.begin() + lo, nodes.begin() + mid, nodes.begin() + hi,
+        [dim](const Point& a, const Point& b) { return a.key[dim] < b.key[dim]; });
+    buildRange(lo, mid, depth + 1);
+    buildRange(mid + 1, hi, depth + 1);
+}
+
+bool KdTree::contains(const Box& box, const Point& point) {
+    for (int d = 0; d < DIMENSIONS; d++) {
+        if (point.key[d] < box.low[d] || point.key[d] > box.high[d]) return false;
+    }
+    return true;
+}
+
+/**
+ * Appends the position of every point inside the box (in tree order).
+ * @param box Inclusive bounds; use INT_MIN/INT_MAX for an open dimension.
+ * @param out Receives the matching positions.
+ */
+void KdTree::query(const Box& box, vector<int>& out) const {
+    queryRange(0, (int)nodes.size(), 0, box, out);
+}
+
+void KdTree::queryRange(int lo, int hi, int depth, const Box& box, vector<int>& out) const {
+    if (lo >= hi) return;
+    int mid = lo + (hi - lo) / 2;
+    int dim = depth % DIMENSIONS;
+    const Point& split = nodes[mid];
+
+    if (contains(box, split)) out.push_back(split.position);
+    // Everything left of the split is <= its key and everything right is >= it
+    if (box.low[dim] <= split.key[dim]) queryRange(lo, mid, depth + 1, box, out);
+    if (box.high[dim] >= split.key[dim]) queryRange(mid + 1, hi, depth + 1, box, out);
+}
+
+int KdTree::size() const {
+    return (int)nodes.size();
+}
+
+size_t KdTree::memoryUsage() const {
+    return vectorHeapBytes(nodes);
+}
@@ -0,0 +1,47 @@
+#ifndef KDTREE_H
+#define KDTREE_H
+
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+/**
+ * Static k-d tree over small integer points, used by the query engine to
+ * answer player count, year and play time ranges in one descent.
+ * The tree is implicit: the points are stored in one array and the node for
+ * a range [lo, hi) is its middle element, which splits the range on the
+ * dimension (depth % DIMENSIONS). A box query only enters a child whose side
+ * of the split can overlap the box, so a selective box visits
+ * O(log n + matches) nodes in practice; the worst case for a box that is
+ * unbounded in some dimensions is O(n^(1 - 1/DIMENSIONS) + matches).
+ */
+class KdTree {
+public:
+    static const int DIMENSIONS = 4;
+
+    struct Point {
+        int key[DIMENSIONS];
+        int position;       // catalog position the point stands for
+    };
+
+    // Inclusive bounds per dimension
+    struct Box {
+        int low[DIMENSIONS];
+        int high[DIMENSIONS];
+    };
+
+    void build(vector<Point>& points);
+    void query(const Box& box, vector<int>& out) const;
+
+    int size() const;
+    size_t memoryUsage() const;     // approximate heap bytes (see MemoryFootprint.h)
+
+private:
+    vector<Point> nodes;
+
+    void buildRange(int lo, int hi, int depth);
+    void queryRange(int lo, int hi, int depth, const Box& box, vector<int>& out) const;
+    static bool contains(const Box& box, const Point& point);
+};
+
+#endif
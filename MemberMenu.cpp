@@ -6,41 +6,56 @@
  * - Queue-Based Browse History: Maintains only the 5 most recent game views
  * with automatic removal of oldest entries for memory efficiency.
  * - Multi-Criteria Search: Supports searching games by player count, year,
- * and title with case-insensitive matching for flexibility.
+ * and title with case-insensitive matching for flexibility; title searches
+ * list autocompletions of the typed text before typo-tolerant matches.
+ * - Advanced Search: Players, year range, play time, title text,
+ * availability and minimum rating combine into one planned query, sorted and
+ * shown a page at a time.
  * - Real-Time Availability: Checks current stock when displaying browse history
  * and search results to prevent borrowing unavailable games.
- * - Transaction Persistence: Immediately saves borrow/return records and browse
- * history to CSV for data durability and audit trails.
+ * - Transaction Persistence: Queues borrow/return records for the background
+ * writer right after each change, so confirmations never wait on disk I/O.
+ * - Batch Returns: Several loans can be returned in one step, validated and
+ * saved together as one BorrowBatch.
+ * - Warm Sessions: Browse history, active loans and summary counters come
+ * from the member's cached session, so repeat logins read no files and the
+ * history is saved lazily.
+ * - Recommendations: Shows "members who borrowed this also borrowed" for the
+ * selected game and feeds every view and borrow back into the recommender.
+ * - Play Sessions: Members record who played and won; their win rate,
+ * head-to-head results and favourite partner update immediately.
  *****************************************************************************/
 
 #include "MemberMenu.h"
 #include "CSVHandler.h"
 #include "BrowseHistory.h"
+#include "QueryEngine.h"
+#include "BorrowBatch.h"
+#include <algorithm>
 #include <iostream>
 #include <ctime>
 #include <sstream>
 
 using namespace std;
 
+// number of games listed by the "most borrowed" and "trending" searches
+static const int POPULAR_LIST_SIZE = 5;
+
+// most games listed by a title search
+static const int TITLE_SEARCH_LIMIT = 20;
+
+// games per page of advanced search results
+static const int SEARCH_PAGE_SIZE = 10;
+
 // for borrowing game (to be recorded in borrow_records.csv)
 static string generateRecordID(BorrowLinkedList& records) {
-    // Simple ID generation: "BR" + counter
-    static int counter = 1;
-    return "BR" + to_string(counter++);
+    // Continues after the highest record ID loaded, so IDs stay unique across runs
+    return records.nextRecordID();
 }
 
 // for borrowing and returning game (to be recorded in borrow_records.csv)
-static string getCurrentDate() {
-    time_t now = time(0);
-    tm timeinfo;
-    localtime_s(&timeinfo, &now);
-    
-    stringstream ss;
-    ss << (1900 + timeinfo.tm_year) << "-" 
-       << (timeinfo.tm_mon + 1) << "-" 
-       << timeinfo.tm_mday;
-    
-    return ss.str();
+static Date getCurrentDate() {
+    return Date::today();
 }
 
 // for input validation (non integer inputs)
@@ -75,9 +90,55 @@ static int getValidPositiveInt(const string& prompt) {
     }
 }
 
+// for optional numeric filters (blank input means "any", returned as 0)
+static int getOptionalInt(const string& prompt) {
+    string line;
+    while (true) {
+        cout << prompt;
+        getline(cin, line);
+        if (line.empty()) return 0;
+        stringstream ss(line);
+        int value;
+        char extra;
+        if (ss >> value && !(ss >> extra) && value > 0) return value;
+        cout << "Invalid input. Please enter a positive number or leave it blank.\n";
+    }
+}
+
+// Journal writes are acknowledged in the background; any that failed since
+// the last prompt are reported here instead of blocking each change
+static void reportJournalFailures(PersistenceWorker& persistence) {
+    long long failed = persistence.takeJournalFailures();
+    if (failed > 0) {
+        cout << "[WARNING] " << failed << " recent change(s) could not be written to the journal; "
+             << "they will be saved with the next file write.\n";
+    }
+}
+
 // MEMBER MENU OPTIONS
 // 1. Borrow a Game
-static void borrowGame(const User& member, GameDynamicArray& games, BorrowLinkedList& records, BrowseHistory& history) {
+// Lists the "also borrowed" games for the selected game
+// (the member's own views and borrows are left out)
+static void showRecommendations(const string& userID, const string& gameID, GameDynamicArray& games,
+    const Recommender& recommender) {
+    vector<Recommender::Neighbour> similar;
+    recommender.recommendFor(userID, gameID, similar);
+    bool printedHeader = false;
+    for (int i = 0; i < (int)similar.size(); i++) {
+        Game* g = games.findByGameID(similar[i].gameID);
+        if (g == nullptr) continue;
+        if (!printedHeader) {
+            cout << "\nMembers who borrowed this also borrowed:\n";
+            printedHeader = true;
+        }
+        cout << "  - " << g->getTitle() << " (" << g->getGameID() << ", "
+             << g->getAvailableCopies() << "/" << g->getTotalCopies() << " available)\n";
+    }
+}
+
+static void borrowGame(const User& member, GameDynamicArray& games, BorrowLinkedList& records, SessionCache& sessions,
+    SessionCache::Session& session, PersistenceWorker& persistence, Recommender& recommender) {
+    BrowseHistory& history = session.history;
     bool continueSearching = true;
     
     while (continueSearching) {
@@ -87,9 +148,12 @@ static void borrowGame(const User& member, GameDynamicArray& games, BorrowLinked
         cout << "2. Year of Publication\n";
         cout << "3. Title\n";
         cout << "4. Recent Browse History\n";
+        cout << "5. Most Borrowed Games\n";
+        cout << "6. Trending Games (last few weeks)\n";
+        cout << "7. Advanced Search (combine filters)\n";
         cout << "0. Back to Member Menu\n";
 
-        int searchChoice = getValidChoice(0, 4);
+        int searchChoice = getValidChoice(0, 7);
 
         GameDynamicArray searchResults;
         
@@ -104,11 +168,12 @@ static void borrowGame(const User& member, GameDynamicArray& games, BorrowLinked
             // Search by number of players
             int numPlayers = getValidPositiveInt("Enter number of players: ");
 
-            for (int i = 0; i < games.size(); i++) {
-                Game g = games.get(i);
-                if (numPlayers >= g.getMinPlayers() && numPlayers <= g.getMaxPlayers()) {
-                    searchResults.add(g);
-                }
+            GameQuery query;
+            query.players = numPlayers;
+            QueryResult result;
+            games.runQuery(query, result);
+            for (int i = 0; i < (int)result.games.size(); i++) {
+                searchResults.add(*result.games[i]);
             }
 
             if (searchResults.isEmpty()) {
@@ -121,11 +186,12 @@ static void borrowGame(const User& member, GameDynamicArray& games, BorrowLinked
             // Search by year of publication
             int year = getValidPositiveInt("Enter year of publication: ");
 
-            for (int i = 0; i < games.size(); i++) {
-                Game g = games.get(i);
-                if (g.getYear() == year) {
-                    searchResults.add(g);
-                }
+            GameQuery query;
+            query.yearFrom = query.yearTo = year;
+            QueryResult result;
+            games.runQuery(query, result);
+            for (int i = 0; i < (int)result.games.size(); i++) {
+                searchResults.add(*result.games[i]);
             }
 
             if (searchResults.isEmpty()) {
@@ -135,7 +201,7 @@ static void borrowGame(const User& member, GameDynamicArray& games, BorrowLinked
             break;
         }
         case 3: {
-            // Search by title (substring matching, case-insensitive)
+            // Search by title (word matching that tolerates typos)
             string searchTitle;
             cout << "Enter game title to search: ";
             getline(cin, searchTitle);
@@ -145,27 +211,21 @@ static void borrowGame(const User& member, GameDynamicArray& games, BorrowLinked
                 continue;
             }
 
-            // Convert search title to lowercase for case-insensitive comparison
-            string searchTitleLower = searchTitle;
-            for (int i = 0; i < (int)searchTitleLower.length(); i++) {
-                searchTitleLower[i] = tolower(searchTitleLower[i]);
-            }
-
-            for (int i = 0; i < games.size(); i++) {
-                Game g = games.get(i);
-                string title = g.getTitle();
-                
-                // Convert game title to lowercase for comparison
-                string titleLower = title;
-                for (int j = 0; j < (int)titleLower.length(); j++) {
-                    titleLower[j] = tolower(titleLower[j]);
-                }
-                
-                // Check if searchTitle is contained in the game title (case-insensitive)
-                if (titleLower.find(searchTitleLower) != string::npos) {
-                    searchResults.add(g);
+            // Titles that start with the text come first (autocomplete), then
+            // typo-tolerant matches on title words fill the remaining slots
+            vector<Game*> matches;
+            games.completeTitles(searchTitle, TITLE_SEARCH_LIMIT, matches);
+            int completions = (int)matches.size();
+            vector<Game*> fuzzy;
+            games.searchTitles(searchTitle, TITLE_SEARCH_LIMIT, fuzzy);
+            for (int i = 0; i < (int)fuzzy.size() && (int)matches.size() < TITLE_SEARCH_LIMIT; i++) {
+                if (find(matches.begin(), matches.begin() + completions, fuzzy[i]) == matches.begin() + completions) {
+                    matches.push_back(fuzzy[i]);
                 }
             }
+            for (int i = 0; i < (int)matches.size(); i++) {
+                searchResults.add(*matches[i]);
+            }
 
             if (searchResults.isEmpty()) {
                 cout << "No games found containing '" << searchTitle << "'.\n";
@@ -245,6 +305,7 @@ static void borrowGame(const User& member, GameDynamicArray& games, BorrowLinked
             // Display game details
             cout << "\nGame Details:\n";
             actualGame->print();
+            showRecommendations(member.getUserID(), actualGame->getGameID(), games, recommender);
 
             // Confirm borrow
             cout << "\nConfirm borrow? (y/n): ";
@@ -261,25 +322,26 @@ static void borrowGame(const User& member, GameDynamicArray& games, BorrowLinked
             if (confirm == 'y' || confirm == 'Y') {
                 // Create borrow record
                 string recordID = generateRecordID(records);
-                string borrowDate = getCurrentDate();
-                string returnDate = "";
+                Date borrowDate = getCurrentDate();
+                Date returnDate;                              // Empty (not returned)
                 
                 BorrowRecord newRecord(recordID, member.getUserID(), 
                                    actualGame->getGameID(), borrowDate, returnDate);
                 records.insertFront(newRecord);
+                sessions.recordBorrow(session, newRecord);
+                recommender.recordBorrow(member.getUserID(), actualGame->getGameID());
+                persistence.logBorrow(newRecord);
 
                 // Decrease available copies
                 actualGame->decrementAvailable();
+                games.markAvailabilityChanged(actualGame);
 
-                // Save the updated records to CSV 
-                CSVHandler::saveBorrowRecords("borrow_records.csv", records);
-                
-                // Save the updated games to CSV
-                CSVHandler::saveGames("games.csv", games);
+                // Queue the updated records and games for the background writer
+                persistence.markRecordsDirty(records);
+                persistence.markGamesDirty(games);
                 
-                // Add to browse history and save immediately
-                history.enqueue(*actualGame, getCurrentDate());
-                CSVHandler::saveBrowseHistory("browse_history.csv", member.getUserID(), history);
+                // Add to browse history (saved with the session)
+                sessions.recordView(session, *actualGame, getCurrentDate());
 
                 cout << "Game borrowed successfully!\n";
                 cout << "Record ID: " << recordID << "\n";
@@ -289,6 +351,77 @@ static void borrowGame(const User& member, GameDynamicArray& games, BorrowLinked
             }
             continue;
         }
+        case 5:
+        case 6: {
+            // Leaderboards are kept up to date by the borrow records, so this is O(K)
+            vector<PopularityBoard::Entry> ranked;
+            if (searchChoice == 5) records.getPopularity().topBorrowed(POPULAR_LIST_SIZE, ranked);
+            else records.getPopularity().topTrending(POPULAR_LIST_SIZE, getCurrentDate(), ranked);
+
+            for (int i = 0; i < (int)ranked.size(); i++) {
+                Game* g = games.findByGameID(ranked[i].gameID);
+                if (g != nullptr) searchResults.add(*g);
+            }
+
+            if (searchResults.isEmpty()) {
+                cout << "No borrows recorded yet.\n";
+                continue;
+            }
+            cout << "\n(" << (searchChoice == 5 ? "Ranked by total borrows" : "Ranked by recent borrows")
+                 << ", most popular first)\n";
+            break;
+        }
+        case 7: {
+            // Any combination of filters; leave a filter blank to skip it
+            GameQuery query;
+            cout << "\n--- Advanced Search (press Enter to skip a filter) ---\n";
+            query.players = getOptionalInt("Number of players: ");
+            query.yearFrom = getOptionalInt("Published from year: ");
+            query.yearTo = getOptionalInt("Published up to year: ");
+            query.maxPlayTime = getOptionalInt("Finishes within (minutes): ");
+            cout << "Title contains: ";
+            getline(cin, query.titleText);
+            query.minRating = getOptionalInt("Minimum average rating (1-5): ");
+            cout << "Only games with copies available? (y/n): ";
+            string answer;
+            getline(cin, answer);
+            query.availableOnly = !answer.empty() && (answer[0] == 'y' || answer[0] == 'Y');
+
+            cout << "Sort by: 1. Title  2. Year (newest first)  3. Rating (best first)  4. Copies available\n";
+            switch (getValidChoice(1, 4, "Sort choice: ")) {
+            case 2: query.sortKey = GameQuery::BY_YEAR; query.descending = true; break;
+            case 3: query.sortKey = GameQuery::BY_RATING; query.descending = true; break;
+            case 4: query.sortKey = GameQuery::BY_AVAILABLE; query.descending = true; break;
+            default: break;
+            }
+            query.pageSize = SEARCH_PAGE_SIZE;
+
+            // Page through the results until the member picks a page to choose from
+            QueryResult result;
+            while (true) {
+                games.runQuery(query, result);
+                if (result.totalMatches == 0 || result.pageCount == 1) break;
+
+                cout << "\n--- Page " << (query.page + 1) << " of " << result.pageCount
+                     << " (" << result.totalMatches << " games) ---\n";
+                for (int i = 0; i < (int)result.games.size(); i++) {
+                    cout << "  " << (query.page * SEARCH_PAGE_SIZE + i + 1) << ". " << result.games[i]->getTitle()
+                         << " (" << result.games[i]->getYear() << ")\n";
+                }
+                int page = getValidChoice(0, result.pageCount, "Go to page (0 to choose from this page): ");
+                if (page == 0) break;
+                query.page = page - 1;
+            }
+            for (int i = 0; i < (int)result.games.size(); i++) {
+                searchResults.add(*result.games[i]);
+            }
+
+            if (searchResults.isEmpty()) {
+                cout << "No games match all of those filters.\n";
+                continue;
+            }
+            break;
+        }
 
         default:
             cout << "Invalid search choice.\n";
@@ -324,15 +457,15 @@ static void borrowGame(const User& member, GameDynamicArray& games, BorrowLinked
             continue;
         }
 
-        // ADD TO BROWSE HISTORY (Queue - regardless of search method)
-        history.enqueue(*foundGame, getCurrentDate());
-        
-        // Save browse history immediately to ensure persistence
-        CSVHandler::saveBrowseHistory("browse_history.csv", member.getUserID(), history);
-
-        // Display game details
+        // Display game details; recommendations are shown before this view is
+        // counted, so the member's own visit cannot feed them
         cout << "\nGame Details:\n";
         foundGame->print();
+        showRecommendations(member.getUserID(), foundGame->getGameID(), games, recommender);
+
+        // ADD TO BROWSE HISTORY (Queue - regardless of search method)
+        sessions.recordView(session, *foundGame, getCurrentDate());
+        recommender.recordView(member.getUserID(), foundGame->getGameID());
 
         // Confirm borrow
         cout << "\nConfirm borrow? (y/n): ";
@@ -352,23 +485,25 @@ static void borrowGame(const User& member, GameDynamicArray& games, BorrowLinked
             
             // Create borrow record
             string recordID = generateRecordID(records);      // BR1, BR2, BR3...
-            string borrowDate = getCurrentDate();             // YYYY-M-D format
-            string returnDate = "";                           // Empty (not returned)
+            Date borrowDate = getCurrentDate();
+            Date returnDate;                                  // Empty (not returned)
             
             BorrowRecord newRecord(recordID, member.getUserID(), 
                                foundGame->getGameID(), borrowDate, returnDate);
             records.insertFront(newRecord);                   // Added to LinkedList
+            sessions.recordBorrow(session, newRecord);
+            recommender.recordBorrow(member.getUserID(), foundGame->getGameID());
+            persistence.logBorrow(newRecord);
 
             // Decrease available copies in the main array
             if (actualGame != nullptr) {
                 actualGame->decrementAvailable();
+                games.markAvailabilityChanged(actualGame);
             }
 
-            // Save the updated records to CSV 
-            CSVHandler::saveBorrowRecords("borrow_records.csv", records);
-            
-            // Save the updated games to CSV (to save number of copies)
-            CSVHandler::saveGames("games.csv", games);
+            // Queue the updated records and games (copies) for the background writer
+            persistence.markRecordsDirty(records);
+            persistence.markGamesDirty(games);
 
             cout << "Game borrowed successfully!\n";
             cout << "Record ID: " << recordID << "\n";
@@ -380,12 +515,13 @@ static void borrowGame(const User& member, GameDynamicArray& games, BorrowLinked
 }
 
 // 2. Return a Game
-static void returnGame(const User& member, GameDynamicArray& games, BorrowLinkedList& records, BrowseHistory& history) {
+static void returnGame(const User& member, GameDynamicArray& games, BorrowLinkedList& records, SessionCache& sessions,
+    SessionCache::Session& session, PersistenceWorker& persistence) {
     struct BorrowInfo {
         string recordID;
         string gameID;
-        string borrowDate;
-        Game* gamePtr;
+        Date borrowDate;
+        GameDynamicArray::Handle game;  // detects the game being removed meanwhile
     };
 
     BorrowInfo borrowedList[100];  // Assuming max 100 borrowed games
@@ -395,26 +531,27 @@ static void returnGame(const User& member, GameDynamicArray& games, BorrowLinked
     
     cout << "\n--- Your Borrowed Games ---\n";
     
+    // The session already knows the member's loans; games removed since are skipped
     int gameCount = 0;
-    for (int i = 0; i < games.size(); i++) {
-        Game g = games.get(i);
-        BorrowRecord* activeBorrow = records.findActiveBorrow(member.getUserID(), g.getGameID());
-        
-        if (activeBorrow != nullptr) {
-            gameCount++;
-            cout << "[" << gameCount << "] " << g.getTitle() << "\n";
-            cout << "    Game ID: " << g.getGameID() << "\n";
-            cout << "    Borrow Date: " << activeBorrow->getBorrowDate() << "\n";
-            cout << "-----------------------\n";
-            
-            // Store the borrow info
-            if (borrowedCount < 100) {
-                borrowedList[borrowedCount].recordID = activeBorrow->getRecordID();
-                borrowedList[borrowedCount].gameID = g.getGameID();
-                borrowedList[borrowedCount].borrowDate = activeBorrow->getBorrowDate();
-                borrowedList[borrowedCount].gamePtr = games.findByGameID(g.getGameID());
-                borrowedCount++;
-            }
+    for (int i = 0; i < (int)session.activeLoans.size(); i++) {
+        const SessionCache::Loan& loan = session.activeLoans[i];
+        int index = games.findIndexByGameID(loan.gameID);
+        if (index == -1) continue;
+        const Game& g = games.get(index);
+
+        gameCount++;
+        cout << "[" << gameCount << "] " << g.getTitle() << "\n";
+        cout << "    Game ID: " << g.getGameID() << "\n";
+        cout << "    Borrow Date: " << loan.borrowDate << "\n";
+        cout << "-----------------------\n";
+
+        // Store the borrow info
+        if (borrowedCount < 100) {
+            borrowedList[borrowedCount].recordID = loan.recordID;
+            borrowedList[borrowedCount].gameID = loan.gameID;
+            borrowedList[borrowedCount].borrowDate = loan.borrowDate;
+            borrowedList[borrowedCount].game = games.getHandle(index);
+            borrowedCount++;
         }
     }
 
@@ -438,7 +575,7 @@ static void returnGame(const User& member, GameDynamicArray& games, BorrowLinked
     }
 
     BorrowInfo& selectedBorrow = borrowedList[selection - 1];
-    Game* gameToReturn = selectedBorrow.gamePtr;
+    Game* gameToReturn = games.resolve(selectedBorrow.game);
 
     if (gameToReturn == nullptr) {
         cout << "Error: Game not found.\n";
@@ -465,17 +602,18 @@ static void returnGame(const User& member, GameDynamicArray& games, BorrowLinked
         // Update the borrow record with return date
         BorrowRecord* borrowRecord = records.findActiveBorrow(member.getUserID(), selectedBorrow.gameID);
         if (borrowRecord != nullptr) {
-            string returnDate = getCurrentDate();
-            borrowRecord->setReturnDate(returnDate);
+            Date returnDate = getCurrentDate();
+            records.markReturned(borrowRecord, returnDate);
+            sessions.recordReturn(session, *borrowRecord);
+            persistence.logReturn(*borrowRecord);
 
             // Increase available copies
             gameToReturn->incrementAvailable();
+            games.markAvailabilityChanged(gameToReturn);
 
-            // Save the updated records to CSV immediately
-            CSVHandler::saveBorrowRecords("borrow_records.csv", records);
-            
-            // Save the updated games to CSV immediately (to persist availability changes)
-            CSVHandler::saveGames("games.csv", games);
+            // Queue the updated records and games (availability) for the background writer
+            persistence.markRecordsDirty(records);
+            persistence.markGamesDirty(games);
 
             cout << "Game returned successfully!\n";
             cout << "Record ID: " << selectedBorrow.recordID << "\n";
@@ -488,16 +626,87 @@ static void returnGame(const User& member, GameDynamicArray& games, BorrowLinked
     }
 }
 
+// 2b. Return several games at once (one batch, one save)
+static void returnSeveralGames(const User& member, GameDynamicArray& games, UserDynamicArray& users,
+    BorrowLinkedList& records, SessionCache& sessions, SessionCache::Session& session, PersistenceWorker& persistence) {
+    cout << "\n--- Return Several Games ---\n";
+    vector<string> loanGames;
+    for (int i = 0; i < (int)session.activeLoans.size(); i++) {
+        const SessionCache::Loan& loan = session.activeLoans[i];
+        const Game* g = games.findByGameID(loan.gameID);
+        if (g == nullptr) continue;
+        loanGames.push_back(loan.gameID);
+        cout << "[" << loanGames.size() << "] " << g->getTitle() << " (" << loan.gameID
+             << ", borrowed " << loan.borrowDate << ")\n";
+    }
+    if (loanGames.empty()) {
+        cout << "You have no borrowed games to return.\n";
+        return;
+    }
+
+    cout << "Enter the numbers of the games to return (e.g. 1 3 4), 'all', or 0 to go back: ";
+    string line;
+    getline(cin, line);
+
+    vector<BorrowBatch::Operation> batch;
+    vector<bool> chosen(loanGames.size(), false);
+    if (line == "all" || line == "ALL") {
+        for (int i = 0; i < (int)loanGames.size(); i++) chosen[i] = true;
+    }
+    else {
+        stringstream numbers(line);
+        int number;
+        while (numbers >> number) {
+            if (number == 0) {
+                cout << "Returning to Member Menu.\n";
+                return;
+            }
+            if (number < 1 || number > (int)loanGames.size()) {
+                cout << "[INVALID] " << number << " is not in the list.\n";
+                return;
+            }
+            chosen[number - 1] = true;
+        }
+    }
+    for (int i = 0; i < (int)loanGames.size(); i++) {
+        if (!chosen[i]) continue;
+        BorrowBatch::Operation op = { BorrowBatch::RETURN, member.getUserID(), loanGames[i] };
+        batch.push_back(op);
+    }
+    if (batch.empty()) {
+        cout << "No games selected.\n";
+        return;
+    }
+
+    // The batch keeps this session's loans and counters in step
+    BorrowBatch returns(games, users, records, persistence);
+    returns.attachSessions(&sessions);
+    vector<BorrowBatch::ItemResult> results;
+    BorrowBatch::Stats stats;
+    returns.apply(batch, results, stats);
+
+    for (int i = 0; i < (int)batch.size(); i++) {
+        const Game* g = games.findByGameID(batch[i].gameID);
+        cout << "  " << ((g != nullptr) ? g->getTitle() : batch[i].gameID) << ": "
+             << BorrowBatch::describe(results[i].outcome);
+        if (results[i].outcome == BorrowBatch::APPLIED) cout << " (record " << results[i].recordID << ")";
+        cout << "\n";
+    }
+    if (!stats.durable) cout << "[WARNING] The returns could not be written to the journal.\n";
+    cout << stats.applied << " game(s) returned on " << getCurrentDate() << ".\n";
+}
+
 // 3. Display Summary
-static void displaySummary(const User& member, GameDynamicArray& games, BorrowLinkedList& records, BrowseHistory& history) {
+static void displaySummary(const User& member, GameDynamicArray& games, BorrowLinkedList& records,
+    const SessionCache::Session& session) {
     cout << "\n--- Your Borrow Summary ---\n\n";
 
     string userID = member.getUserID();
     
-    // Get statistics
-    int totalBorrows = records.countBorrowsByUser(userID);
-    int totalReturns = records.countReturnsByUser(userID);
-    int activeBorrows = records.countActiveBorrowsByUser(userID);
+    // Get statistics (kept up to date by the session)
+    int totalBorrows = session.totalBorrows;
+    int totalReturns = session.totalReturns;
+    int activeBorrows = (int)session.activeLoans.size();
 
     // Display user information
     cout << "User ID: " << member.getUserID() << "\n";
@@ -527,34 +736,126 @@ static void viewBrowseHistory(BrowseHistory& history, GameDynamicArray& games) {
     history.displayHistory(&games);
 }
 
+// 6. Record a Play Session
+// Players are the member plus any other user IDs entered; the session is
+// folded into the statistics straight away and queued for saving
+static void recordPlaySession(const User& member, GameDynamicArray& games, UserDynamicArray& users,
+    PersistenceWorker& persistence, PlayStats& playStats) {
+    cout << "\n--- Record a Play Session ---\n";
+    string gameID;
+    cout << "Enter Game ID played: ";
+    getline(cin, gameID);
+    Game* game = games.findByGameID(gameID);
+    if (game == nullptr) {
+        cout << "[ERROR] Game ID " << gameID << " not found.\n";
+        return;
+    }
+
+    PlaySession session;
+    session.gameID = gameID;
+    session.date = getCurrentDate();
+    session.players.push_back(member.getUserID());
+
+    cout << "Enter the other players' User IDs, separated by spaces (blank if none): ";
+    string line, otherID;
+    getline(cin, line);
+    stringstream others(line);
+    while (others >> otherID) {
+        if (users.findByUserID(otherID) == nullptr) {
+            cout << "[ERROR] User ID " << otherID << " not found. Session not recorded.\n";
+            return;
+        }
+        if (find(session.players.begin(), session.players.end(), otherID) == session.players.end()) {
+            session.players.push_back(otherID);
+        }
+    }
+
+    cout << "Players:\n";
+    for (int i = 0; i < (int)session.players.size(); i++) {
+        cout << "[" << (i + 1) << "] " << session.players[i] << "\n";
+    }
+    int winner = getValidChoice(0, (int)session.players.size(), "Who won? (0 if nobody): ");
+    if (winner > 0) session.winnerID = session.players[winner - 1];
+
+    session.sessionID = playStats.nextSessionID();
+    if (!playStats.record(session)) {
+        cout << "[ERROR] Session could not be recorded.\n";
+        return;
+    }
+    persistence.markPlaySessionsDirty(playStats);
+    cout << "[SUCCESS] Session " << session.sessionID << " of " << game->getTitle() << " recorded.\n";
+}
+
+// 7. View Play Statistics
+// Own record, head-to-head results against everyone played and the most frequent partner
+static void showPlayStats(const User& member, PlayStats& playStats) {
+    const string& userID = member.getUserID();
+    PlayStats::PlayerRecord own = playStats.getPlayerRecord(userID);
+    cout << "\n--- Your Play Statistics ---\n";
+    if (own.plays == 0) {
+        cout << "You haven't recorded any play sessions yet.\n";
+        return;
+    }
+
+    cout << "Sessions played: " << own.plays << " | Wins: " << own.wins
+         << " | Win rate: " << (int)(playStats.getWinRate(userID) * 100.0 + 0.5) << "%\n";
+
+    PlayStats::Partner partner;
+    if (playStats.getBestPartner(userID, partner)) {
+        cout << "Plays most with: " << partner.userID << " (" << partner.sessions << " session(s))\n";
+    }
+
+    vector<pair<string, PlayStats::HeadToHead>> opponents;
+    playStats.opponentsOf(userID, opponents);
+    if (!opponents.empty()) {
+        cout << "\nHead-to-head (sessions / your wins / their wins):\n";
+        for (int i = 0; i < (int)opponents.size(); i++) {
+            const PlayStats::HeadToHead& h = opponents[i].second;
+            cout << "  vs " << opponents[i].first << ": " << h.played << " / " << h.wins << " / " << h.losses << "\n";
+        }
+    }
+}
+
 // Member Menu
-void MemberMenu::show(const User& member, GameDynamicArray& games, BorrowLinkedList& records) {
-    // Create and load browse history for this user
-    BrowseHistory history;
-    CSVHandler::loadBrowseHistory("browse_history.csv", member.getUserID(), history, games);
-    
+void MemberMenu::show(const User& member, GameDynamicArray& games, UserDynamicArray& users,
+    BorrowLinkedList& records, PersistenceWorker& persistence, Recommender& recommender, PlayStats& playStats,
+    SessionCache& sessions) {
+    // Browse history and loans stay cached between logins; only a first login reads files
+    SessionCache::Session& session = sessions.open(member.getUserID(), games, records);
+
+    // Remind the member about games kept past the loan period
+    int lateCount = records.countOverdueByUser(member.getUserID(), getCurrentDate());
+    if (lateCount > 0) {
+        cout << "\n[WARNING] You have " << lateCount << " overdue game(s). Loans are due back after "
+             << OverdueTracker::LOAN_PERIOD_DAYS << " days; please return them.\n";
+    }
+
     int choice = -1;
 
     while (choice != 0) {
+        reportJournalFailures(persistence);
         cout << "\n=== Member Menu ===\n";
         cout << "1. Borrow a Game\n";
         cout << "2. Return a Game\n";
         cout << "3. Display Summary\n";
         cout << "4. Review Games\n";
         cout << "5. View Review \n";
+        cout << "6. Record a Play Session\n";
+        cout << "7. View Play Statistics\n";
+        cout << "8. Return Several Games\n";
         cout << "0. Logout\n";
 
-        choice = getValidChoice(0, 6);
+        choice = getValidChoice(0, 8);
 
         switch (choice) {
         case 1:
-            borrowGame(member, games, records, history);
+            borrowGame(member, games, records, sessions, session, persistence, recommender);
             break;
         case 2:
-            returnGame(member, games, records, history);
+            returnGame(member, games, records, sessions, session, persistence);
             break;
         case 3:
-            displaySummary(member, games, records, history);
+            displaySummary(member, games, records, session);
             break;
         case 4: {
             string targetID;
@@ -600,7 +901,10 @@ void MemberMenu::show(const User& member, GameDynamicArray& games, BorrowLinkedL
                 }
 
                 targetGame->addReview(member.getName(), comment, rating);
-                CSVHandler::saveReviews("reviews.csv", games);
+                games.markAvailabilityChanged(targetGame);    // the average rating changed
+                persistence.logReview(targetGame->getGameID(),
+                    member.getName(), rating, comment);
+                persistence.markReviewsDirty(games);
 
                 cout << "\n[SUCCESS] Your review has been submitted!\n";
             }
@@ -632,10 +936,18 @@ void MemberMenu::show(const User& member, GameDynamicArray& games, BorrowLinkedL
             }
             break;
         }
+        case 6:
+            recordPlaySession(member, games, users, persistence, playStats);
+            break;
+        case 7:
+            showPlayStats(member, playStats);
+            break;
+        case 8:
+            returnSeveralGames(member, games, users, records, sessions, session, persistence);
+            break;
         case 0:
             cout << "Logging out...\n";
-            // Save browse history for this user
-            CSVHandler::saveBrowseHistory("browse_history.csv", member.getUserID(), history);
+            // Browse history stays in the session cache and is saved when evicted or at exit
             cout << "Returning to Main Menu.\n";
             break;
         default:
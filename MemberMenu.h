@@ -3,11 +3,18 @@
 
 #include "User.h"
 #include "GameDynamicArray.h"
+#include "UserDynamicArray.h"
 #include "BorrowLinkedList.h"
+#include "PersistenceWorker.h"
+#include "Recommender.h"
+#include "PlayStats.h"
+#include "SessionCache.h"
 
 class MemberMenu {
 public:
-    static void show(const User& member, GameDynamicArray& games, BorrowLinkedList& records);
+    static void show(const User& member, GameDynamicArray& games, UserDynamicArray& users,
+                     BorrowLinkedList& records, PersistenceWorker& persistence,
+                     Recommender& recommender, PlayStats& playStats, SessionCache& sessions);
 };
 
 #endif
@@ -0,0 +1,36 @@
+#ifndef MEMORYFOOTPRINT_H
+#define MEMORYFOOTPRINT_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+/*
+ * Helpers for the memory footprint report. They estimate the heap bytes a
+ * standard container owns from its size and capacity; allocator overhead is
+ * not counted, so totals are a lower bound that is accurate enough to compare
+ * layouts and to check bytes per game as the catalog grows.
+ */
+
+// Short strings live inside the string object itself (small string optimisation)
+static const size_t INLINE_STRING_CAPACITY = 15;
+
+inline size_t stringHeapBytes(const string& text) {
+    return (text.capacity() > INLINE_STRING_CAPACITY) ? text.capacity() + 1 : 0;
+}
+
+template <typename T>
+inline size_t vectorHeapBytes(const vector<T>& items) {
+    return items.capacity() * sizeof(T);
+}
+
+// Bucket array plus one node (value, next pointer, cached hash) per entry
+template <typename K, typename V>
+inline size_t hashMapHeapBytes(const unordered_map<K, V>& map) {
+    return map.bucket_count() * sizeof(void*) +
+           map.size() * (sizeof(typename unordered_map<K, V>::value_type) + 2 * sizeof(void*));
+}
+
+#endif
@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Indexed Min-Heap: Active loans are ordered by due date with O(log n)
+ * insertion and O(log n) removal of any loan when it is returned.
+ * - Output-Sensitive Report: Finding overdue loans walks only the overdue part
+ * of the heap, so the cost is O(k) for k overdue loans.
+ *****************************************************************************/
+
+#include "OverdueTracker.h"
+#include <algorithm>
+using namespace std;
+
+/** @return The date a loan is due back (borrow date + loan period; empty if the borrow date is). */
+Date OverdueTracker::dueDateFor(const BorrowRecord& record) {
+    return record.getBorrowDate().addDays(LOAN_PERIOD_DAYS);
+}
+
+void OverdueTracker::swapSlots(int a, int b) {
+    Loan temp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = temp;
+    position[heap[a].record] = a;
+    position[heap[b].record] = b;
+}
+
+void OverdueTracker::siftUp(int index) {
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (heap[parent].dueDay <= heap[index].dueDay) break;
+        swapSlots(parent, index);
+        index = parent;
+    }
+}
+
+void OverdueTracker::siftDown(int index) {
+    int n = (int)heap.size();
+    while (true) {
+        int smallest = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+        if (left < n && heap[left].dueDay < heap[smallest].dueDay) smallest = left;
+        if (right < n && heap[right].dueDay < heap[smallest].dueDay) smallest = right;
+        if (smallest == index) break;
+        swapSlots(smallest, index);
+        index = smallest;
+    }
+}
+
+/**
+ * Starts tracking an active loan. Returned records, records already in the
+ * heap and records without a valid borrow date (whose due date is unknown,
+ * not overdue) are ignored.
+ * Time Complexity: O(log n)
+ */
+void OverdueTracker::add(BorrowRecord* record) {
+    if (record == nullptr || record->isReturned()) return;
+    if (record->getBorrowDate().isEmpty()) return;
+    if (position.find(record) != position.end()) return;
+
+    Loan loan = { dueDateFor(*record).getDays(), record };
+    heap.push_back(loan);
+    position[record] = (int)heap.size() - 1;
+    siftUp((int)heap.size() - 1);
+}
+
+/**
+ * Stops tracking a loan (it was returned or removed).
+ * Time Complexity: O(log n)
+ */
+void OverdueTracker::remove(BorrowRecord* record) {
+    unordered_map<BorrowRecord*, int>::iterator it = position.find(record);
+    if (it == position.end()) return;
+
+    int index = it->second;
+    int last = (int)heap.size() - 1;
+    if (index != last) swapSlots(index, last);
+    position.erase(record);
+    heap.pop_back();
+
+    // The moved entry may belong either higher or lower than its new slot
+    if (index < (int)heap.size()) {
+        siftUp(index);
+        siftDown(index);
+    }
+}
+
+void OverdueTracker::clear() {
+    heap.clear();
+    position.clear();
+}
+
+int OverdueTracker::size() const { return (int)heap.size(); }
+bool OverdueTracker::isEmpty() const { return heap.empty(); }
+
+Date OverdueTracker::earliestDue() const {
+    if (heap.empty()) return Date();
+    return Date::fromDays(heap[0].dueDay);
+}
+
+/**
+ * Depth-first walk that stops at any entry due on or after the limit; by the
+ * heap property nothing below it can be overdue either.
+ */
+void OverdueTracker::collectBefore(int index, int dayLimit, vector<BorrowRecord*>& out) const {
+    if (index >= (int)heap.size() || heap[index].dueDay >= dayLimit) return;
+    out.push_back(heap[index].record);
+    collectBefore(2 * index + 1, dayLimit, out);
+    collectBefore(2 * index + 2, dayLimit, out);
+}
+
+/**
+ * Collects every loan whose due date is before today, most overdue first.
+ * Time Complexity: O(k log k) for k overdue loans (O(k) to find, plus the sort)
+ */
+void OverdueTracker::findOverdue(const Date& today, vector<BorrowRecord*>& out) const {
+    size_t first = out.size();
+    collectBefore(0, today.getDays(), out);
+    sort(out.begin() + first, out.end(), [](const BorrowRecord* a, const BorrowRecord* b) {
+        return a->getBorrowDate() < b->getBorrowDate();
+    });
+}
@@ -0,0 +1,46 @@
+#ifndef OVERDUETRACKER_H
+#define OVERDUETRACKER_H
+
+#include "BorrowRecord.h"
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+/**
+ * Indexed binary min-heap of active loans keyed by due date.
+ * Each heap slot's position is tracked per record, so a return can remove
+ * its loan in O(log n) without searching. Overdue loans are always at the top
+ * of the heap, so a report visits only the overdue entries.
+ */
+class OverdueTracker {
+private:
+    struct Loan {
+        int dueDay;             // Date day number the game is due back
+        BorrowRecord* record;
+    };
+
+    vector<Loan> heap;
+    unordered_map<BorrowRecord*, int> position;  // record -> index in heap
+
+    void swapSlots(int a, int b);
+    void siftUp(int index);
+    void siftDown(int index);
+    void collectBefore(int index, int dayLimit, vector<BorrowRecord*>& out) const;
+
+public:
+    static const int LOAN_PERIOD_DAYS = 14;
+
+    static Date dueDateFor(const BorrowRecord& record);
+
+    void add(BorrowRecord* record);
+    void remove(BorrowRecord* record);
+    void clear();
+
+    int size() const;
+    bool isEmpty() const;
+    Date earliestDue() const;   // empty Date when nothing is on loan
+
+    void findOverdue(const Date& today, vector<BorrowRecord*>& out) const;
+};
+
+#endif
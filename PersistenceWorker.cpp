@@ -0,0 +1,266 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Write-Behind Saving: File writes happen on a background thread, so menu
+ * confirmations no longer wait on disk I/O.
+ * - Coalescing: Several changes to the same file within the coalescing
+ * window collapse into a single write of the newest snapshot.
+ * - Bounded Staleness: A change is written at most maxStalenessMs after it
+ * was made, even if new changes keep arriving.
+ * - Journal Checkpoints: Once every queued snapshot is written, the commit
+ * journal entries they cover are dropped.
+ * - Off-Thread Catalog Rendering: games.csv is rendered by the writer thread
+ * from the newest published catalog snapshot, inside a lock-free read section.
+ * - Binary Borrow Log: Records kept in the memory-mapped log are synced by
+ * the writer thread instead of re-rendering borrow_records.csv.
+ * - Flush Barrier: flush() and stop() block until everything queued is on
+ * disk, which main() relies on before exiting.
+ *****************************************************************************/
+
+#include "PersistenceWorker.h"
+#include "CSVHandler.h"
+#include "CatalogSnapshot.h"
+#include "BorrowLog.h"
+#include <iostream>
+using namespace std;
+
+/**
+ * Starts the background writer.
+ * @param coalesceWindowMs Quiet period to wait for more changes before writing.
+ * @param maxStaleness Upper bound (ms) on how long any change may stay unsaved.
+ * @param journalWindowMs Group-commit window of the journal (see CommitJournal).
+ */
+PersistenceWorker::PersistenceWorker(int coalesceWindowMs, int maxStaleness, int journalWindowMs)
+    : journal("journal.log", journalWindowMs) {
+    checkpointBlocked = false;
+    coalesceMs = coalesceWindowMs;
+    maxStalenessMs = maxStaleness;
+    writing = false;
+    flushRequested = false;
+    stopping = false;
+    changesQueued = 0;
+    filesWritten = 0;
+    writeFailures = 0;
+    journalFailuresReported = 0;
+    worker = thread(&PersistenceWorker::workerLoop, this);
+}
+
+/** Writes whatever is still queued and joins the thread. */
+PersistenceWorker::~PersistenceWorker() {
+    stop();
+}
+
+/**
+ * Replaces the queued snapshot for a target and wakes the writer.
+ * @param key Identifies the target (file, or file + user for history).
+ * @param write The snapshot to persist.
+ */
+void PersistenceWorker::enqueue(const string& key, const PendingWrite& write) {
+    long long lsn = journal.getLastLSN();
+    {
+        lock_guard<mutex> lock(stateMutex);
+        Clock::time_point now = Clock::now();
+        if (pending.empty()) firstDirty = now;
+        lastDirty = now;
+        pending[key] = write;
+        pending[key].coveredLSN = lsn;
+        changesQueued++;
+    }
+    wake.notify_one();
+}
+
+/**
+ * Queues games.csv. If the catalog publishes snapshots, the newest one
+ * already holds this change, so rendering is left to the writer thread.
+ */
+void PersistenceWorker::markGamesDirty(GameDynamicArray& games) {
+    CatalogVersions* snapshots = games.getSnapshots();
+    PendingWrite write = { "games.csv", "", (snapshots != nullptr) ? "" : CSVHandler::formatGames(games),
+                           false, 0, snapshots, nullptr };
+    enqueue("games.csv", write);
+}
+
+void PersistenceWorker::markUsersDirty(UserDynamicArray& users) {
+    PendingWrite write = { "users.csv", "", CSVHandler::formatUsers(users), false, 0, nullptr, nullptr };
+    enqueue("users.csv", write);
+}
+
+/**
+ * Queues borrow_records.csv, or, when the records live in a binary borrow
+ * log, a sync of the log (its entries were already updated in place).
+ */
+void PersistenceWorker::markRecordsDirty(BorrowLinkedList& records) {
+    if (records.getLog() != nullptr) {
+        PendingWrite sync = { records.getLog()->getFilename(), "", "", false, 0, nullptr, records.getLog() };
+        enqueue("borrow_records.csv", sync);
+        return;
+    }
+    PendingWrite write = { "borrow_records.csv", "", CSVHandler::formatBorrowRecords(records), false, 0, nullptr, nullptr };
+    enqueue("borrow_records.csv", write);
+}
+
+void PersistenceWorker::markReviewsDirty(GameDynamicArray& games) {
+    PendingWrite write = { "reviews.csv", "", CSVHandler::formatReviews(games), false, 0, nullptr, nullptr };
+    enqueue("reviews.csv", write);
+}
+
+void PersistenceWorker::markPlaySessionsDirty(PlayStats& stats) {
+    PendingWrite write = { "play_sessions.csv", "", CSVHandler::formatPlaySessions(stats), false, 0, nullptr, nullptr };
+    enqueue("play_sessions.csv", write);
+}
+
+/**
+ * Queues one user's browse history; other users' rows are merged back in
+ * when the file is written.
+ */
+void PersistenceWorker::markBrowseHistoryDirty(const string& userID, BrowseHistory& history) {
+    PendingWrite write = { "browse_history.csv", userID,
+                           CSVHandler::formatBrowseHistory(userID, history), true, 0, nullptr, nullptr };
+    enqueue("browse_history.csv|" + userID, write);
+}
+
+/** Logs a new borrow to the journal. */
+shared_future<bool> PersistenceWorker::logBorrow(const BorrowRecord& record) {
+    return journal.append(CSVHandler::formatBorrowEntry(record));
+}
+
+/** Logs a return (record must already carry its return date). */
+shared_future<bool> PersistenceWorker::logReturn(const BorrowRecord& record) {
+    return journal.append(CSVHandler::formatReturnEntry(record));
+}
+
+/**
+ * Logs a batch of borrows and returns in one journal append, so they become
+ * durable together. Records without a return date are logged as borrows,
+ * the rest as returns, in the given order.
+ */
+shared_future<bool> PersistenceWorker::logBorrowBatch(const vector<BorrowRecord>& changes) {
+    vector<string> payloads;
+    payloads.reserve(changes.size());
+    for (int i = 0; i < (int)changes.size(); i++) {
+        payloads.push_back(changes[i].isReturned() ? CSVHandler::formatReturnEntry(changes[i])
+                                                   : CSVHandler::formatBorrowEntry(changes[i]));
+    }
+    return journal.appendBatch(payloads);
+}
+
+/** Logs a new review. */
+shared_future<bool> PersistenceWorker::logReview(const string& gameID, const string& memberName,
+    int rating, const string& comment) {
+    return journal.append(CSVHandler::formatReviewEntry(gameID, memberName, rating, comment));
+}
+
+/**
+ * Drops every journal entry; only valid right after all CSV files were
+ * saved successfully (main() calls it after the final save).
+ */
+/**
+ * @return Journal entries that failed to commit since the last call (the
+ * changes themselves are still saved by the next snapshot write).
+ */
+long long PersistenceWorker::takeJournalFailures() {
+    long long failed = journal.getEntriesFailed();
+    long long fresh = failed - journalFailuresReported;
+    journalFailuresReported = failed;
+    return fresh;
+}
+
+void PersistenceWorker::checkpointJournal() {
+    journal.checkpoint(journal.getLastLSN());
+}
+
+/**
+ * Barrier: returns once every snapshot queued before the call is on disk.
+ */
+void PersistenceWorker::flush() {
+    unique_lock<mutex> lock(stateMutex);
+    if (pending.empty() && !writing) return;
+    flushRequested = true;
+    wake.notify_one();
+    idle.wait(lock, [this]() { return pending.empty() && !writing; });
+}
+
+/** Flushes, then stops and joins the writer thread. Safe to call twice. */
+void PersistenceWorker::stop() {
+    {
+        lock_guard<mutex> lock(stateMutex);
+        if (stopping) return;
+        stopping = true;
+    }
+    wake.notify_one();
+    if (worker.joinable()) worker.join();
+}
+
+/**
+ * Writer thread: waits for a quiet period (or the staleness deadline, a
+ * flush, or shutdown), takes every queued snapshot and writes them out.
+ */
+void PersistenceWorker::workerLoop() {
+    unique_lock<mutex> lock(stateMutex);
+    while (true) {
+        wake.wait(lock, [this]() { return stopping || !pending.empty(); });
+        if (pending.empty() && stopping) break;
+
+        while (!stopping && !flushRequested) {
+            Clock::time_point quietAt = lastDirty + chrono::milliseconds(coalesceMs);
+            Clock::time_point deadline = firstDirty + chrono::milliseconds(maxStalenessMs);
+            Clock::time_point writeAt = (quietAt < deadline) ? quietAt : deadline;
+            if (Clock::now() >= writeAt) break;
+            wake.wait_until(lock, writeAt);
+        }
+
+        map<string, PendingWrite> batch;
+        batch.swap(pending);
+        flushRequested = false;
+        writing = true;
+        lock.unlock();
+
+        int written = 0, failed = 0;
+        long long covered = 0;
+        for (map<string, PendingWrite>::iterator it = batch.begin(); it != batch.end(); ++it) {
+            const PendingWrite& write = it->second;
+            if (write.coveredLSN > covered) covered = write.coveredLSN;
+            bool ok;
+            if (write.borrowLog != nullptr) {
+                ok = write.borrowLog->sync();
+            }
+            else if (write.snapshots != nullptr) {
+                // At least as new as the change that queued it, so it still covers coveredLSN
+                string contents;
+                {
+                    CatalogVersions::Reader reader(*write.snapshots);
+                    contents = CSVHandler::formatGames(reader.snapshot());
+                }
+                ok = CSVHandler::writeFile(write.filename, contents);
+            }
+            else {
+                ok = write.mergeHistory
+                    ? CSVHandler::mergeBrowseHistory(write.filename, write.userID, write.contents)
+                    : CSVHandler::writeFile(write.filename, write.contents);
+            }
+            if (ok) written++;
+            else {
+                failed++;
+                cout << "\n[ERROR] Background save of " << write.filename << " failed.\n";
+            }
+        }
+
+        lock.lock();
+        filesWritten += written;
+        writeFailures += failed;
+        if (failed > 0) checkpointBlocked = true;
+        // Every snapshot taken so far is on disk, so the journal up to 'covered' is redundant
+        if (pending.empty() && !checkpointBlocked) journal.checkpoint(covered);
+        writing = false;
+        if (pending.empty()) idle.notify_all();
+    }
+    idle.notify_all();
+}
+
+int PersistenceWorker::getChangesQueued() const { return changesQueued; }
+int PersistenceWorker::getFilesWritten() const { return filesWritten; }
+int PersistenceWorker::getWriteFailures() const { return writeFailures; }
+long long PersistenceWorker::getJournalEntries() { return journal.getEntriesCommitted(); }
+long long PersistenceWorker::getJournalBatches() { return journal.getBatchesCommitted(); }
@@ -0,0 +1,112 @@
+#ifndef PERSISTENCEWORKER_H
+#define PERSISTENCEWORKER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#include "GameDynamicArray.h"
+#include "UserDynamicArray.h"
+#include "BorrowLinkedList.h"
+#include "BrowseHistory.h"
+#include "CommitJournal.h"
+#include "PlayStats.h"
+
+class CatalogVersions;
+class BorrowLog;
+
+/**
+ * Write-behind persistence thread.
+ * Menus call a mark*Dirty() method after each change; the snapshot is
+ * rendered in memory on the calling thread and handed to a background thread
+ * that writes it to disk. When the catalog publishes read-only versions
+ * (CatalogVersions), games.csv is rendered from the newest one on the
+ * background thread instead. With a binary borrow log attached to the records,
+ * borrow_records.csv is not rewritten at all; the writer thread syncs the
+ * log's mapping instead. Bursts of changes to the same file are coalesced so
+ * only the newest snapshot is written, and no change waits on disk longer than
+ * the staleness bound.
+ * Borrows, returns and reviews are additionally logged to a group-commit
+ * journal so they are durable right away; the journal is checkpointed once
+ * the snapshots that cover it have been written.
+ */
+class PersistenceWorker {
+private:
+    typedef chrono::steady_clock Clock;
+
+    struct PendingWrite {
+        string filename;
+        string userID;      // set for browse history merges
+        string contents;
+        bool mergeHistory;
+        long long coveredLSN;   // journal position this snapshot includes
+        CatalogVersions* snapshots; // set: render games.csv from the newest published version
+        BorrowLog* borrowLog;       // set: flush the binary borrow log instead of writing a file
+    };
+
+    CommitJournal journal;
+    bool checkpointBlocked;             // a snapshot write failed; keep the journal
+
+    map<string, PendingWrite> pending;  // newest snapshot per target
+    Clock::time_point firstDirty;       // oldest unsaved change
+    Clock::time_point lastDirty;        // newest unsaved change
+    int coalesceMs;
+    int maxStalenessMs;
+
+    thread worker;
+    mutex stateMutex;
+    condition_variable wake;
+    condition_variable idle;
+    bool writing;
+    bool flushRequested;
+    bool stopping;
+
+    int changesQueued;
+    int filesWritten;
+    int writeFailures;
+    long long journalFailuresReported;  // failed journal entries already reported
+
+    void enqueue(const string& key, const PendingWrite& write);
+    void workerLoop();
+
+public:
+    PersistenceWorker(int coalesceWindowMs = 200, int maxStaleness = 1000, int journalWindowMs = 2);
+    ~PersistenceWorker();
+
+    PersistenceWorker(const PersistenceWorker&) = delete;
+    PersistenceWorker& operator=(const PersistenceWorker&) = delete;
+
+    void markGamesDirty(GameDynamicArray& games);
+    void markUsersDirty(UserDynamicArray& users);
+    void markRecordsDirty(BorrowLinkedList& records);
+    void markReviewsDirty(GameDynamicArray& games);
+    void markBrowseHistoryDirty(const string& userID, BrowseHistory& history);
+    void markPlaySessionsDirty(PlayStats& stats);
+
+    // Durable logging; each future turns true once the entry is fsynced.
+    // Menus do not wait on single entries: failures are collected and
+    // reported by takeJournalFailures() at the next menu prompt.
+    shared_future<bool> logBorrow(const BorrowRecord& record);
+    shared_future<bool> logReturn(const BorrowRecord& record);
+    shared_future<bool> logBorrowBatch(const vector<BorrowRecord>& changes);
+    shared_future<bool> logReview(const string& gameID, const string& memberName,
+                                  int rating, const string& comment);
+    void checkpointJournal();   // call after a successful full save
+    long long takeJournalFailures();    // failed entries since the last call
+
+    void flush();   // blocks until every queued snapshot is on disk
+    void stop();    // flush, then shut the thread down
+
+    int getChangesQueued() const;
+    int getFilesWritten() const;
+    int getWriteFailures() const;
+    long long getJournalEntries();
+    long long getJournalBatches();
+};
+
+#endif
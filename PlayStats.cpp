@@ -0,0 +1,189 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Streaming Aggregates: Plays per game, wins per player and head-to-head
+ * results are hash-map counters bumped once per session, never recomputed.
+ * - Running Maximum: Partner counts only grow, so each player's most frequent
+ * partner is kept up to date with a single comparison per update.
+ * - Duplicate Guard: Session IDs are tracked in a hash set so a session that
+ * is loaded or entered twice is only counted once.
+ *****************************************************************************/
+
+#include "PlayStats.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+using namespace std;
+
+PlayStats::PlayStats() {
+    highestNumber = 0;
+}
+
+/**
+ * Stores a session and folds it into every aggregate.
+ * @param session Session to add; players must be distinct and the winner
+ * (if any) must be one of them.
+ * @return False if the session is invalid or its ID was already recorded.
+ * Time Complexity: O(p^2) for p players (O(1) average per pair)
+ */
+bool PlayStats::record(const PlaySession& session) {
+    if (session.sessionID.empty() || session.players.empty()) return false;
+    if (sessionIDs.count(session.sessionID)) return false;
+    for (size_t i = 0; i < session.players.size(); i++) {
+        for (size_t j = i + 1; j < session.players.size(); j++) {
+            if (session.players[i] == session.players[j]) return false;
+        }
+    }
+    if (!session.winnerID.empty() &&
+        find(session.players.begin(), session.players.end(), session.winnerID) == session.players.end()) {
+        return false;
+    }
+
+    sessions.push_back(session);
+    sessionIDs.insert(session.sessionID);
+    gamePlays[session.gameID]++;
+    noteSessionID(session.sessionID);
+
+    for (size_t i = 0; i < session.players.size(); i++) {
+        const string& player = session.players[i];
+        PlayerRecord& own = playerRecords[player];
+        own.plays++;
+        if (player == session.winnerID) own.wins++;
+
+        unordered_map<string, HeadToHead>& opponents = rivals[player];
+        Partner& best = bestPartners[player];
+        for (size_t j = 0; j < session.players.size(); j++) {
+            if (i == j) continue;
+            const string& other = session.players[j];
+            HeadToHead& result = opponents[other];
+            result.played++;
+            if (player == session.winnerID) result.wins++;
+            else if (other == session.winnerID) result.losses++;
+
+            // Ties go to the partner with the smaller ID so reports are stable
+            if (result.played > best.sessions || (result.played == best.sessions && other < best.userID)) {
+                best.userID = other;
+                best.sessions = result.played;
+            }
+        }
+    }
+    return true;
+}
+
+/** @return An unused session ID following the highest one seen ("PS002" after "PS001"). */
+/**
+ * Keeps a file row that record() refused, so the next save writes it back
+ * instead of dropping it. It counts towards no aggregate, but its ID is
+ * still reserved.
+ */
+void PlayStats::keepRejected(const PlaySession& session) {
+    rejected.push_back(session);
+    noteSessionID(session.sessionID);
+}
+
+// Keeps the numeric part of IDs like "PS042" so new IDs never collide
+void PlayStats::noteSessionID(const string& sessionID) {
+    size_t digits = sessionID.size();
+    while (digits > 0 && isdigit((unsigned char)sessionID[digits - 1])) digits--;
+    if (digits < sessionID.size()) {
+        int number = atoi(sessionID.c_str() + digits);
+        if (number > highestNumber) highestNumber = number;
+    }
+}
+
+string PlayStats::nextSessionID() const {
+    int number = highestNumber + 1;
+    string id = "PS";
+    if (number < 100) id += "0";
+    if (number < 10) id += "0";
+    return id + to_string(number);
+}
+
+int PlayStats::getSessionCount() const { return (int)sessions.size(); }
+
+/** @return Every session in the order it was recorded. */
+const vector<PlaySession>& PlayStats::getSessions() const { return sessions; }
+
+/** @return Rows loaded from the file that were invalid or duplicated. */
+const vector<PlaySession>& PlayStats::getRejected() const { return rejected; }
+
+int PlayStats::getPlays(const string& gameID) const {
+    unordered_map<string, int>::const_iterator it = gamePlays.find(gameID);
+    return (it == gamePlays.end()) ? 0 : it->second;
+}
+
+PlayStats::PlayerRecord PlayStats::getPlayerRecord(const string& userID) const {
+    unordered_map<string, PlayerRecord>::const_iterator it = playerRecords.find(userID);
+    if (it == playerRecords.end()) {
+        PlayerRecord none = { 0, 0 };
+        return none;
+    }
+    return it->second;
+}
+
+/** @return Fraction of the player's sessions they won (0 if they never played). */
+double PlayStats::getWinRate(const string& userID) const {
+    PlayerRecord r = getPlayerRecord(userID);
+    return (r.plays == 0) ? 0.0 : (double)r.wins / r.plays;
+}
+
+PlayStats::HeadToHead PlayStats::getHeadToHead(const string& userID, const string& otherID) const {
+    HeadToHead none = { 0, 0, 0 };
+    unordered_map<string, unordered_map<string, HeadToHead>>::const_iterator row = rivals.find(userID);
+    if (row == rivals.end()) return none;
+    unordered_map<string, HeadToHead>::const_iterator cell = row->second.find(otherID);
+    return (cell == row->second.end()) ? none : cell->second;
+}
+
+/**
+ * @param out Receives the player the user has shared the most sessions with.
+ * @return False if the user has never played with anyone.
+ */
+bool PlayStats::getBestPartner(const string& userID, Partner& out) const {
+    unordered_map<string, Partner>::const_iterator it = bestPartners.find(userID);
+    if (it == bestPartners.end() || it->second.sessions == 0) return false;
+    out = it->second;
+    return true;
+}
+
+/** Appends up to k most played games, most plays first (ties by game ID). */
+void PlayStats::topGames(int k, vector<pair<string, int>>& out) const {
+    vector<pair<string, int>> ranked(gamePlays.begin(), gamePlays.end());
+    if (k > (int)ranked.size()) k = (int)ranked.size();
+    partial_sort(ranked.begin(), ranked.begin() + k, ranked.end(),
+        [](const pair<string, int>& a, const pair<string, int>& b) {
+            if (a.second != b.second) return a.second > b.second;
+            return a.first < b.first;
+        });
+    out.insert(out.end(), ranked.begin(), ranked.begin() + k);
+}
+
+/** Appends every player's record, best win rate first (ties by more plays, then ID). */
+void PlayStats::playersByWinRate(vector<pair<string, PlayerRecord>>& out) const {
+    size_t first = out.size();
+    out.insert(out.end(), playerRecords.begin(), playerRecords.end());
+    sort(out.begin() + first, out.end(),
+        [](const pair<string, PlayerRecord>& a, const pair<string, PlayerRecord>& b) {
+            // Compare wins/plays without dividing
+            long long left = (long long)a.second.wins * b.second.plays;
+            long long right = (long long)b.second.wins * a.second.plays;
+            if (left != right) return left > right;
+            if (a.second.plays != b.second.plays) return a.second.plays > b.second.plays;
+            return a.first < b.first;
+        });
+}
+
+/** Appends the user's head-to-head record against everyone they played, most sessions first. */
+void PlayStats::opponentsOf(const string& userID, vector<pair<string, HeadToHead>>& out) const {
+    unordered_map<string, unordered_map<string, HeadToHead>>::const_iterator row = rivals.find(userID);
+    if (row == rivals.end()) return;
+    size_t first = out.size();
+    out.insert(out.end(), row->second.begin(), row->second.end());
+    sort(out.begin() + first, out.end(),
+        [](const pair<string, HeadToHead>& a, const pair<string, HeadToHead>& b) {
+            if (a.second.played != b.second.played) return a.second.played > b.second.played;
+            return a.first < b.first;
+        });
+}
@@ -0,0 +1,81 @@
+#ifndef PLAYSTATS_H
+#define PLAYSTATS_H
+
+#include "Date.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+// One play_sessions.csv row
+struct PlaySession {
+    string sessionID;
+    string gameID;
+    Date date;
+    vector<string> players;     // user IDs, stored pipe-separated in the CSV
+    string winnerID;            // empty when nobody won (e.g. a co-op loss)
+};
+
+/**
+ * In-memory store of play sessions with streaming aggregates.
+ * Every aggregate (plays per game, wins per player, head-to-head records and
+ * each player's most frequent partner) is updated as a session is recorded,
+ * so reports never rescan the session list. Recording costs O(p^2) for a
+ * table of p players, i.e. constant for any realistic table size.
+ */
+class PlayStats {
+public:
+    struct PlayerRecord {
+        int plays;
+        int wins;
+    };
+
+    // Results between two players, seen from the first player's side
+    struct HeadToHead {
+        int played;
+        int wins;
+        int losses;
+    };
+
+    struct Partner {
+        string userID;
+        int sessions;
+    };
+
+private:
+    vector<PlaySession> sessions;
+    vector<PlaySession> rejected;   // file rows record() refused; saved back unchanged
+    unordered_set<string> sessionIDs;
+    unordered_map<string, int> gamePlays;
+    unordered_map<string, PlayerRecord> playerRecords;
+    unordered_map<string, unordered_map<string, HeadToHead>> rivals;   // user -> other -> record
+    unordered_map<string, Partner> bestPartners;
+    int highestNumber;      // largest numeric suffix seen in a session ID
+
+    void noteSessionID(const string& sessionID);
+
+public:
+    PlayStats();
+
+    bool record(const PlaySession& session);
+    void keepRejected(const PlaySession& session);
+    string nextSessionID() const;
+
+    int getSessionCount() const;
+    const vector<PlaySession>& getSessions() const;
+    const vector<PlaySession>& getRejected() const;
+
+    int getPlays(const string& gameID) const;
+    PlayerRecord getPlayerRecord(const string& userID) const;
+    double getWinRate(const string& userID) const;
+    HeadToHead getHeadToHead(const string& userID, const string& otherID) const;
+    bool getBestPartner(const string& userID, Partner& out) const;
+
+    // Report helpers (sorted copies of the aggregates)
+    void topGames(int k, vector<pair<string, int>>& out) const;
+    void playersByWinRate(vector<pair<string, PlayerRecord>>& out) const;
+    void opponentsOf(const string& userID, vector<pair<string, HeadToHead>>& out) const;
+};
+
+#endif
@@ -0,0 +1,262 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Incremental Counters: Each borrow updates its game's counters in O(1)
+ * average time plus O(log K) for the leaderboard heaps.
+ * - Indexed Top-K Heaps: The K best games are kept in a min-heap with a
+ * position index, so reading a leaderboard is O(K log K) regardless of how
+ * many borrows or games exist.
+ * - Time-Decayed Trending: Borrows are weighted relative to a fixed base day,
+ * which gives the same ranking as decaying every score each day without ever
+ * touching games that were not borrowed.
+ * - Distinct Borrowers: A HyperLogLog per game estimates how many different
+ * members borrowed it in fixed memory; merging them covers several games.
+ *****************************************************************************/
+
+#include "PopularityBoard.h"
+#include "MemoryFootprint.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+using namespace std;
+
+// Weights are rebased before 2^exponent gets anywhere near overflowing a double
+static const double MAX_EXPONENT = 512.0;
+
+// --- TOP-K HEAP ---
+
+void PopularityBoard::TopK::swapSlots(int a, int b) {
+    Entry temp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = temp;
+    slot[heap[a].gameID] = a;
+    slot[heap[b].gameID] = b;
+}
+
+void PopularityBoard::TopK::siftUp(int index) {
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (heap[parent].score <= heap[index].score) break;
+        swapSlots(parent, index);
+        index = parent;
+    }
+}
+
+void PopularityBoard::TopK::siftDown(int index) {
+    int n = (int)heap.size();
+    while (true) {
+        int smallest = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+        if (left < n && heap[left].score < heap[smallest].score) smallest = left;
+        if (right < n && heap[right].score < heap[smallest].score) smallest = right;
+        if (smallest == index) break;
+        swapSlots(smallest, index);
+        index = smallest;
+    }
+}
+
+/**
+ * Reports a game's new (higher) score.
+ * Time Complexity: O(log K)
+ */
+void PopularityBoard::TopK::offer(const string& gameID, double score) {
+    unordered_map<string, int>::iterator it = slot.find(gameID);
+    if (it != slot.end()) {
+        // Already ranked: its score grew, so it can only move away from the minimum
+        heap[it->second].score = score;
+        siftDown(it->second);
+        return;
+    }
+
+    Entry entry = { gameID, score };
+    if ((int)heap.size() < CAPACITY) {
+        heap.push_back(entry);
+        slot[gameID] = (int)heap.size() - 1;
+        siftUp((int)heap.size() - 1);
+    }
+    else if (score > heap[0].score) {
+        // Replace the weakest ranked game
+        slot.erase(heap[0].gameID);
+        heap[0] = entry;
+        slot[gameID] = 0;
+        siftDown(0);
+    }
+}
+
+/** Multiplies every score by the same factor (ordering is unchanged). */
+void PopularityBoard::TopK::scaleAll(double factor) {
+    for (int i = 0; i < (int)heap.size(); i++) heap[i].score *= factor;
+}
+
+/**
+ * Copies the k best entries, highest score first (ties by game ID).
+ * Time Complexity: O(K log K)
+ */
+void PopularityBoard::TopK::read(int k, vector<Entry>& out) const {
+    vector<Entry> ranked(heap);
+    sort(ranked.begin(), ranked.end(), [](const Entry& a, const Entry& b) {
+        if (a.score != b.score) return a.score > b.score;
+        return a.gameID < b.gameID;
+    });
+    for (int i = 0; i < (int)ranked.size() && i < k; i++) out.push_back(ranked[i]);
+}
+
+// --- BOARD ---
+
+PopularityBoard::PopularityBoard() {
+    baseDay = 0;
+    hasBase = false;
+}
+
+/**
+ * Weight of one borrow on the given day, relative to baseDay.
+ * Rebases every stored weight (O(games)) in the rare case the exponent grows
+ * too large; the ranking is unaffected because all weights scale together.
+ */
+double PopularityBoard::weightFor(const Date& day) {
+    if (!hasBase) {
+        baseDay = day.getDays();
+        hasBase = true;
+    }
+    double exponent = (double)(day.getDays() - baseDay) / HALF_LIFE_DAYS;
+    if (exponent > MAX_EXPONENT) {
+        double factor = pow(2.0, -exponent);
+        for (unordered_map<string, double>::iterator it = trendWeights.begin(); it != trendWeights.end(); ++it) {
+            it->second *= factor;
+        }
+        trending.scaleAll(factor);
+        baseDay = day.getDays();
+        exponent = 0;
+    }
+    return pow(2.0, exponent);
+}
+
+/**
+ * Counts one borrow towards both leaderboards and the game's distinct borrowers.
+ * @param gameID Game that was borrowed.
+ * @param userID Member who borrowed it.
+ * @param borrowDate Day of the borrow (drives the trending weight).
+ */
+void PopularityBoard::recordBorrow(const string& gameID, const string& userID, const Date& borrowDate) {
+    recordBorrows(gameID, borrowDate, 1);
+    recordBorrower(gameID, userID);
+}
+
+/**
+ * Counts several borrows of one game on one day towards both leaderboards
+ * (used with the archive's pre-aggregated counts).
+ * @param gameID Game that was borrowed.
+ * @param borrowDate Day of the borrows (drives the trending weight).
+ * @param count Number of borrows.
+ */
+void PopularityBoard::recordBorrows(const string& gameID, const Date& borrowDate, int count) {
+    int total = (borrowCounts[gameID] += count);
+    mostBorrowed.offer(gameID, total);
+
+    if (borrowDate.isEmpty()) return;
+    double& weight = trendWeights[gameID];
+    weight += count * weightFor(borrowDate);
+    trending.offer(gameID, weight);
+}
+
+/** Adds a member to a game's distinct-borrower counter (repeats are harmless). */
+void PopularityBoard::recordBorrower(const string& gameID, const string& userID) {
+    borrowers[gameID].add(userID);
+}
+
+int PopularityBoard::getBorrowCount(const string& gameID) const {
+    unordered_map<string, int>::const_iterator it = borrowCounts.find(gameID);
+    return (it == borrowCounts.end()) ? 0 : it->second;
+}
+
+/**
+ * @return Approximate number of different members who ever borrowed a game.
+ * Time Complexity: O(HyperLogLog::REGISTERS)
+ */
+double PopularityBoard::estimateDistinctBorrowers(const string& gameID) const {
+    unordered_map<string, HyperLogLog>::const_iterator it = borrowers.find(gameID);
+    return (it == borrowers.end()) ? 0 : it->second.estimate();
+}
+
+/**
+ * @return Approximate number of different members who borrowed at least one
+ * of the games (a member who borrowed several of them counts once).
+ * Time Complexity: O(g * HyperLogLog::REGISTERS) for g games
+ */
+double PopularityBoard::estimateDistinctBorrowers(const vector<string>& gameIDs) const {
+    HyperLogLog combined;
+    for (int i = 0; i < (int)gameIDs.size(); i++) {
+        unordered_map<string, HyperLogLog>::const_iterator it = borrowers.find(gameIDs[i]);
+        if (it != borrowers.end()) combined.merge(it->second);
+    }
+    return combined.estimate();
+}
+
+/** @return Bytes held by the distinct-borrower counters (a fixed amount per game). */
+size_t PopularityBoard::sketchMemoryUsage() const {
+    size_t bytes = hashMapHeapBytes(borrowers);
+    for (unordered_map<string, HyperLogLog>::const_iterator it = borrowers.begin(); it != borrowers.end(); ++it) {
+        bytes += stringHeapBytes(it->first);
+    }
+    return bytes;
+}
+
+/** Appends every game's distinct-borrower counter: count, then (ID length, ID, registers). */
+void PopularityBoard::writeBorrowerSketches(string& out) const {
+    int count = (int)borrowers.size();
+    out.append((const char*)&count, sizeof(count));
+    for (unordered_map<string, HyperLogLog>::const_iterator it = borrowers.begin(); it != borrowers.end(); ++it) {
+        int length = (int)it->first.size();
+        out.append((const char*)&length, sizeof(length));
+        out += it->first;
+        it->second.writeTo(out);
+    }
+}
+
+/**
+ * Merges counters written by writeBorrowerSketches into the current ones
+ * (merging is a union, so members already counted are not counted twice).
+ * @return False (nothing merged) if the bytes are cut short or malformed.
+ */
+bool PopularityBoard::readBorrowerSketches(const string& in, size_t& pos) {
+    size_t at = pos;
+    int count;
+    if (at + sizeof(count) > in.size()) return false;
+    memcpy(&count, in.data() + at, sizeof(count));
+    at += sizeof(count);
+    if (count < 0) return false;
+
+    vector<pair<string, HyperLogLog>> loaded;
+    for (int i = 0; i < count; i++) {
+        int length;
+        if (at + sizeof(length) > in.size()) return false;
+        memcpy(&length, in.data() + at, sizeof(length));
+        at += sizeof(length);
+        if (length < 0 || at + length > in.size()) return false;
+        loaded.push_back(make_pair(in.substr(at, length), HyperLogLog()));
+        at += length;
+        if (!loaded.back().second.readFrom(in, at)) return false;
+    }
+    for (int i = 0; i < (int)loaded.size(); i++) borrowers[loaded[i].first].merge(loaded[i].second);
+    pos = at;
+    return true;
+}
+
+/** Appends up to k games with the most borrows of all time. */
+void PopularityBoard::topBorrowed(int k, vector<Entry>& out) const {
+    mostBorrowed.read(k, out);
+}
+
+/**
+ * Appends up to k trending games. Scores are converted to "decayed borrows
+ * as of today": a borrow today counts 1, one a half-life ago counts 0.5.
+ */
+void PopularityBoard::topTrending(int k, const Date& today, vector<Entry>& out) const {
+    size_t first = out.size();
+    trending.read(k, out);
+    double scale = pow(2.0, -(double)(today.getDays() - baseDay) / HALF_LIFE_DAYS);
+    for (size_t i = first; i < out.size(); i++) out[i].score *= scale;
+}
@@ -0,0 +1,79 @@
+#ifndef POPULARITYBOARD_H
+#define POPULARITYBOARD_H
+
+#include "Date.h"
+#include "StreamSketches.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+/**
+ * Incrementally maintained "most borrowed" and "trending" leaderboards.
+ * Every borrow bumps a per-game counter and an exponentially time-decayed
+ * trending weight; each board keeps its top entries in a small indexed
+ * min-heap, so reading a board never walks the borrow history.
+ * Each game also has a fixed-size HyperLogLog of the members who borrowed it,
+ * for approximate distinct-borrower counts.
+ */
+class PopularityBoard {
+public:
+    struct Entry {
+        string gameID;
+        double score;   // borrow count, or trending score as of the query date
+    };
+
+    static const int CAPACITY = 10;         // largest K that can be read
+    static const int HALF_LIFE_DAYS = 7;    // trending weight halves every week
+
+private:
+    /**
+     * Indexed min-heap of the CAPACITY highest scores. Valid because scores
+     * only ever grow: a game outside the heap can only enter by beating the
+     * current minimum.
+     */
+    class TopK {
+    private:
+        vector<Entry> heap;
+        unordered_map<string, int> slot;
+
+        void swapSlots(int a, int b);
+        void siftDown(int index);
+        void siftUp(int index);
+
+    public:
+        void offer(const string& gameID, double score);
+        void scaleAll(double factor);
+        void read(int k, vector<Entry>& out) const;
+    };
+
+    unordered_map<string, int> borrowCounts;
+    unordered_map<string, double> trendWeights;  // sum of 2^((day - baseDay) / HALF_LIFE_DAYS)
+    unordered_map<string, HyperLogLog> borrowers;   // members who borrowed each game
+    int baseDay;
+    bool hasBase;
+    TopK mostBorrowed;
+    TopK trending;
+
+    double weightFor(const Date& day);
+
+public:
+    PopularityBoard();
+
+    void recordBorrow(const string& gameID, const string& userID, const Date& borrowDate);
+    void recordBorrows(const string& gameID, const Date& borrowDate, int count);
+    void recordBorrower(const string& gameID, const string& userID);
+
+    int getBorrowCount(const string& gameID) const;
+    double estimateDistinctBorrowers(const string& gameID) const;
+    double estimateDistinctBorrowers(const vector<string>& gameIDs) const;
+    size_t sketchMemoryUsage() const;
+
+    // Distinct-borrower counters in binary form, saved between runs
+    void writeBorrowerSketches(string& out) const;
+    bool readBorrowerSketches(const string& in, size_t& pos);
+    void topBorrowed(int k, vector<Entry>& out) const;
+    void topTrending(int k, const Date& today, vector<Entry>& out) const;
+};
+
+#endif
@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - LRU Eviction: A doubly linked list ordered by last use, indexed by a hash
+ * map, makes lookup, store and eviction O(1).
+ * - Version Stamps: Entries record the catalog and availability versions they
+ * were computed at, so staleness is one comparison per lookup and nothing is
+ * flushed eagerly.
+ * - Compact Entries: Results are kept as 8-byte game handles under a total
+ * handle budget, and resolved back to games on a hit.
+ *****************************************************************************/
+
+#include "QueryCache.h"
+#include "QueryEngine.h"
+#include "MemoryFootprint.h"
+#include <sstream>
+using namespace std;
+
+QueryCache::QueryCache() {
+    head = tail = nullptr;
+    handleCount = 0;
+    hits = misses = stale = evictions = 0;
+}
+
+QueryCache::~QueryCache() {
+    clear();
+}
+
+/**
+ * Normalized form of a query: two queries with the same key always have the
+ * same result. Title text is compared case-insensitively, so it is lowercased;
+ * the page is ignored when everything is on one page.
+ */
+string QueryCache::keyFor(const GameQuery& query) {
+    stringstream key;
+    key << "p" << (query.players > 0 ? query.players : 0)
+        << "|y" << query.yearFrom << '-' << query.yearTo
+        << "|m" << (query.maxPlayTime > 0 ? query.maxPlayTime : 0)
+        << "|a" << (query.availableOnly ? 1 : 0)
+        << "|r" << (query.minRating > 0 ? query.minRating : 0)
+        << "|s" << (int)query.sortKey << (query.descending ? 'd' : 'a')
+        << "|g" << (query.pageSize > 0 ? query.pageSize : 0) << '/'
+        << (query.pageSize > 0 && query.page > 0 ? query.page : 0)
+        << "|t" << QueryEngine::toLower(query.titleText);
+    return key.str();
+}
+
+/** @return True if the result can change when copies or ratings change. */
+bool QueryCache::readsAvailability(const GameQuery& query) {
+    return query.availableOnly || query.minRating > 0 ||
+           query.sortKey == GameQuery::BY_AVAILABLE || query.sortKey == GameQuery::BY_RATING;
+}
+
+void QueryCache::unlink(Node* node) {
+    if (node->prev != nullptr) node->prev->next = node->next;
+    else head = node->next;
+    if (node->next != nullptr) node->next->prev = node->prev;
+    else tail = node->prev;
+    node->prev = node->next = nullptr;
+}
+
+void QueryCache::pushFront(Node* node) {
+    node->prev = nullptr;
+    node->next = head;
+    if (head != nullptr) head->prev = node;
+    head = node;
+    if (tail == nullptr) tail = node;
+}
+
+void QueryCache::erase(Node* node) {
+    unlink(node);
+    lookup.erase(node->key);
+    handleCount -= (long long)node->entry.games.size();
+    delete node;
+}
+
+/**
+ * Looks up a query result computed at the current versions.
+ * A stale entry is removed and counted as a miss.
+ * @return The entry (valid until the next store), or nullptr on a miss.
+ * Time Complexity: O(|key|)
+ */
+const QueryCache::Entry* QueryCache::find(const string& key, unsigned long long catalogVersion,
+                                          unsigned long long availabilityVersion) {
+    unordered_map<string, Node*>::iterator it = lookup.find(key);
+    if (it == lookup.end()) {
+        misses++;
+        return nullptr;
+    }
+    Node* node = it->second;
+    if (node->catalogVersion != catalogVersion ||
+        (node->availabilityDependent && node->availabilityVersion != availabilityVersion)) {
+        erase(node);
+        stale++;
+        misses++;
+        return nullptr;
+    }
+    unlink(node);
+    pushFront(node);
+    hits++;
+    return &node->entry;
+}
+
+/**
+ * Caches a result, evicting the least recently used entries while the cache
+ * is over MAX_ENTRIES or MAX_HANDLES. Results larger than a quarter of the
+ * handle budget are not cached.
+ * @param availabilityDependent Whether the result reads copies or ratings.
+ */
+void QueryCache::store(const string& key, bool availabilityDependent, unsigned long long catalogVersion,
+                       unsigned long long availabilityVersion, const Entry& entry) {
+    if ((long long)entry.games.size() > MAX_HANDLES / 4) return;
+
+    unordered_map<string, Node*>::iterator it = lookup.find(key);
+    if (it != lookup.end()) erase(it->second);
+
+    Node* node = new Node();
+    node->key = key;
+    node->entry = entry;
+    node->availabilityDependent = availabilityDependent;
+    node->catalogVersion = catalogVersion;
+    node->availabilityVersion = availabilityVersion;
+    node->prev = node->next = nullptr;
+    pushFront(node);
+    lookup[key] = node;
+    handleCount += (long long)entry.games.size();
+
+    while ((int)lookup.size() > MAX_ENTRIES || handleCount > MAX_HANDLES) {
+        erase(tail);
+        evictions++;
+    }
+}
+
+/** Drops every entry (statistics are kept). */
+void QueryCache::clear() {
+    while (head != nullptr) erase(head);
+}
+
+void QueryCache::getStats(Stats& out) const {
+    out.hits = hits;
+    out.misses = misses;
+    out.stale = stale;
+    out.evictions = evictions;
+    out.entries = (int)lookup.size();
+    out.handles = handleCount;
+}
+
+/** @return Approximate heap bytes used by the entries and the key map. */
+size_t QueryCache::memoryUsage() const {
+    size_t bytes = hashMapHeapBytes(lookup);
+    for (const Node* node = head; node != nullptr; node = node->next) {
+        bytes += sizeof(Node) + 2 * stringHeapBytes(node->key) + vectorHeapBytes(node->entry.games) +
+                 stringHeapBytes(node->entry.plan);
+    }
+    return bytes;
+}
@@ -0,0 +1,88 @@
+#ifndef QUERYCACHE_H
+#define QUERYCACHE_H
+
+#include "GameDynamicArray.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+struct GameQuery;
+
+/**
+ * LRU cache of query results, keyed by a normalized form of the query.
+ * An entry keeps the requested page as game handles (8 bytes per game) plus
+ * the match and page counts, and is stamped with the catalog's version
+ * counters when stored. The catalog version changes whenever games are added
+ * or removed; the availability version whenever copies are borrowed or
+ * returned or a rating changes. A lookup compares the stamps in O(1), so a
+ * stale entry is dropped when it is next asked for instead of the whole cache
+ * being flushed. Queries that do not read availability or ratings ignore the
+ * availability version and survive borrows and returns.
+ * Entries are kept in a doubly linked list, most recently used first, with a
+ * hash map from key to node; lookup, store and eviction are all O(1).
+ */
+class QueryCache {
+public:
+    static const int MAX_ENTRIES = 256;
+    static const int MAX_HANDLES = 1 << 20;     // total handles held (8 MB)
+
+    struct Entry {
+        vector<GameDynamicArray::Handle> games;     // the cached page, in order
+        int totalMatches;
+        int pageCount;
+        string plan;
+    };
+
+    struct Stats {
+        long long hits;
+        long long misses;       // includes stale entries
+        long long stale;        // misses caused by a version change
+        long long evictions;
+        int entries;
+        long long handles;
+    };
+
+    QueryCache();
+    ~QueryCache();
+
+    QueryCache(const QueryCache&) = delete;
+    QueryCache& operator=(const QueryCache&) = delete;
+
+    static string keyFor(const GameQuery& query);
+    static bool readsAvailability(const GameQuery& query);
+
+    const Entry* find(const string& key, unsigned long long catalogVersion, unsigned long long availabilityVersion);
+    void store(const string& key, bool availabilityDependent, unsigned long long catalogVersion,
+               unsigned long long availabilityVersion, const Entry& entry);
+    void clear();
+
+    void getStats(Stats& out) const;
+    size_t memoryUsage() const;     // approximate heap bytes (see MemoryFootprint.h)
+
+private:
+    struct Node {
+        string key;
+        Entry entry;
+        bool availabilityDependent;
+        unsigned long long catalogVersion;
+        unsigned long long availabilityVersion;
+        Node* prev;
+        Node* next;
+    };
+
+    Node* head;     // most recently used
+    Node* tail;     // least recently used
+    unordered_map<string, Node*> lookup;
+    long long handleCount;
+    long long hits;
+    long long misses;
+    long long stale;
+    long long evictions;
+
+    void unlink(Node* node);
+    void pushFront(Node* node);
+    void erase(Node* node);
+};
+
+#endif
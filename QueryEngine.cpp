@@ -0,0 +1,446 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Cost-Based Planning: Every indexed predicate estimates its match count
+ * from sorted keys or trigram postings; the most selective one drives the
+ * query.
+ * - Bitmap Intersection: Further indexed predicates are ANDed in 64 games at
+ * a time when that is cheaper than checking each remaining candidate.
+ * - Range Box: Two or more of players, year and play time are answered together
+ * by one k-d tree descent instead of intersecting a list per predicate.
+ * - Trigram Index: Title substrings are narrowed to the games containing the
+ * query's rarest three-letter sequence before any string is compared.
+ * - Parallel Scans: Index keys are extracted and sorted on the shared thread
+ * pool, and large candidate sets are checked in parallel blocks.
+ * - Ordered Pagination: Only the games up to the end of the requested page
+ * are sorted (partial sort).
+ *****************************************************************************/
+
+#include "QueryEngine.h"
+#include "Game.h"
+#include "GameDynamicArray.h"
+#include "MemoryFootprint.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <functional>
+#include <sstream>
+using namespace std;
+
+// Games per task when extracting index keys
+static const int PARALLEL_GRAIN = 2048;
+// Bitmap words per residual block (64 games each), and the candidate count
+// below which the residual check stays on the calling thread
+static const int BLOCK_WORDS = 64;
+static const int PARALLEL_CANDIDATES = 8192;
+
+GameQuery::GameQuery() {
+    players = 0;
+    yearFrom = yearTo = 0;
+    maxPlayTime = 0;
+    availableOnly = false;
+    minRating = 0;
+    sortKey = BY_TITLE;
+    descending = false;
+    page = 0;
+    pageSize = 0;
+}
+
+QueryEngine::QueryEngine(GameDynamicArray& catalog) : games(catalog) {
+    stale = true;
+    pool = nullptr;
+}
+
+/** Lets index rebuilds and large candidate scans use a thread pool (nullptr = serial). */
+void QueryEngine::attachThreadPool(ThreadPool* workers) {
+    pool = workers;
+}
+
+/** Called by the catalog whenever games are added, removed or reordered. */
+void QueryEngine::markStale() {
+    stale = true;
+}
+
+string QueryEngine::toLower(const string& text) {
+    string lower = text;
+    for (char& c : lower) c = (char)tolower((unsigned char)c);
+    return lower;
+}
+
+/** @return The game's longest play time in minutes (its shortest if only that is known, 0 if unknown). */
+int QueryEngine::playTimeKey(const Game& game) {
+    return (game.getMaxPlayTime() > 0) ? game.getMaxPlayTime() : game.getMinPlayTime();
+}
+
+static unsigned int trigramKey(const string& text, size_t at) {
+    return ((unsigned int)(unsigned char)text[at] << 16) |
+           ((unsigned int)(unsigned char)text[at + 1] << 8) |
+           (unsigned int)(unsigned char)text[at + 2];
+}
+
+/**
+ * Rebuilds every index from the current catalog order. Keys are extracted
+ * per game in parallel, then the sorts, the k-d tree and the trigram
+ * postings are built as independent jobs.
+ * Time Complexity: O(n log n + total title length)
+ */
+void QueryEngine::rebuild() {
+    int n = games.size();
+    byMinPlayers.assign(n, make_pair(0, 0));
+    byMaxPlayers.assign(n, make_pair(0, 0));
+    byYear.assign(n, make_pair(0, 0));
+    byPlayTime.clear();
+    trigrams.clear();
+    lowerTitles.assign(n, string());
+    vector<KdTree::Point> points(n);
+
+    parallelFor(pool, 0, n, PARALLEL_GRAIN, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            const Game& g = games.get(i);
+            byMinPlayers[i] = make_pair(g.getMinPlayers(), i);
+            byMaxPlayers[i] = make_pair(g.getMaxPlayers(), i);
+            byYear[i] = make_pair(g.getYear(), i);
+
+            KdTree::Point& point = points[i];
+            point.key[0] = g.getMinPlayers();
+            point.key[1] = g.getMaxPlayers();
+            point.key[2] = g.getYear();
+            point.key[3] = playTimeKey(g);
+            point.position = i;
+
+            lowerTitles[i] = toLower(g.getTitle());
+        }
+    });
+    for (int i = 0; i < n; i++) {
+        if (points[i].key[3] > 0) byPlayTime.push_back(make_pair(points[i].key[3], i));
+    }
+
+    // Each job writes a different index, so they can run side by side
+    vector<function<void()>> jobs;
+    jobs.push_back([this]() { sort(byMinPlayers.begin(), byMinPlayers.end()); });
+    jobs.push_back([this]() { sort(byMaxPlayers.begin(), byMaxPlayers.end()); });
+    jobs.push_back([this]() { sort(byYear.begin(), byYear.end()); });
+    jobs.push_back([this]() { sort(byPlayTime.begin(), byPlayTime.end()); });
+    jobs.push_back([this, &points]() { rangeTree.build(points); });
+    jobs.push_back([this, n]() {
+        for (int i = 0; i < n; i++) {
+            const string& title = lowerTitles[i];
+            for (size_t at = 0; at + 3 <= title.size(); at++) {
+                vector<int>& postings = trigrams[trigramKey(title, at)];
+                if (postings.empty() || postings.back() != i) postings.push_back(i);
+            }
+        }
+    });
+    parallelFor(pool, 0, (int)jobs.size(), 1, [&](int first, int last) {
+        for (int j = first; j < last; j++) jobs[j]();
+    });
+    stale = false;
+}
+
+/** Number of entries whose key is in [low, high]. */
+static int countRange(const vector<pair<int, int>>& index, int low, int high) {
+    vector<pair<int, int>>::const_iterator first = lower_bound(index.begin(), index.end(), make_pair(low, INT_MIN));
+    vector<pair<int, int>>::const_iterator last = upper_bound(index.begin(), index.end(), make_pair(high, INT_MAX));
+    return (int)(last - first);
+}
+
+/** The query's player, year and play time predicates as one k-d tree box (open where not given). */
+void QueryEngine::rangeBox(const GameQuery& query, KdTree::Box& box) const {
+    for (int d = 0; d < KdTree::DIMENSIONS; d++) {
+        box.low[d] = INT_MIN;
+        box.high[d] = INT_MAX;
+    }
+    if (query.players > 0) {
+        box.high[0] = query.players;    // minPlayers <= players
+        box.low[1] = query.players;     // maxPlayers >= players
+    }
+    if (query.yearFrom != 0) box.low[2] = query.yearFrom;
+    if (query.yearTo != 0) box.high[2] = query.yearTo;
+    if (query.maxPlayTime > 0) {
+        box.low[3] = 1;                 // unknown play times never match
+        box.high[3] = query.maxPlayTime;
+    }
+}
+
+/**
+ * Upper bound on the number of games a predicate matches (exact for year and
+ * play time; for a range box, the smallest estimate of its parts).
+ * Time Complexity: O(log n), or O(|text|) for titles
+ */
+int QueryEngine::estimate(IndexedPredicate predicate, const GameQuery& query) const {
+    switch (predicate) {
+    case PLAYERS: {
+        int minFits = countRange(byMinPlayers, INT_MIN, query.players);
+        int maxFits = countRange(byMaxPlayers, query.players, INT_MAX);
+        return min(minFits, maxFits);
+    }
+    case YEAR:
+        return countRange(byYear, query.yearFrom == 0 ? INT_MIN : query.yearFrom,
+                                  query.yearTo == 0 ? INT_MAX : query.yearTo);
+    case PLAY_TIME:
+        return countRange(byPlayTime, 1, query.maxPlayTime);
+    case RANGE_BOX: {
+        int best = (int)lowerTitles.size();
+        if (query.players > 0) best = min(best, estimate(PLAYERS, query));
+        if (query.yearFrom != 0 || query.yearTo != 0) best = min(best, estimate(YEAR, query));
+        if (query.maxPlayTime > 0) best = min(best, estimate(PLAY_TIME, query));
+        return best;
+    }
+    case TITLE: {
+        string text = toLower(query.titleText);
+        if (text.size() < 3) return (int)lowerTitles.size();   // too short for trigrams
+        int best = INT_MAX;
+        for (size_t at = 0; at + 3 <= text.size(); at++) {
+            unordered_map<unsigned int, vector<int>>::const_iterator it = trigrams.find(trigramKey(text, at));
+            best = min(best, (it == trigrams.end()) ? 0 : (int)it->second.size());
+        }
+        return best;
+    }
+    }
+    return (int)lowerTitles.size();
+}
+
+/** Exact check of one predicate against the game at a catalog position. */
+bool QueryEngine::matches(IndexedPredicate predicate, const GameQuery& query, int position) const {
+    const Game& g = games.get(position);
+    switch (predicate) {
+    case PLAYERS: return query.players >= g.getMinPlayers() && query.players <= g.getMaxPlayers();
+    case YEAR:
+        return (query.yearFrom == 0 || g.getYear() >= query.yearFrom) &&
+               (query.yearTo == 0 || g.getYear() <= query.yearTo);
+    case TITLE: return lowerTitles[position].find(toLower(query.titleText)) != string::npos;
+    case PLAY_TIME: {
+        int playTime = playTimeKey(g);
+        return playTime > 0 && playTime <= query.maxPlayTime;
+    }
+    case RANGE_BOX:
+        return (query.players <= 0 || matches(PLAYERS, query, position)) &&
+               ((query.yearFrom == 0 && query.yearTo == 0) || matches(YEAR, query, position)) &&
+               (query.maxPlayTime <= 0 || matches(PLAY_TIME, query, position));
+    }
+    return false;
+}
+
+/** Lists the exact positions a predicate matches, reading only its index. */
+void QueryEngine::materialize(IndexedPredicate predicate, const GameQuery& query, vector<int>& out) const {
+    switch (predicate) {
+    case PLAYERS: {
+        // Walk whichever side of the player range is smaller, check the other bound
+        int minFits = countRange(byMinPlayers, INT_MIN, query.players);
+        int maxFits = countRange(byMaxPlayers, query.players, INT_MAX);
+        if (minFits <= maxFits) {
+            for (int i = 0; i < minFits; i++) {
+                int position = byMinPlayers[i].second;
+                if (games.get(position).getMaxPlayers() >= query.players) out.push_back(position);
+            }
+        }
+        else {
+            for (int i = (int)byMaxPlayers.size() - maxFits; i < (int)byMaxPlayers.size(); i++) {
+                int position = byMaxPlayers[i].second;
+                if (games.get(position).getMinPlayers() <= query.players) out.push_back(position);
+            }
+        }
+        break;
+    }
+    case YEAR: {
+        vector<pair<int, int>>::const_iterator it = lower_bound(byYear.begin(), byYear.end(),
+            make_pair(query.yearFrom == 0 ? INT_MIN : query.yearFrom, INT_MIN));
+        int high = (query.yearTo == 0) ? INT_MAX : query.yearTo;
+        for (; it != byYear.end() && it->first <= high; ++it) out.push_back(it->second);
+        break;
+    }
+    case PLAY_TIME: {
+        vector<pair<int, int>>::const_iterator it = byPlayTime.begin();
+        for (; it != byPlayTime.end() && it->first <= query.maxPlayTime; ++it) out.push_back(it->second);
+        break;
+    }
+    case RANGE_BOX: {
+        KdTree::Box box;
+        rangeBox(query, box);
+        rangeTree.query(box, out);
+        break;
+    }
+    case TITLE: {
+        string text = toLower(query.titleText);
+        if (text.size() < 3) {
+            for (int i = 0; i < (int)lowerTitles.size(); i++) {
+                if (lowerTitles[i].find(text) != string::npos) out.push_back(i);
+            }
+            break;
+        }
+        // Verify the rarest trigram's games; the others are implied by the substring check
+        const vector<int>* rarest = nullptr;
+        for (size_t at = 0; at + 3 <= text.size(); at++) {
+            unordered_map<unsigned int, vector<int>>::const_iterator it = trigrams.find(trigramKey(text, at));
+            if (it == trigrams.end()) return;
+            if (rarest == nullptr || it->second.size() < rarest->size()) rarest = &it->second;
+        }
+        for (int i = 0; i < (int)rarest->size(); i++) {
+            if (lowerTitles[(*rarest)[i]].find(text) != string::npos) out.push_back((*rarest)[i]);
+        }
+        break;
+    }
+    }
+}
+
+static const char* predicateName(int predicate) {
+    static const char* names[] = { "players", "year", "title", "play time", "k-d tree" };
+    return names[predicate];
+}
+
+static int countBits(const vector<unsigned long long>& bits) {
+    int total = 0;
+    for (size_t w = 0; w < bits.size(); w++) {
+        unsigned long long word = bits[w];
+        while (word != 0) {
+            word &= word - 1;
+            total++;
+        }
+    }
+    return total;
+}
+
+/**
+ * Plans and evaluates a query, filling in the requested page.
+ * @param query Predicates, ordering and page.
+ * @param result Receives the page, the total match count and the plan used.
+ */
+void QueryEngine::run(const GameQuery& query, QueryResult& result) {
+    if (stale) rebuild();
+    int n = games.size();
+    int words = (n + 63) / 64;
+    stringstream plan;
+
+    // --- Planning: order indexed predicates by estimated matches ---
+    // Two or more numeric ranges are answered together by the k-d tree
+    vector<pair<int, IndexedPredicate>> indexed;
+    bool hasPlayers = query.players > 0;
+    bool hasYear = query.yearFrom != 0 || query.yearTo != 0;
+    bool hasPlayTime = query.maxPlayTime > 0;
+    if ((int)hasPlayers + (int)hasYear + (int)hasPlayTime >= 2) {
+        indexed.push_back(make_pair(estimate(RANGE_BOX, query), RANGE_BOX));
+    }
+    else {
+        if (hasPlayers) indexed.push_back(make_pair(estimate(PLAYERS, query), PLAYERS));
+        if (hasYear) indexed.push_back(make_pair(estimate(YEAR, query), YEAR));
+        if (hasPlayTime) indexed.push_back(make_pair(estimate(PLAY_TIME, query), PLAY_TIME));
+    }
+    if (!query.titleText.empty()) indexed.push_back(make_pair(estimate(TITLE, query), TITLE));
+    sort(indexed.begin(), indexed.end());
+
+    // --- Driver: the most selective index, or every game ---
+    Bitmap candidates(words, 0);
+    int candidateCount = 0;
+    if (indexed.empty()) {
+        for (int i = 0; i < n; i++) candidates[i / 64] |= 1ull << (i % 64);
+        candidateCount = n;
+        plan << "scan all " << n << " games";
+    }
+    else {
+        vector<int> driver;
+        materialize(indexed[0].second, query, driver);
+        for (int i = 0; i < (int)driver.size(); i++) candidates[driver[i] / 64] |= 1ull << (driver[i] % 64);
+        candidateCount = (int)driver.size();
+        plan << predicateName(indexed[0].second) << " index (" << candidateCount << ")";
+    }
+
+    // --- Remaining indexed predicates: intersect a bitmap or check per candidate ---
+    vector<IndexedPredicate> perCandidate;
+    for (int p = 1; p < (int)indexed.size(); p++) {
+        int bitmapCost = indexed[p].first + words;
+        if (bitmapCost < candidateCount) {
+            vector<int> positions;
+            materialize(indexed[p].second, query, positions);
+            Bitmap other(words, 0);
+            for (int i = 0; i < (int)positions.size(); i++) other[positions[i] / 64] |= 1ull << (positions[i] % 64);
+            for (int w = 0; w < words; w++) candidates[w] &= other[w];
+            candidateCount = countBits(candidates);
+            plan << " AND " << predicateName(indexed[p].second) << " bitmap (" << candidateCount << ")";
+        }
+        else {
+            perCandidate.push_back(indexed[p].second);
+            plan << " -> check " << predicateName(indexed[p].second);
+        }
+    }
+    if (query.availableOnly) plan << " -> check available";
+    if (query.minRating > 0) plan << " -> check rating";
+
+    // --- Evaluate residual predicates on the surviving candidates ---
+    // Blocks of bitmap words are checked in parallel once there are enough
+    // candidates, and their hits are joined in block order
+    int blocks = (words + BLOCK_WORDS - 1) / BLOCK_WORDS;
+    vector<vector<int>> blockHits(blocks);
+    ThreadPool* workers = (candidateCount >= PARALLEL_CANDIDATES) ? pool : nullptr;
+    parallelFor(workers, 0, blocks, 1, [&](int first, int last) {
+        for (int b = first; b < last; b++) {
+            int endWord = min(words, (b + 1) * BLOCK_WORDS);
+            for (int w = b * BLOCK_WORDS; w < endWord; w++) {
+                unsigned long long word = candidates[w];
+                while (word != 0) {
+                    int bit = 0;
+                    while (((word >> bit) & 1ull) == 0) bit++;
+                    word &= word - 1;
+                    int position = w * 64 + bit;
+
+                    bool keep = true;
+                    for (int p = 0; p < (int)perCandidate.size() && keep; p++) keep = matches(perCandidate[p], query, position);
+                    const Game& g = games.get(position);
+                    if (keep && query.availableOnly) keep = g.getAvailableCopies() > 0;
+                    if (keep && query.minRating > 0) keep = g.getReviewCount() > 0 && g.getAverageRating() >= query.minRating;
+                    if (keep) blockHits[b].push_back(position);
+                }
+            }
+        }
+    });
+    vector<int> hits;
+    for (int b = 0; b < blocks; b++) hits.insert(hits.end(), blockHits[b].begin(), blockHits[b].end());
+
+    // --- Order and paginate (sort only up to the end of the requested page) ---
+    result.totalMatches = (int)hits.size();
+    int pageSize = (query.pageSize > 0) ? query.pageSize : max(1, result.totalMatches);
+    result.pageCount = max(1, (result.totalMatches + pageSize - 1) / pageSize);
+    int page = min(max(query.page, 0), result.pageCount - 1);
+    int from = min(page * pageSize, result.totalMatches);
+    int to = min(from + pageSize, result.totalMatches);
+
+    const vector<string>& titles = lowerTitles;
+    GameDynamicArray& catalog = games;
+    partial_sort(hits.begin(), hits.begin() + to, hits.end(), [&](int a, int b) {
+        const Game& x = catalog.get(a);
+        const Game& y = catalog.get(b);
+        double left = 0, right = 0;
+        switch (query.sortKey) {
+        case GameQuery::BY_YEAR: left = x.getYear(); right = y.getYear(); break;
+        case GameQuery::BY_MAX_PLAYERS: left = x.getMaxPlayers(); right = y.getMaxPlayers(); break;
+        case GameQuery::BY_RATING: left = x.getAverageRating(); right = y.getAverageRating(); break;
+        case GameQuery::BY_AVAILABLE: left = x.getAvailableCopies(); right = y.getAvailableCopies(); break;
+        case GameQuery::BY_TITLE: break;
+        }
+        if (left != right) return query.descending ? left > right : left < right;
+        if (titles[a] != titles[b]) {
+            bool before = titles[a] < titles[b];
+            return (query.sortKey == GameQuery::BY_TITLE && query.descending) ? !before : before;
+        }
+        return x.getGameID() < y.getGameID();
+    });
+
+    result.games.clear();
+    for (int i = from; i < to; i++) result.games.push_back(games.getPtr(hits[i]));
+    plan << " -> " << result.totalMatches << " match(es)";
+    result.plan = plan.str();
+}
+
+/** @return Approximate heap bytes used by the sorted keys, k-d tree, trigram postings and titles. */
+size_t QueryEngine::memoryUsage() const {
+    size_t bytes = vectorHeapBytes(byMinPlayers) + vectorHeapBytes(byMaxPlayers) + vectorHeapBytes(byYear);
+    bytes += vectorHeapBytes(byPlayTime) + rangeTree.memoryUsage();
+    bytes += hashMapHeapBytes(trigrams);
+    for (unordered_map<unsigned int, vector<int>>::const_iterator it = trigrams.begin(); it != trigrams.end(); ++it) {
+        bytes += vectorHeapBytes(it->second);
+    }
+    bytes += vectorHeapBytes(lowerTitles);
+    for (size_t i = 0; i < lowerTitles.size(); i++) bytes += stringHeapBytes(lowerTitles[i]);
+    return bytes;
+}
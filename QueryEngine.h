@@ -0,0 +1,93 @@
+#ifndef QUERYENGINE_H
+#define QUERYENGINE_H
+
+#include "KdTree.h"
+#include "ThreadPool.h"
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+using namespace std;
+
+class Game;
+class GameDynamicArray;
+
+// A compound game search; every predicate left at its default matches all games
+struct GameQuery {
+    enum SortKey { BY_TITLE, BY_YEAR, BY_MAX_PLAYERS, BY_RATING, BY_AVAILABLE };
+
+    int players;            // supports this many players (0 = any)
+    int yearFrom;           // published in [yearFrom, yearTo] (0 = open end)
+    int yearTo;
+    int maxPlayTime;        // finishes within this many minutes (0 = any)
+    string titleText;       // case-insensitive substring ("" = any)
+    bool availableOnly;     // at least one copy on the shelf
+    double minRating;       // average review rating (0 = any)
+
+    SortKey sortKey;
+    bool descending;
+    int page;               // zero-based
+    int pageSize;           // 0 = everything on one page
+
+    GameQuery();
+};
+
+struct QueryResult {
+    vector<Game*> games;    // the requested page, in order
+    int totalMatches;
+    int pageCount;
+    string plan;            // how the planner evaluated the query
+};
+
+/**
+ * Evaluates GameQuery objects over the catalog.
+ * Players, year, play time and title predicates have indexes (sorted keys,
+ * and title trigram postings) that can report how many games they would
+ * match. When two or more of players, year and play time are given, they are
+ * answered together as one box query on a k-d tree over (min players, max
+ * players, year, play time). The planner materialises the most selective
+ * indexed predicate, then for each other one either intersects its bitmap
+ * or checks it per candidate, whichever is estimated to be cheaper. Availability and rating change with
+ * every borrow and review, so they are always checked per candidate.
+ * Indexes refer to catalog positions and are rebuilt lazily after the
+ * catalog changes shape (see GameDynamicArray). With a thread pool attached,
+ * rebuilds and large residual scans are split across its workers.
+ */
+class QueryEngine {
+private:
+    typedef vector<unsigned long long> Bitmap;
+
+    enum IndexedPredicate { PLAYERS, YEAR, TITLE, PLAY_TIME, RANGE_BOX };
+
+    GameDynamicArray& games;
+    bool stale;
+
+    vector<pair<int, int>> byMinPlayers;    // (minPlayers, position), sorted
+    vector<pair<int, int>> byMaxPlayers;    // (maxPlayers, position), sorted
+    vector<pair<int, int>> byYear;          // (year, position), sorted
+    vector<pair<int, int>> byPlayTime;      // (play time, position), sorted; known play times only
+    KdTree rangeTree;                       // (minPlayers, maxPlayers, year, play time) -> position
+    unordered_map<unsigned int, vector<int>> trigrams;     // title trigram -> positions
+    vector<string> lowerTitles;             // position -> lowercase title
+    ThreadPool* pool;                       // nullptr = everything on the calling thread
+
+    void rebuild();
+    int estimate(IndexedPredicate predicate, const GameQuery& query) const;
+    void materialize(IndexedPredicate predicate, const GameQuery& query, vector<int>& out) const;
+    bool matches(IndexedPredicate predicate, const GameQuery& query, int position) const;
+    void rangeBox(const GameQuery& query, KdTree::Box& box) const;
+
+public:
+    QueryEngine(GameDynamicArray& catalog);
+
+    void markStale();
+    void attachThreadPool(ThreadPool* workers);
+    void run(const GameQuery& query, QueryResult& result);
+
+    size_t memoryUsage() const;     // approximate heap bytes (see MemoryFootprint.h)
+
+    static string toLower(const string& text);
+    static int playTimeKey(const Game& game);
+};
+
+#endif
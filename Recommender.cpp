@@ -0,0 +1,233 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Sparse Co-occurrence: Only pairs of games that share at least one member
+ * are stored, as nested hash maps.
+ * - Parallel Build: Members are split across the thread pool; each worker
+ * builds a private partial matrix that is merged afterwards, and neighbour
+ * lists are ranked in parallel per game.
+ * - Incremental Refresh: A new borrow or view only updates the pairs it
+ * touches and marks the affected games stale, in O(d) for d co-occurring
+ * games; nothing is re-ranked on the menu thread until it is needed.
+ * - Lazy Lookup: Every game keeps its top-N neighbours; a stale list is
+ * re-ranked once, on its next lookup.
+ *****************************************************************************/
+
+#include "Recommender.h"
+#include <algorithm>
+#include <cmath>
+using namespace std;
+
+static const double BORROW_WEIGHT = 1.0;
+static const double VIEW_WEIGHT = 0.5;
+
+// A member's interest in a game is the strongest signal seen so far
+static double strongest(double a, double b) { return a > b ? a : b; }
+
+static bool byScore(const Recommender::Neighbour& a, const Recommender::Neighbour& b) {
+    if (a.similarity != b.similarity) return a.similarity > b.similarity;
+    return a.gameID < b.gameID;
+}
+
+/**
+ * Builds the whole model from scratch.
+ * @param pool Worker threads used for the pairwise counting and ranking.
+ * @param borrows Borrows still held in memory.
+ * @param archivedBorrows (userID, gameID) pairs from the archive's segment counts.
+ * @param views Every browse history row.
+ */
+void Recommender::build(ThreadPool& pool, const vector<BorrowRecord>& borrows,
+                        const vector<pair<string, string>>& archivedBorrows, const vector<BrowseRow>& views) {
+    userItems.clear();
+    coWeights.clear();
+    norms.clear();
+    neighbours.clear();
+    stale.clear();
+
+    for (int i = 0; i < (int)views.size(); i++) {
+        double& w = userItems[views[i].userID][views[i].gameID];
+        w = strongest(w, VIEW_WEIGHT);
+    }
+    for (int i = 0; i < (int)borrows.size(); i++) {
+        double& w = userItems[borrows[i].getUserID()][borrows[i].getGameID()];
+        w = strongest(w, BORROW_WEIGHT);
+    }
+    for (int i = 0; i < (int)archivedBorrows.size(); i++) {
+        double& w = userItems[archivedBorrows[i].first][archivedBorrows[i].second];
+        w = strongest(w, BORROW_WEIGHT);
+    }
+
+    // --- Pair counting, one slice of members per task ---
+    vector<const WeightMap*> members;
+    for (unordered_map<string, WeightMap>::const_iterator it = userItems.begin(); it != userItems.end(); ++it) {
+        members.push_back(&it->second);
+    }
+
+    struct Partial {
+        unordered_map<string, WeightMap> co;
+        unordered_map<string, double> norms;
+    };
+
+    int parts = pool.getThreadCount();
+    if (parts > (int)members.size()) parts = (int)members.size();
+    vector<future<Partial>> pending;
+    for (int p = 0; p < parts; p++) {
+        size_t from = members.size() * p / parts;
+        size_t to = members.size() * (p + 1) / parts;
+        pending.push_back(pool.submit([&members, from, to]() {
+            Partial partial;
+            for (size_t m = from; m < to; m++) {
+                const WeightMap& items = *members[m];
+                for (WeightMap::const_iterator a = items.begin(); a != items.end(); ++a) {
+                    partial.norms[a->first] += a->second * a->second;
+                    for (WeightMap::const_iterator b = items.begin(); b != items.end(); ++b) {
+                        if (a->first != b->first) partial.co[a->first][b->first] += a->second * b->second;
+                    }
+                }
+            }
+            return partial;
+        }));
+    }
+    for (int p = 0; p < (int)pending.size(); p++) {
+        Partial partial = pool.wait(pending[p]);
+        for (unordered_map<string, double>::iterator it = partial.norms.begin(); it != partial.norms.end(); ++it) {
+            norms[it->first] += it->second;
+        }
+        for (unordered_map<string, WeightMap>::iterator row = partial.co.begin(); row != partial.co.end(); ++row) {
+            WeightMap& target = coWeights[row->first];
+            for (WeightMap::iterator cell = row->second.begin(); cell != row->second.end(); ++cell) {
+                target[cell->first] += cell->second;
+            }
+        }
+    }
+
+    // --- Neighbour ranking, one slice of games per task (read-only on the matrix) ---
+    vector<string> gameIDs;
+    for (unordered_map<string, WeightMap>::const_iterator it = coWeights.begin(); it != coWeights.end(); ++it) {
+        gameIDs.push_back(it->first);
+    }
+    vector<vector<Neighbour>> ranked(gameIDs.size());
+    pool.parallelFor(0, (int)gameIDs.size(), 1, [this, &gameIDs, &ranked](int from, int to) {
+        for (int g = from; g < to; g++) rankNeighbours(gameIDs[g], ranked[g]);
+    });
+    for (size_t g = 0; g < gameIDs.size(); g++) neighbours[gameIDs[g]].swap(ranked[g]);
+}
+
+/**
+ * Computes the NEIGHBOURS most similar games (cosine similarity).
+ * Time Complexity: O(d log N) where d is the number of co-occurring games
+ */
+void Recommender::rankNeighbours(const string& gameID, vector<Neighbour>& out) const {
+    out.clear();
+    unordered_map<string, WeightMap>::const_iterator row = coWeights.find(gameID);
+    if (row == coWeights.end()) return;
+
+    double selfNorm = norms.at(gameID);
+    for (WeightMap::const_iterator cell = row->second.begin(); cell != row->second.end(); ++cell) {
+        if (cell->second <= 0) continue;
+        Neighbour candidate = { cell->first, cell->second / sqrt(selfNorm * norms.at(cell->first)) };
+
+        // Keep 'out' as a sorted list of at most NEIGHBOURS entries
+        if ((int)out.size() == NEIGHBOURS && !byScore(candidate, out.back())) continue;
+        vector<Neighbour>::iterator pos = upper_bound(out.begin(), out.end(), candidate, byScore);
+        out.insert(pos, candidate);
+        if ((int)out.size() > NEIGHBOURS) out.pop_back();
+    }
+}
+
+/**
+ * Raises a member's weight for a game and updates every pair it is part of.
+ * Similarities involving the game change with its norm, so the game and all
+ * of its co-occurring games are marked for re-ranking.
+ * Time Complexity: O(k + d) for k games of the member and d co-occurring games
+ */
+void Recommender::setWeight(const string& userID, const string& gameID, double weight) {
+    WeightMap& items = userItems[userID];
+    double old = items.count(gameID) ? items[gameID] : 0.0;
+    if (weight <= old) return;
+
+    double delta = weight - old;
+    for (WeightMap::iterator other = items.begin(); other != items.end(); ++other) {
+        if (other->first == gameID) continue;
+        coWeights[gameID][other->first] += delta * other->second;
+        coWeights[other->first][gameID] += delta * other->second;
+    }
+    items[gameID] = weight;
+    norms[gameID] += weight * weight - old * old;
+
+    WeightMap& row = coWeights[gameID];
+    stale.insert(gameID);
+    for (WeightMap::iterator other = row.begin(); other != row.end(); ++other) {
+        stale.insert(other->first);
+    }
+}
+
+void Recommender::recordBorrow(const string& userID, const string& gameID) {
+    setWeight(userID, gameID, BORROW_WEIGHT);
+}
+
+/** Records many borrows (userID, gameID) at once. */
+void Recommender::recordBorrows(const vector<pair<string, string>>& borrows) {
+    for (int i = 0; i < (int)borrows.size(); i++) {
+        setWeight(borrows[i].first, borrows[i].second, BORROW_WEIGHT);
+    }
+}
+
+void Recommender::recordView(const string& userID, const string& gameID) {
+    setWeight(userID, gameID, VIEW_WEIGHT);
+}
+
+/**
+ * @return Neighbours, most similar first (empty if none); re-ranked first if
+ * the game changed since its last lookup.
+ * Time Complexity: O(1), or O(d log N) for a stale game
+ */
+const vector<Recommender::Neighbour>& Recommender::getNeighbours(const string& gameID) const {
+    static const vector<Neighbour> none;
+    unordered_set<string>::iterator mark = stale.find(gameID);
+    if (mark != stale.end()) {
+        rankNeighbours(gameID, neighbours[gameID]);
+        stale.erase(mark);
+    }
+    unordered_map<string, vector<Neighbour>>::const_iterator it = neighbours.find(gameID);
+    return (it == neighbours.end()) ? none : it->second;
+}
+
+/**
+ * Neighbours of a game as another member would see them: if this member has
+ * viewed or borrowed the game, their own weights are taken out of every pair
+ * and norm first, so their history never recommends itself back to them.
+ * Time Complexity: O(NEIGHBOURS) if the member never touched the game, O(d log N) otherwise
+ */
+void Recommender::recommendFor(const string& userID, const string& gameID, vector<Neighbour>& out) const {
+    out.clear();
+    unordered_map<string, WeightMap>::const_iterator member = userItems.find(userID);
+    WeightMap::const_iterator own = (member != userItems.end()) ? member->second.find(gameID)
+                                                                : WeightMap::const_iterator();
+    if (member == userItems.end() || own == member->second.end()) {
+        out = getNeighbours(gameID);
+        return;
+    }
+
+    unordered_map<string, WeightMap>::const_iterator row = coWeights.find(gameID);
+    if (row == coWeights.end()) return;
+    const WeightMap& items = member->second;
+    double selfNorm = norms.at(gameID) - own->second * own->second;
+    for (WeightMap::const_iterator cell = row->second.begin(); cell != row->second.end(); ++cell) {
+        WeightMap::const_iterator mine = items.find(cell->first);
+        double theirs = (mine != items.end()) ? mine->second : 0.0;
+        double shared = cell->second - own->second * theirs;
+        double otherNorm = norms.at(cell->first) - theirs * theirs;
+        if (shared <= 1e-9 || selfNorm <= 1e-9 || otherNorm <= 1e-9) continue;
+        Neighbour candidate = { cell->first, shared / sqrt(selfNorm * otherNorm) };
+
+        if ((int)out.size() == NEIGHBOURS && !byScore(candidate, out.back())) continue;
+        vector<Neighbour>::iterator pos = upper_bound(out.begin(), out.end(), candidate, byScore);
+        out.insert(pos, candidate);
+        if ((int)out.size() > NEIGHBOURS) out.pop_back();
+    }
+}
+
+int Recommender::getGameCount() const { return (int)coWeights.size(); }
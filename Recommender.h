@@ -0,0 +1,59 @@
+#ifndef RECOMMENDER_H
+#define RECOMMENDER_H
+
+#include "BorrowRecord.h"
+#include "CSVHandler.h"
+#include "ThreadPool.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/**
+ * Item-to-item recommender ("members who borrowed this also borrowed").
+ * Each member contributes a weighted set of games (borrowed games count more
+ * than games only viewed). Games that share members get a cosine similarity,
+ * and every game keeps a short list of its most similar games. Updates only
+ * mark the games they affect; a list is re-ranked when it is next looked up,
+ * so a lookup is O(NEIGHBOURS) unless the game changed since the last one.
+ */
+class Recommender {
+public:
+    struct Neighbour {
+        string gameID;
+        double similarity;  // 0..1
+    };
+
+    static const int NEIGHBOURS = 5;
+
+private:
+    typedef unordered_map<string, double> WeightMap;
+
+    unordered_map<string, WeightMap> userItems;     // user -> game -> weight
+    unordered_map<string, WeightMap> coWeights;     // game -> game -> shared weight
+    unordered_map<string, double> norms;            // game -> sum of squared weights
+    // Re-ranked lazily: an update only marks games stale, and a game's list is
+    // recomputed the next time it is looked up
+    mutable unordered_map<string, vector<Neighbour>> neighbours;
+    mutable unordered_set<string> stale;
+
+    void setWeight(const string& userID, const string& gameID, double weight);
+    void rankNeighbours(const string& gameID, vector<Neighbour>& out) const;
+
+public:
+    void build(ThreadPool& pool, const vector<BorrowRecord>& borrows,
+               const vector<pair<string, string>>& archivedBorrows, const vector<BrowseRow>& views);
+
+    // Incremental updates as members use the menus
+    void recordBorrow(const string& userID, const string& gameID);
+    void recordBorrows(const vector<pair<string, string>>& borrows);
+    void recordView(const string& userID, const string& gameID);
+
+    const vector<Neighbour>& getNeighbours(const string& gameID) const;
+    void recommendFor(const string& userID, const string& gameID, vector<Neighbour>& out) const;
+    int getGameCount() const;
+};
+
+#endif
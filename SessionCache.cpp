@@ -0,0 +1,161 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Warm Sessions: A member's browse history, active loans and summary
+ * counters stay in memory between logins, so logging in again at a shared
+ * kiosk reads no files.
+ * - LRU Eviction: Sessions are kept in a doubly linked list ordered by last
+ * login, with a hash map from user ID, so open and evict are O(1).
+ * - Lazy Persistence: Browse history is queued for the background writer
+ * when its session is evicted or the program exits, not on every change.
+ *****************************************************************************/
+
+#include "SessionCache.h"
+#include "BorrowLinkedList.h"
+#include "CSVHandler.h"
+#include "GameDynamicArray.h"
+#include "PersistenceWorker.h"
+using namespace std;
+
+SessionCache::SessionCache(PersistenceWorker& writer, int maxSessions) : persistence(writer) {
+    capacity = (maxSessions > 0) ? maxSessions : 1;
+    head = tail = nullptr;
+    warmLogins = coldLogins = evictions = 0;
+    viewCounter = nullptr;
+}
+
+/** Frees every session. Call flushAll() first to keep unsaved browse history. */
+SessionCache::~SessionCache() {
+    while (head != nullptr) {
+        Session* next = head->next;
+        delete head;
+        head = next;
+    }
+}
+
+void SessionCache::unlink(Session* session) {
+    if (session->prev != nullptr) session->prev->next = session->next;
+    else head = session->next;
+    if (session->next != nullptr) session->next->prev = session->prev;
+    else tail = session->prev;
+    session->prev = session->next = nullptr;
+}
+
+void SessionCache::pushFront(Session* session) {
+    session->prev = nullptr;
+    session->next = head;
+    if (head != nullptr) head->prev = session;
+    head = session;
+    if (tail == nullptr) tail = session;
+}
+
+/** Queues the session's browse history if it changed, then drops the session. */
+void SessionCache::evict(Session* session) {
+    if (session->historyDirty) persistence.markBrowseHistoryDirty(session->userID, session->history);
+    unlink(session);
+    sessions.erase(session->userID);
+    delete session;
+    evictions++;
+}
+
+/**
+ * Returns a member's session, loading it on their first login (or after it
+ * was evicted) and evicting the least recently used session when full.
+ * @param userID Member logging in.
+ * @param games Catalog the browse history refers to.
+ * @param records Borrow records the loans and counters come from.
+ * @return The session; it stays valid until it is evicted.
+ * Time Complexity: O(1) when warm; a cold load reads browse_history.csv
+ */
+SessionCache::Session& SessionCache::open(const string& userID, GameDynamicArray& games, BorrowLinkedList& records) {
+    unordered_map<string, Session*>::iterator it = sessions.find(userID);
+    if (it != sessions.end()) {
+        unlink(it->second);
+        pushFront(it->second);
+        warmLogins++;
+        return *it->second;
+    }
+
+    // Read the history only after any queued write of it (e.g. from an eviction) lands
+    persistence.flush();
+    Session* session = new Session();
+    session->userID = userID;
+    session->historyDirty = false;
+    CSVHandler::loadBrowseHistory("browse_history.csv", userID, session->history, games);
+    session->history.attachViewCounter(viewCounter);
+
+    vector<BorrowRecord*> active;
+    records.findActiveByUser(userID, active);
+    for (int i = 0; i < (int)active.size(); i++) {
+        Loan loan = { active[i]->getRecordID(), active[i]->getGameID(), active[i]->getBorrowDate() };
+        session->activeLoans.push_back(loan);
+    }
+    session->totalBorrows = records.countBorrowsByUser(userID);
+    session->totalReturns = records.countReturnsByUser(userID);
+    session->prev = session->next = nullptr;
+
+    pushFront(session);
+    sessions[userID] = session;
+    coldLogins++;
+    if ((int)sessions.size() > capacity) evict(tail);
+    return *session;
+}
+
+/** Counts every view recorded from now on, in every session, in a shared sketch. */
+void SessionCache::attachViewCounter(CountMinSketch* counter) {
+    viewCounter = counter;
+    for (Session* session = head; session != nullptr; session = session->next) {
+        session->history.attachViewCounter(counter);
+    }
+}
+
+/** Adds a viewed game to the session's browse history (saved lazily). */
+void SessionCache::recordView(Session& session, const Game& game, const Date& viewedDate) {
+    session.history.enqueue(game, viewedDate);
+    session.historyDirty = true;
+}
+
+/**
+ * Looks up a member's session without loading or reordering anything; used to
+ * keep warm sessions in step with changes made outside the member menu.
+ * @return The session, or nullptr if the member has none in the cache.
+ */
+SessionCache::Session* SessionCache::findWarm(const string& userID) {
+    unordered_map<string, Session*>::iterator it = sessions.find(userID);
+    return (it == sessions.end()) ? nullptr : it->second;
+}
+
+/** Counts a new borrow and adds it to the session's active loans. */
+void SessionCache::recordBorrow(Session& session, const BorrowRecord& record) {
+    Loan loan = { record.getRecordID(), record.getGameID(), record.getBorrowDate() };
+    session.activeLoans.push_back(loan);
+    session.totalBorrows++;
+}
+
+/**
+ * Counts a return and removes the loan from the session's active loans.
+ * Record IDs saved by older versions can repeat, so the loan is matched on
+ * record ID, game and borrow date together.
+ */
+void SessionCache::recordReturn(Session& session, const BorrowRecord& record) {
+    for (int i = 0; i < (int)session.activeLoans.size(); i++) {
+        const Loan& loan = session.activeLoans[i];
+        if (loan.recordID == record.getRecordID() && loan.gameID == record.getGameID()
+            && loan.borrowDate == record.getBorrowDate()) {
+            session.activeLoans.erase(session.activeLoans.begin() + i);
+            session.totalReturns++;
+            return;
+        }
+    }
+}
+
+/** Queues every changed browse history for the background writer (sessions stay warm). */
+void SessionCache::flushAll() {
+    for (Session* session = head; session != nullptr; session = session->next) {
+        if (!session->historyDirty) continue;
+        persistence.markBrowseHistoryDirty(session->userID, session->history);
+        session->historyDirty = false;
+    }
+}
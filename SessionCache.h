@@ -0,0 +1,84 @@
+#ifndef SESSIONCACHE_H
+#define SESSIONCACHE_H
+
+#include "BorrowRecord.h"
+#include "BrowseHistory.h"
+#include "Date.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+class BorrowLinkedList;
+class GameDynamicArray;
+class PersistenceWorker;
+class CountMinSketch;
+
+/**
+ * Keeps members' session state warm between logins for the lifetime of the
+ * program: browse history, active loans and borrow/return counters.
+ * The first login loads a session from browse_history.csv and the borrow
+ * records; later logins reuse it with no file I/O. Browse history is saved
+ * lazily: a changed history is queued for the background writer only when
+ * its session is evicted or at shutdown (flushAll). Sessions form an LRU
+ * list bounded by a capacity, with a hash map from user ID to session.
+ */
+class SessionCache {
+public:
+    static const int DEFAULT_CAPACITY = 16;
+
+    struct Loan {
+        string recordID;
+        string gameID;
+        Date borrowDate;
+    };
+
+    struct Session {
+        string userID;
+        BrowseHistory history;
+        bool historyDirty;          // changed since it was last queued for saving
+        vector<Loan> activeLoans;   // oldest borrow first
+        int totalBorrows;           // including archived borrows
+        int totalReturns;
+        Session* prev;
+        Session* next;
+    };
+
+    SessionCache(PersistenceWorker& writer, int maxSessions = DEFAULT_CAPACITY);
+    ~SessionCache();
+
+    SessionCache(const SessionCache&) = delete;
+    SessionCache& operator=(const SessionCache&) = delete;
+
+    Session& open(const string& userID, GameDynamicArray& games, BorrowLinkedList& records);
+    Session* findWarm(const string& userID);
+    void attachViewCounter(CountMinSketch* counter);
+    const CountMinSketch* getViewCounter() const { return viewCounter; }
+
+    void recordView(Session& session, const Game& game, const Date& viewedDate);
+    void recordBorrow(Session& session, const BorrowRecord& record);
+    void recordReturn(Session& session, const BorrowRecord& record);
+
+    void flushAll();
+
+    long long getWarmLogins() const { return warmLogins; }
+    long long getColdLogins() const { return coldLogins; }
+    long long getEvictions() const { return evictions; }
+
+private:
+    PersistenceWorker& persistence;
+    int capacity;
+    Session* head;      // most recently used
+    Session* tail;      // least recently used
+    unordered_map<string, Session*> sessions;
+    CountMinSketch* viewCounter;    // handed to every session's browse history
+    long long warmLogins;
+    long long coldLogins;
+    long long evictions;
+
+    void unlink(Session* session);
+    void pushFront(Session* session);
+    void evict(Session* session);
+};
+
+#endif
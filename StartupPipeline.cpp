@@ -0,0 +1,198 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Parallel Loading: Games, users, borrow records and reviews are read and
+ * parsed concurrently on the shared work-stealing pool instead of one after
+ * another.
+ * - Byte-Range Chunking: Large files are cut into equal byte ranges aligned
+ * to line boundaries so several workers can parse one file at once; each
+ * file's task splits itself further and idle workers steal the pieces.
+ * - Indexed Review Join: Reviews are parsed early and attached through a
+ * gameID -> Game* index once the catalog is built, instead of a linear
+ * search per review.
+ * - Binary Borrow Log: When borrow records live in the memory-mapped log,
+ * they are decoded from its fixed-width entries instead of parsed from CSV.
+ * - Phase Timing: Prints how long each startup phase took.
+ *****************************************************************************/
+
+#include "StartupPipeline.h"
+#include "CSVHandler.h"
+#include "BorrowLog.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <unordered_map>
+using namespace std;
+
+struct LoadedFile {
+    bool ok;
+    string contents;
+};
+
+/** @return Milliseconds elapsed since the given time point. */
+static double elapsedMs(chrono::steady_clock::time_point since) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - since).count();
+}
+
+static void printPhase(const string& name, double ms) {
+    cout << "[STARTUP]   " << left << setw(11) << name << right
+         << fixed << setprecision(2) << setw(9) << ms << " ms\n";
+}
+
+/**
+ * Queues one task that parses a whole file; the task cuts the file into
+ * chunks on the same pool (see CSVHandler::parseChunked).
+ */
+template <class Row>
+static void parseFile(ThreadPool& pool, const LoadedFile& file,
+    void (*parse)(const string&, size_t, size_t, vector<Row>&),
+    vector<Row>& rows, vector<future<void>>& pending) {
+    if (!file.ok) return;
+    ThreadPool* workers = &pool;
+    const string* contents = &file.contents;
+    vector<Row>* out = &rows;
+    pending.push_back(pool.submit([workers, contents, parse, out]() {
+        CSVHandler::parseChunked(workers, *contents, parse, *out);
+    }));
+}
+
+static void waitAll(ThreadPool& pool, vector<future<void>>& pending) {
+    for (int i = 0; i < (int)pending.size(); i++) pool.wait(pending[i]);
+    pending.clear();
+}
+
+/**
+ * Loads every CSV file and reconciles game availability.
+ * @param pool Worker pool used for all parallel phases.
+ * @param games Catalog to fill.
+ * @param users User directory to fill.
+ * @param records Borrow history to fill.
+ * @param log Open binary borrow log to load records from, or nullptr for the CSV.
+ */
+void StartupPipeline::run(ThreadPool& pool, GameDynamicArray& games,
+    UserDynamicArray& users, BorrowLinkedList& records, BorrowLog* log) {
+    bool binaryRecords = log != nullptr && log->isOpen();
+    chrono::steady_clock::time_point startAll = chrono::steady_clock::now();
+    chrono::steady_clock::time_point start = startAll;
+
+    // --- Phase 1: read all four files concurrently (three with the binary log) ---
+    LoadedFile gameFile, reviewFile, userFile, recordFile;
+    recordFile.ok = false;
+    {
+        LoadedFile* targets[4] = { &gameFile, &reviewFile, &userFile, &recordFile };
+        const char* names[4] = { "games.csv", "reviews.csv", "users.csv", "borrow_records.csv" };
+        int fileCount = binaryRecords ? 3 : 4;
+        vector<future<void>> reads;
+        for (int i = 0; i < fileCount; i++) {
+            LoadedFile* target = targets[i];
+            string name = names[i];
+            reads.push_back(pool.submit([target, name]() {
+                target->ok = CSVHandler::readFile(name, target->contents);
+            }));
+        }
+        waitAll(pool, reads);
+    }
+    // Files without a header row are treated like missing ones, as the old loaders did
+    reviewFile.ok = reviewFile.ok && !reviewFile.contents.empty();
+    userFile.ok = userFile.ok && !userFile.contents.empty();
+    recordFile.ok = recordFile.ok && !recordFile.contents.empty();
+
+    if (!gameFile.ok) cout << "[WARNING] Could not load games.csv. Continuing with empty game library.\n";
+    if (!reviewFile.ok) cout << "[INFO] No reviews.csv found or file is empty.\n";
+    if (!userFile.ok) cout << "[WARNING] Could not load users.csv. Continuing with no users.\n";
+    if (!recordFile.ok && !binaryRecords) cout << "[WARNING] Could not load borrow_records.csv. Continuing with no records.\n";
+    double readMs = elapsedMs(start);
+
+    // --- Phase 2: parse every chunk of every file at once ---
+    start = chrono::steady_clock::now();
+    vector<GameRow> gameRows;
+    vector<ReviewRow> reviewRows;
+    vector<User> userRows;
+    vector<BorrowRecord> recordRows;
+    vector<future<void>> parses;
+    parseFile(pool, gameFile, &CSVHandler::parseGameRows, gameRows, parses);
+    parseFile(pool, reviewFile, &CSVHandler::parseReviewRows, reviewRows, parses);
+    parseFile(pool, userFile, &CSVHandler::parseUserRows, userRows, parses);
+    parseFile(pool, recordFile, &CSVHandler::parseBorrowRows, recordRows, parses);
+    // Fixed-width entries decode without any text parsing, oldest first
+    if (binaryRecords) log->collectLive(recordRows);
+    waitAll(pool, parses);
+    double parseMs = elapsedMs(start);
+
+    // --- Phase 3: build the three structures in parallel ---
+    start = chrono::steady_clock::now();
+    unordered_map<string, Game*> catalogIndex;
+    future<void> gamesBuilt = pool.submit([&]() {
+        for (int r = 0; r < (int)gameRows.size(); r++) {
+            const GameRow& row = gameRows[r];
+            string id = (row.gameID != "") ? row.gameID : games.nextGameID();
+            Game game(id, row.title, row.minPlayers, row.maxPlayers, row.year, 1, 1);
+            game.setPlayTime(row.minPlayTime, row.maxPlayTime);
+            games.add(game);
+        }
+        catalogIndex.reserve(games.size());
+        for (int i = 0; i < games.size(); i++) {
+            Game* game = games.getPtr(i);
+            catalogIndex.insert(make_pair(game->getGameID(), game));
+        }
+        games.buildTitlePrefixes();
+    });
+    future<void> usersBuilt = pool.submit([&]() {
+        for (int r = 0; r < (int)userRows.size(); r++) users.add(userRows[r]);
+    });
+    future<void> recordsBuilt = pool.submit([&]() {
+        for (int r = 0; r < (int)recordRows.size(); r++) records.insertFront(recordRows[r]);
+    });
+    pool.wait(gamesBuilt);
+    double catalogMs = elapsedMs(start);
+
+    // --- Phase 4: join reviews onto the catalog (file order keeps BST shapes) ---
+    start = chrono::steady_clock::now();
+    int reviewCount = 0;
+    for (int r = 0; r < (int)reviewRows.size(); r++) {
+        const ReviewRow& row = reviewRows[r];
+        unordered_map<string, Game*>::iterator it = catalogIndex.find(row.gameID);
+        if (it != catalogIndex.end()) {
+            it->second->addReview(row.memberName, row.comment, row.rating);
+            reviewCount++;
+        }
+    }
+    double reviewMs = elapsedMs(start);
+
+    pool.wait(usersBuilt);
+    pool.wait(recordsBuilt);
+
+    // --- Phase 5: availability, one copy per (user, game) active borrow ---
+    start = chrono::steady_clock::now();
+    unordered_map<string, int> userEntries;
+    for (int r = 0; r < (int)userRows.size(); r++) userEntries[userRows[r].getUserID()]++;
+    unordered_map<string, bool> counted;
+    for (int r = 0; r < (int)recordRows.size(); r++) {
+        const BorrowRecord& br = recordRows[r];
+        if (br.isReturned()) continue;
+        if (!counted.insert(make_pair(br.getUserID() + "|" + br.getGameID(), true)).second) continue;
+
+        unordered_map<string, int>::iterator user = userEntries.find(br.getUserID());
+        unordered_map<string, Game*>::iterator game = catalogIndex.find(br.getGameID());
+        if (user == userEntries.end() || game == catalogIndex.end()) continue;
+        for (int k = 0; k < user->second; k++) game->second->decrementAvailable();
+    }
+    double reconcileMs = elapsedMs(start);
+
+    int recordCount = (int)recordRows.size();
+
+    streamsize oldPrecision = cout.precision();
+    cout << "[STARTUP] Loaded " << games.size() << " games, " << users.size() << " users, "
+         << recordCount << " borrow records, " << reviewCount << " reviews on "
+         << pool.getThreadCount() << " thread(s)\n";
+    printPhase("read", readMs);
+    printPhase("parse", parseMs);
+    printPhase("catalog", catalogMs);
+    printPhase("reviews", reviewMs);
+    printPhase("reconcile", reconcileMs);
+    printPhase("total", elapsedMs(startAll));
+    cout.unsetf(ios::fixed);
+    cout.precision(oldPrecision);
+}
@@ -0,0 +1,25 @@
+#ifndef STARTUPPIPELINE_H
+#define STARTUPPIPELINE_H
+
+#include "ThreadPool.h"
+#include "GameDynamicArray.h"
+#include "UserDynamicArray.h"
+#include "BorrowLinkedList.h"
+
+class BorrowLog;
+
+/**
+ * Parallel replacement for the sequential CSV loading in main().
+ * Runs in phases (read, parse, build, reviews, reconcile); every phase fans
+ * its work out over the pool and the timing of each phase is printed.
+ * When an open binary borrow log is given, borrow records are decoded from
+ * it and borrow_records.csv is not read.
+ */
+class StartupPipeline {
+public:
+    static void run(ThreadPool& pool, GameDynamicArray& games,
+                    UserDynamicArray& users, BorrowLinkedList& records,
+                    BorrowLog* log = nullptr);
+};
+
+#endif
@@ -0,0 +1,280 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - HyperLogLog: Distinct items are counted in 512 one-byte registers, so the
+ * number of different members who borrowed a game costs the same memory
+ * whether it has ten borrows or ten million.
+ * - Count-Min Sketch: Item frequencies live in a fixed grid of counters that
+ * never undercounts and has a known error bound.
+ * - Heavy Hitters: The most frequent items are tracked beside the sketch as
+ * their estimates grow, so "most viewed" needs no list of candidates.
+ * - Mergeable: Both sketches combine with another sketch of the same shape,
+ * giving the sketch of the combined streams (used to build them in parallel
+ * and to count distinct members across several games).
+ * - Persistent: Both sketches write and read a compact binary form, so their
+ * counts carry over from one run to the next.
+ *****************************************************************************/
+
+#include "StreamSketches.h"
+#include "MemoryFootprint.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+using namespace std;
+
+// Fixed-width values in the binary form (host byte order, like the borrow log)
+template <class T>
+static void putRaw(string& out, T value) {
+    out.append((const char*)&value, sizeof(T));
+}
+
+template <class T>
+static bool getRaw(const string& in, size_t& pos, T& value) {
+    if (pos + sizeof(T) > in.size()) return false;
+    memcpy(&value, in.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+/**
+ * 64-bit hash of a string: FNV-1a followed by the SplitMix64 finalizer, so
+ * every output bit depends on every input byte (the sketches use the top
+ * bits and the low bits separately).
+ */
+static unsigned long long hashItem(const string& item) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < item.size(); i++) {
+        hash ^= (unsigned char)item[i];
+        hash *= 1099511628211ULL;
+    }
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+// --- HYPERLOGLOG ---
+
+HyperLogLog::HyperLogLog() {
+    memset(registers, 0, sizeof(registers));
+}
+
+/**
+ * Adds an item: the top PRECISION bits of its hash pick a register, which
+ * keeps the longest run of leading zeros seen in the remaining bits.
+ * Time Complexity: O(length of the item)
+ */
+void HyperLogLog::add(const string& item) {
+    unsigned long long hash = hashItem(item);
+    int index = (int)(hash >> (64 - PRECISION));
+    unsigned long long rest = hash << PRECISION;
+
+    unsigned char rank = 1;
+    while (rank <= 64 - PRECISION && (rest & 0x8000000000000000ULL) == 0) {
+        rest <<= 1;
+        rank++;
+    }
+    if (rank > registers[index]) registers[index] = rank;
+}
+
+/** Turns this counter into the counter of both streams (register-wise maximum). */
+void HyperLogLog::merge(const HyperLogLog& other) {
+    for (int i = 0; i < REGISTERS; i++) {
+        if (other.registers[i] > registers[i]) registers[i] = other.registers[i];
+    }
+}
+
+/**
+ * @return Estimated number of distinct items added. Small counts, where
+ * some registers are still empty, use linear counting instead.
+ * Time Complexity: O(REGISTERS)
+ */
+double HyperLogLog::estimate() const {
+    double sum = 0;
+    int empty = 0;
+    for (int i = 0; i < REGISTERS; i++) {
+        sum += ldexp(1.0, -registers[i]);
+        if (registers[i] == 0) empty++;
+    }
+    double m = REGISTERS;
+    double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double raw = alpha * m * m / sum;
+    if (raw <= 2.5 * m && empty > 0) return m * log(m / empty);
+    return raw;
+}
+
+void HyperLogLog::writeTo(string& out) const {
+    out.append((const char*)registers, REGISTERS);
+}
+
+/**
+ * Reads registers written by writeTo.
+ * @return False (counter unchanged) if the bytes are cut short or out of range.
+ */
+bool HyperLogLog::readFrom(const string& in, size_t& pos) {
+    if (pos + REGISTERS > in.size()) return false;
+    for (int i = 0; i < REGISTERS; i++) {
+        if ((unsigned char)in[pos + i] > 64 - PRECISION + 1) return false;
+    }
+    memcpy(registers, in.data() + pos, REGISTERS);
+    pos += REGISTERS;
+    return true;
+}
+
+// --- COUNT-MIN SKETCH ---
+
+CountMinSketch::CountMinSketch() : counters((size_t)DEPTH * WIDTH, 0) {
+    total = 0;
+}
+
+/**
+ * Counts an item and updates the heavy hitters.
+ * Time Complexity: O(DEPTH + TRACKED)
+ * @param times Number of occurrences to add.
+ * @return The item's new estimate.
+ */
+long long CountMinSketch::add(const string& item, long long times) {
+    unsigned long long hash = hashItem(item);
+    unsigned int first = (unsigned int)hash;
+    unsigned int step = (unsigned int)(hash >> 32) | 1;
+    for (int row = 0; row < DEPTH; row++) {
+        counters[(size_t)row * WIDTH + (first + row * step) % WIDTH] += (unsigned int)times;
+    }
+    total += times;
+
+    long long count = estimateHashed(hash);
+    track(item, count);
+    return count;
+}
+
+/** @return Estimated occurrences of an item (never less than the true count). */
+long long CountMinSketch::estimate(const string& item) const {
+    return estimateHashed(hashItem(item));
+}
+
+// Smallest of the item's DEPTH counters; the rows use independent positions
+// derived from the two halves of one hash
+long long CountMinSketch::estimateHashed(unsigned long long hash) const {
+    unsigned int first = (unsigned int)hash;
+    unsigned int step = (unsigned int)(hash >> 32) | 1;
+    long long best = -1;
+    for (int row = 0; row < DEPTH; row++) {
+        long long count = counters[(size_t)row * WIDTH + (first + row * step) % WIDTH];
+        if (best < 0 || count < best) best = count;
+    }
+    return best;
+}
+
+/**
+ * Offers an item's new (higher) estimate to the heavy hitters. Valid because
+ * estimates only grow: an item outside the list can only enter by beating
+ * the current minimum.
+ */
+void CountMinSketch::track(const string& item, long long count) {
+    int weakest = -1;
+    for (int i = 0; i < (int)heavy.size(); i++) {
+        if (heavy[i].item == item) {
+            heavy[i].count = count;
+            return;
+        }
+        if (weakest < 0 || heavy[i].count < heavy[weakest].count) weakest = i;
+    }
+    HeavyHitter entry = { item, count };
+    if ((int)heavy.size() < TRACKED) heavy.push_back(entry);
+    else if (count > heavy[weakest].count) heavy[weakest] = entry;
+}
+
+/**
+ * Adds another sketch's counts to this one. The heavy hitters of both are
+ * re-estimated against the combined counters.
+ * Time Complexity: O(DEPTH * WIDTH)
+ */
+void CountMinSketch::merge(const CountMinSketch& other) {
+    for (size_t i = 0; i < counters.size(); i++) counters[i] += other.counters[i];
+    total += other.total;
+
+    vector<HeavyHitter> candidates(heavy);
+    candidates.insert(candidates.end(), other.heavy.begin(), other.heavy.end());
+    heavy.clear();
+    for (int i = 0; i < (int)candidates.size(); i++) track(candidates[i].item, estimate(candidates[i].item));
+}
+
+/**
+ * Recomputes the heavy hitters from the given candidates and the current
+ * ones, against the current counters. After merging partial sketches, an
+ * item spread evenly over the partials can be missing from every partial's
+ * list even though its merged count is high; passing every distinct item
+ * seen restores it.
+ * Time Complexity: O(c * (DEPTH + TRACKED)) for c candidates
+ */
+void CountMinSketch::retrack(const vector<string>& items) {
+    vector<HeavyHitter> previous(heavy);
+    heavy.clear();
+    for (int i = 0; i < (int)previous.size(); i++) track(previous[i].item, estimate(previous[i].item));
+    for (int i = 0; i < (int)items.size(); i++) track(items[i], estimate(items[i]));
+}
+
+/** Appends up to k of the most frequent items, highest estimate first (ties by item). */
+void CountMinSketch::topItems(int k, vector<HeavyHitter>& out) const {
+    vector<HeavyHitter> ranked(heavy);
+    sort(ranked.begin(), ranked.end(), [](const HeavyHitter& a, const HeavyHitter& b) {
+        if (a.count != b.count) return a.count > b.count;
+        return a.item < b.item;
+    });
+    for (int i = 0; i < (int)ranked.size() && i < k; i++) out.push_back(ranked[i]);
+}
+
+/** @return The most any estimate overcounts, with probability 1 - e^-DEPTH. */
+long long CountMinSketch::errorBound() const {
+    return (long long)ceil(exp(1.0) * total / WIDTH);
+}
+
+void CountMinSketch::writeTo(string& out) const {
+    putRaw<long long>(out, total);
+    for (size_t i = 0; i < counters.size(); i++) putRaw<unsigned int>(out, counters[i]);
+    putRaw<int>(out, (int)heavy.size());
+    for (int i = 0; i < (int)heavy.size(); i++) {
+        putRaw<long long>(out, heavy[i].count);
+        putRaw<int>(out, (int)heavy[i].item.size());
+        out += heavy[i].item;
+    }
+}
+
+/**
+ * Reads a sketch written by writeTo (same DEPTH and WIDTH).
+ * @return False (sketch unchanged) if the bytes are cut short or malformed.
+ */
+bool CountMinSketch::readFrom(const string& in, size_t& pos) {
+    size_t at = pos;
+    long long loadedTotal;
+    if (!getRaw(in, at, loadedTotal) || loadedTotal < 0) return false;
+    vector<unsigned int> loadedCounters(counters.size());
+    for (size_t i = 0; i < loadedCounters.size(); i++) {
+        if (!getRaw(in, at, loadedCounters[i])) return false;
+    }
+    int heavyCount;
+    if (!getRaw(in, at, heavyCount) || heavyCount < 0 || heavyCount > TRACKED) return false;
+    vector<HeavyHitter> loadedHeavy(heavyCount);
+    for (int i = 0; i < heavyCount; i++) {
+        int length;
+        if (!getRaw(in, at, loadedHeavy[i].count) || !getRaw(in, at, length)) return false;
+        if (length < 0 || at + length > in.size()) return false;
+        loadedHeavy[i].item = in.substr(at, length);
+        at += length;
+    }
+    total = loadedTotal;
+    counters.swap(loadedCounters);
+    heavy.swap(loadedHeavy);
+    pos = at;
+    return true;
+}
+
+size_t CountMinSketch::memoryUsage() const {
+    size_t bytes = sizeof(CountMinSketch) + vectorHeapBytes(counters) + vectorHeapBytes(heavy);
+    for (int i = 0; i < (int)heavy.size(); i++) bytes += stringHeapBytes(heavy[i].item);
+    return bytes;
+}
@@ -0,0 +1,79 @@
+#ifndef STREAMSKETCHES_H
+#define STREAMSKETCHES_H
+
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * HyperLogLog distinct counter: estimates how many different items were
+ * added using a fixed REGISTERS bytes, however many items there are.
+ * Adding the same item again never changes the estimate, and two counters
+ * merge into the counter of the union of their streams.
+ * Standard error is about 1.04 / sqrt(REGISTERS) (4.6% here).
+ */
+class HyperLogLog {
+public:
+    static const int PRECISION = 9;                 // bits of the hash that pick a register
+    static const int REGISTERS = 1 << PRECISION;
+
+    HyperLogLog();
+
+    void add(const string& item);
+    void merge(const HyperLogLog& other);
+    double estimate() const;
+
+    // Binary form (the raw registers), for saving between runs
+    void writeTo(string& out) const;
+    bool readFrom(const string& in, size_t& pos);
+
+private:
+    unsigned char registers[REGISTERS];     // longest run of leading zeros seen, plus one
+};
+
+/**
+ * Count-Min sketch of how often each item occurs, with heavy-hitter tracking.
+ * Counts are kept in DEPTH rows of WIDTH counters; an estimate never
+ * undercounts, and overcounts by at most e / WIDTH of the total with
+ * probability 1 - e^-DEPTH. The TRACKED items with the highest estimates are
+ * kept beside the counters, so the most frequent items can be listed without
+ * knowing them in advance. Sketches with the same dimensions merge by adding
+ * their counters.
+ */
+class CountMinSketch {
+public:
+    static const int DEPTH = 4;
+    static const int WIDTH = 2048;
+    static const int TRACKED = 20;          // heavy hitters kept (largest k that can be read)
+
+    struct HeavyHitter {
+        string item;
+        long long count;    // estimated occurrences
+    };
+
+    CountMinSketch();
+
+    long long add(const string& item, long long times = 1);
+    long long estimate(const string& item) const;
+    void merge(const CountMinSketch& other);
+    void retrack(const vector<string>& items);
+
+    // Binary form (total, counters and heavy hitters), for saving between runs
+    void writeTo(string& out) const;
+    bool readFrom(const string& in, size_t& pos);
+
+    void topItems(int k, vector<HeavyHitter>& out) const;
+    long long getTotal() const { return total; }
+    long long errorBound() const;
+    size_t memoryUsage() const;
+
+private:
+    vector<unsigned int> counters;          // DEPTH rows of WIDTH counters
+    long long total;
+    vector<HeavyHitter> heavy;              // at most TRACKED items, unordered
+
+    long long estimateHashed(unsigned long long hash) const;
+    void track(const string& item, long long count);
+};
+
+#endif
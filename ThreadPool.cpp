@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Fixed Worker Pool: Spawns one worker per hardware thread once and reuses
+ * them for every task instead of creating a thread per job.
+ * - Work Stealing: Each worker has its own deque (LIFO for its owner, FIFO
+ * for thieves), so workers rarely contend on a lock and idle ones pull work
+ * from busy ones.
+ * - Helping Waits: Threads waiting on the pool run queued tasks meanwhile,
+ * which makes nested parallelFor/parallelReduce calls safe.
+ * - Future-Based Results: Every submitted task returns a future, so callers
+ * can join on exactly the work they depend on.
+ * - Clean Shutdown: Drains the queues and joins every worker on destruction.
+ *****************************************************************************/
+
+#include "ThreadPool.h"
+using namespace std;
+
+// Ranges handed to each worker per parallelFor, to even out uneven chunks
+static const int CHUNKS_PER_THREAD = 4;
+
+thread_local ThreadPool* ThreadPool::currentPool = nullptr;
+thread_local int ThreadPool::currentWorker = -1;
+
+/**
+ * Starts the worker threads.
+ * @param threadCount Number of workers; 0 or less picks the hardware thread count.
+ */
+ThreadPool::ThreadPool(int threadCount) : queuedTasks(0), nextQueue(0), steals(0) {
+    stopping = false;
+    if (threadCount <= 0) {
+        threadCount = (int)thread::hardware_concurrency();
+        if (threadCount <= 0) threadCount = 2;
+    }
+    for (int i = 0; i < threadCount; i++) {
+        queues.push_back(unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (int i = 0; i < threadCount; i++) {
+        workers.push_back(thread(&ThreadPool::workerLoop, this, i));
+    }
+}
+
+/**
+ * Lets the workers finish every queued task, then joins them.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (int i = 0; i < (int)workers.size(); i++) {
+        workers[i].join();
+    }
+}
+
+/** @return Number of worker threads owned by the pool. */
+int ThreadPool::getThreadCount() const {
+    return (int)workers.size();
+}
+
+/** @return Tasks taken from another worker's deque so far. */
+long long ThreadPool::getSteals() const {
+    return steals.load();
+}
+
+/**
+ * Queues a task: on the current worker's own deque when called from inside
+ * the pool, otherwise on the next deque in round-robin order.
+ */
+void ThreadPool::push(function<void()> task) {
+    int target = (currentPool == this) ? currentWorker
+                                       : (int)(nextQueue.fetch_add(1) % (unsigned int)queues.size());
+    {
+        lock_guard<mutex> lock(queues[target]->lock);
+        queues[target]->tasks.push_back(task);
+    }
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        queuedTasks++;
+    }
+    workAvailable.notify_one();
+}
+
+/**
+ * Takes a task for a thread: the newest one on its own deque (index >= 0),
+ * else the oldest one on any other deque.
+ * @return False if every deque is empty.
+ */
+bool ThreadPool::take(int index, function<void()>& task) {
+    if (index >= 0) {
+        WorkerQueue& own = *queues[index];
+        lock_guard<mutex> lock(own.lock);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            queuedTasks--;
+            return true;
+        }
+    }
+    int count = (int)queues.size();
+    int start = (index >= 0) ? index + 1 : (int)(nextQueue.load() % (unsigned int)count);
+    for (int k = 0; k < count; k++) {
+        int victim = (start + k) % count;
+        if (victim == index) continue;
+        WorkerQueue& other = *queues[victim];
+        lock_guard<mutex> lock(other.lock);
+        if (!other.tasks.empty()) {
+            task = other.tasks.front();
+            other.tasks.pop_front();
+            queuedTasks--;
+            if (index >= 0) steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Runs one queued task on the calling thread (used while waiting).
+ * @return False if there was nothing to run.
+ */
+bool ThreadPool::runOne() {
+    function<void()> task;
+    if (!take((currentPool == this) ? currentWorker : -1, task)) return false;
+    task();
+    return true;
+}
+
+/** Number of ranges a parallel loop over 'items' is cut into. */
+int ThreadPool::chunkCount(int items, int grain) const {
+    if (grain < 1) grain = 1;
+    int chunks = (items + grain - 1) / grain;
+    int maxChunks = (int)workers.size() * CHUNKS_PER_THREAD;
+    if (chunks > maxChunks) chunks = maxChunks;
+    return (chunks < 1) ? 1 : chunks;
+}
+
+/**
+ * Worker body: runs its own tasks, steals when it has none, and sleeps while
+ * every deque is empty. Exits once the pool is stopping and nothing is queued.
+ */
+void ThreadPool::workerLoop(int index) {
+    currentPool = this;
+    currentWorker = index;
+    while (true) {
+        function<void()> task;
+        if (take(index, task)) {
+            task();
+            continue;
+        }
+        unique_lock<mutex> lock(sleepMutex);
+        workAvailable.wait(lock, [this]() { return stopping || queuedTasks.load() > 0; });
+        if (stopping && queuedTasks.load() <= 0) return;
+    }
+}
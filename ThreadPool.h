@@ -0,0 +1,200 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/**
+ * Work-stealing task scheduler shared by the whole program.
+ * Every worker owns a deque: it pushes and pops its own tasks at the back
+ * (newest first, still warm in cache) and, when it runs dry, steals the
+ * oldest task from the front of another worker's deque. Tasks submitted from
+ * outside the pool are dealt round-robin over the deques.
+ * Threads that wait on the pool (wait(), parallelFor, parallelReduce) run
+ * queued tasks while they wait, so tasks may themselves split work with
+ * parallelFor or wait on futures of the same pool without deadlocking.
+ */
+class ThreadPool {
+private:
+    struct WorkerQueue {
+        mutex lock;
+        deque<function<void()>> tasks;
+    };
+
+    vector<thread> workers;
+    vector<unique_ptr<WorkerQueue>> queues;     // one per worker
+    mutex sleepMutex;
+    condition_variable workAvailable;
+    atomic<int> queuedTasks;            // pushed but not yet taken
+    atomic<unsigned int> nextQueue;     // round-robin target for outside submits
+    atomic<long long> steals;
+    bool stopping;
+
+    // Worker index of the current thread in the pool it belongs to
+    static thread_local ThreadPool* currentPool;
+    static thread_local int currentWorker;
+
+    void workerLoop(int index);
+    void push(function<void()> task);
+    bool take(int index, function<void()>& task);
+    bool runOne();
+    int chunkCount(int items, int grain) const;
+
+public:
+    explicit ThreadPool(int threadCount = 0);  // 0 = one per hardware thread
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int getThreadCount() const;
+    long long getSteals() const;
+
+    template <class F>
+    auto submit(F task) -> future<decltype(task())>;
+
+    template <class R>
+    R wait(future<R>& pending);
+
+    template <class F>
+    void parallelFor(int begin, int end, int grain, F body);
+
+    template <class T, class Map, class Combine>
+    T parallelReduce(int begin, int end, int grain, T identity, Map map, Combine combine);
+};
+
+/**
+ * Queues a callable for execution on a worker thread.
+ * @param task Callable taking no arguments.
+ * @return Future that becomes ready with the callable's result.
+ */
+template <class F>
+auto ThreadPool::submit(F task) -> future<decltype(task())> {
+    typedef decltype(task()) R;
+    shared_ptr<packaged_task<R()>> job = make_shared<packaged_task<R()>>(task);
+    future<R> result = job->get_future();
+    push([job]() { (*job)(); });
+    return result;
+}
+
+/**
+ * Waits for a future of this pool, running queued tasks meanwhile.
+ * @return The task's result (rethrows its exception).
+ */
+template <class R>
+R ThreadPool::wait(future<R>& pending) {
+    while (pending.wait_for(chrono::seconds(0)) != future_status::ready) {
+        if (!runOne()) this_thread::yield();
+    }
+    return pending.get();
+}
+
+/**
+ * Calls body(from, to) over consecutive sub-ranges of [begin, end) in
+ * parallel; the calling thread takes the first range and helps with the
+ * rest. Returns once every range is done; the first exception thrown by
+ * any range is rethrown after that.
+ * @param grain Smallest range worth a task of its own.
+ */
+template <class F>
+void ThreadPool::parallelFor(int begin, int end, int grain, F body) {
+    int items = end - begin;
+    if (items <= 0) return;
+    int chunks = chunkCount(items, grain);
+    if (chunks == 1) {
+        body(begin, end);
+        return;
+    }
+
+    struct Join {
+        atomic<int> remaining;
+        mutex errorLock;
+        exception_ptr error;
+    };
+    Join join;
+    join.remaining = chunks - 1;
+
+    for (int c = 1; c < chunks; c++) {
+        int from = begin + (int)((long long)items * c / chunks);
+        int to = begin + (int)((long long)items * (c + 1) / chunks);
+        push([&join, &body, from, to]() {
+            try {
+                body(from, to);
+            }
+            catch (...) {
+                lock_guard<mutex> lock(join.errorLock);
+                if (!join.error) join.error = current_exception();
+            }
+            join.remaining--;
+        });
+    }
+    // The queued ranges refer to join and body, so even if this range throws
+    // they must finish before this frame unwinds
+    try {
+        body(begin, begin + (int)((long long)items / chunks));
+    }
+    catch (...) {
+        lock_guard<mutex> lock(join.errorLock);
+        if (!join.error) join.error = current_exception();
+    }
+
+    while (join.remaining.load() > 0) {
+        if (!runOne()) this_thread::yield();
+    }
+    if (join.error) rethrow_exception(join.error);
+}
+
+/**
+ * Maps consecutive sub-ranges of [begin, end) in parallel and folds the
+ * partial results left to right, so a non-commutative combine (such as
+ * appending lists) keeps range order.
+ * @param map Callable (from, to) -> T.
+ * @param combine Callable (T, T) -> T.
+ */
+template <class T, class Map, class Combine>
+T ThreadPool::parallelReduce(int begin, int end, int grain, T identity, Map map, Combine combine) {
+    int items = end - begin;
+    if (items <= 0) return identity;
+    int chunks = chunkCount(items, grain);
+    vector<T> partials(chunks, identity);
+    parallelFor(0, chunks, 1, [&](int first, int last) {
+        for (int c = first; c < last; c++) {
+            partials[c] = map(begin + (int)((long long)items * c / chunks),
+                              begin + (int)((long long)items * (c + 1) / chunks));
+        }
+    });
+    T total = identity;
+    for (int c = 0; c < chunks; c++) total = combine(move(total), partials[c]);
+    return total;
+}
+
+// Helpers for code that may run without a pool: a null pool runs inline on
+// the calling thread (used as the serial baseline by the admin benchmark)
+
+template <class F>
+void parallelFor(ThreadPool* pool, int begin, int end, int grain, F body) {
+    if (pool == nullptr) {
+        if (end > begin) body(begin, end);
+        return;
+    }
+    pool->parallelFor(begin, end, grain, body);
+}
+
+template <class T, class Map, class Combine>
+T parallelReduce(ThreadPool* pool, int begin, int end, int grain, T identity, Map map, Combine combine) {
+    if (pool == nullptr) return (end > begin) ? combine(identity, map(begin, end)) : identity;
+    return pool->parallelReduce(begin, end, grain, identity, map, combine);
+}
+
+#endif
@@ -0,0 +1,348 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Symmetric Deletion: Tokens within k edits of a query share a deletion
+ * variant with it, so typo lookups are a few binary searches instead of a
+ * scan over the vocabulary.
+ * - Bit-Parallel Edit Distance: Myers' algorithm computes Levenshtein
+ * distance one text character per step using 64-bit masks.
+ * - Rarest-Token Driving: Candidates come from the query token with the
+ * fewest matching games; the other tokens are only checked on those games.
+ *****************************************************************************/
+
+#include "TitleIndex.h"
+#include "MemoryFootprint.h"
+#include "Game.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+using namespace std;
+
+// --- TOKENS & DISTANCE ---
+
+/** Splits text into lowercase alphanumeric tokens ("7 Wonders: Duel" -> 7, wonders, duel). */
+void TitleIndex::tokenize(const string& text, vector<string>& tokens) {
+    string current;
+    for (char c : text) {
+        unsigned char u = (unsigned char)c;
+        if (isalnum(u)) current += (char)tolower(u);
+        else if (!current.empty()) {
+            tokens.push_back(current);
+            current.clear();
+        }
+    }
+    if (!current.empty()) tokens.push_back(current);
+}
+
+/** Plain dynamic-programming Levenshtein distance (used for tokens over 64 chars). */
+static int editDistanceDP(const string& a, const string& b) {
+    vector<int> row(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); j++) row[j] = (int)j;
+    for (size_t i = 1; i <= a.size(); i++) {
+        int diagonal = row[0];
+        row[0] = (int)i;
+        for (size_t j = 1; j <= b.size(); j++) {
+            int above = row[j];
+            int cost = (a[i - 1] == b[j - 1]) ? 0 : 1;
+            row[j] = min(min(row[j] + 1, row[j - 1] + 1), diagonal + cost);
+            diagonal = above;
+        }
+    }
+    return row[b.size()];
+}
+
+/**
+ * Levenshtein distance using Myers' bit-vector algorithm (Hyyrö's
+ * formulation for whole-string distance). Each bit of Pv/Mv holds the +1/-1
+ * vertical delta of one pattern position, so a column of the DP table is
+ * updated with a handful of word operations.
+ */
+int TitleIndex::editDistance(const string& a, const string& b) {
+    const string& pattern = (a.size() <= b.size()) ? a : b;
+    const string& text = (a.size() <= b.size()) ? b : a;
+    size_t m = pattern.size();
+    if (m == 0) return (int)text.size();
+    if (m > 64) return editDistanceDP(a, b);
+
+    uint64_t peq[256] = { 0 };
+    for (size_t i = 0; i < m; i++) peq[(unsigned char)pattern[i]] |= (uint64_t)1 << i;
+
+    uint64_t pv = ~(uint64_t)0;
+    uint64_t mv = 0;
+    uint64_t last = (uint64_t)1 << (m - 1);
+    int score = (int)m;
+
+    for (size_t j = 0; j < text.size(); j++) {
+        uint64_t eq = peq[(unsigned char)text[j]];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & last) score++;
+        else if (mh & last) score--;
+        ph = (ph << 1) | 1;     // top row of the table grows by one per column
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+    return score;
+}
+
+/** Typos tolerated for a query token: none for short words, up to two for long ones. */
+int TitleIndex::allowedTypos(const string& token) {
+    if (token.size() <= 3) return 0;
+    if (token.size() <= 6) return 1;
+    return 2;
+}
+
+// --- SYMMETRIC DELETION ---
+
+// Recent variants are merged into the main array once there are this many
+static const size_t RECENT_LIMIT = 4096;
+
+/** 32-bit FNV-1a hash of a deletion variant. */
+static unsigned long long variantHash(const string& text) {
+    unsigned int h = 2166136261u;
+    for (char c : text) {
+        h ^= (unsigned char)c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/** Collects every distinct string reachable by deleting up to 'deletes' characters. */
+static void deletionVariants(const string& token, int deletes, vector<string>& out) {
+    vector<string> level(1, token);
+    out.assign(1, token);
+    for (int round = 0; round < deletes; round++) {
+        vector<string> next;
+        for (int v = 0; v < (int)level.size(); v++) {
+            for (size_t i = 0; i < level[v].size(); i++) {
+                next.push_back(level[v].substr(0, i) + level[v].substr(i + 1));
+            }
+        }
+        sort(next.begin(), next.end());
+        next.erase(unique(next.begin(), next.end()), next.end());
+        out.insert(out.end(), next.begin(), next.end());
+        level.swap(next);
+    }
+    sort(out.begin(), out.end());
+    out.erase(unique(out.begin(), out.end()), out.end());
+}
+
+/** Appends the token ids stored under one hash in a sorted entry array. */
+static void probe(const vector<unsigned long long>& entries, unsigned long long hash, vector<int>& ids) {
+    vector<unsigned long long>::const_iterator it = lower_bound(entries.begin(), entries.end(), hash << 32);
+    for (; it != entries.end() && (*it >> 32) == hash; ++it) ids.push_back((int)(*it & 0xFFFFFFFFull));
+}
+
+/**
+ * @return The id of a token, adding it to the vocabulary and the deletion
+ * index if it is new.
+ */
+int TitleIndex::internToken(const string& token) {
+    map<string, int>::iterator found = tokenIds.find(token);
+    if (found != tokenIds.end()) return found->second;
+
+    int id = (int)tokenText.size();
+    tokenIds.insert(make_pair(token, id));
+    tokenText.push_back(token);
+    postings.push_back(vector<Game*>());
+
+    vector<string> variants;
+    deletionVariants(token, MAX_TYPOS, variants);
+    for (int v = 0; v < (int)variants.size(); v++) {
+        unsigned long long entry = (variantHash(variants[v]) << 32) | (unsigned long long)id;
+        recent.insert(upper_bound(recent.begin(), recent.end(), entry), entry);
+    }
+    if (recent.size() >= RECENT_LIMIT) {
+        size_t middle = deletions.size();
+        deletions.insert(deletions.end(), recent.begin(), recent.end());
+        inplace_merge(deletions.begin(), deletions.begin() + middle, deletions.end());
+        recent.clear();
+    }
+    return id;
+}
+
+/**
+ * Collects (token id, distance) for indexed tokens that start with the query
+ * (distance 0) or are within maxDistance edits of it.
+ */
+void TitleIndex::findTokens(const string& query, int maxDistance, vector<pair<int, int>>& out) const {
+    for (map<string, int>::const_iterator it = tokenIds.lower_bound(query);
+         it != tokenIds.end() && it->first.compare(0, query.size(), query) == 0; ++it) {
+        out.push_back(make_pair(it->second, 0));
+    }
+    if (maxDistance == 0) return;
+    if (maxDistance > MAX_TYPOS) maxDistance = MAX_TYPOS;
+
+    // Any token within k edits shares a variant with the query (k deletions each side)
+    vector<string> variants;
+    deletionVariants(query, maxDistance, variants);
+    vector<int> ids;
+    for (int v = 0; v < (int)variants.size(); v++) {
+        unsigned long long hash = variantHash(variants[v]);
+        probe(deletions, hash, ids);
+        probe(recent, hash, ids);
+    }
+    sort(ids.begin(), ids.end());
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+
+    for (int i = 0; i < (int)ids.size(); i++) {
+        const string& text = tokenText[ids[i]];
+        if (text.compare(0, query.size(), query) == 0) continue;  // already a prefix match
+        int lengthGap = (int)text.size() - (int)query.size();
+        if (lengthGap > maxDistance || -lengthGap > maxDistance) continue;
+        int d = editDistance(query, text);
+        if (d <= maxDistance) out.push_back(make_pair(ids[i], d));
+    }
+}
+
+// --- CATALOG ---
+
+/** Indexes a game's title. The pointer must stay valid until remove(). */
+void TitleIndex::add(Game* game) {
+    if (gameTokens.count(game)) return;
+
+    vector<string> tokens;
+    tokenize(game->getTitle(), tokens);
+    vector<int>& ids = gameTokens[game];
+    for (int i = 0; i < (int)tokens.size(); i++) {
+        int id = internToken(tokens[i]);
+        if (find(ids.begin(), ids.end(), id) != ids.end()) continue;
+        ids.push_back(id);
+        postings[id].push_back(game);
+    }
+}
+
+/**
+ * Drops a game from the postings. Its tokens stay in the vocabulary but no
+ * longer lead to any game.
+ */
+void TitleIndex::remove(Game* game) {
+    unordered_map<Game*, vector<int>>::iterator it = gameTokens.find(game);
+    if (it == gameTokens.end()) return;
+    for (int i = 0; i < (int)it->second.size(); i++) {
+        vector<Game*>& games = postings[it->second[i]];
+        games.erase(std::remove(games.begin(), games.end(), game), games.end());
+    }
+    gameTokens.erase(it);
+}
+
+/**
+ * @return The fewest edits from a query token to any of the title's tokens,
+ * looked up in that query token's match set, or -1 if none matched.
+ */
+static int bestTokenDistance(const unordered_map<int, int>& matched, const vector<int>& titleTokens) {
+    int best = -1;
+    for (int i = 0; i < (int)titleTokens.size(); i++) {
+        unordered_map<int, int>::const_iterator it = matched.find(titleTokens[i]);
+        if (it != matched.end() && (best == -1 || it->second < best)) best = it->second;
+    }
+    return best;
+}
+
+static bool betterMatch(const TitleIndex::Match& a, const TitleIndex::Match& b) {
+    if (a.distance != b.distance) return a.distance < b.distance;
+    return a.game->getTitle() < b.game->getTitle();
+}
+
+/**
+ * Finds games whose title matches every query token (allowing typos), best
+ * matches first.
+ * Candidates come from the query token that leads to the fewest games, taken
+ * in order of increasing distance. Once maxResults matches are found that no
+ * remaining candidate can beat, the search stops (ties at the cut-off are
+ * kept in index order rather than by title).
+ * @param query Free-text query, e.g. "wonder duel".
+ * @param maxResults Upper bound on the number of matches returned.
+ * @param out Receives matches ordered by distance, then title.
+ */
+void TitleIndex::search(const string& query, int maxResults, vector<Match>& out) const {
+    vector<string> queryTokens;
+    tokenize(query, queryTokens);
+    sort(queryTokens.begin(), queryTokens.end());
+    queryTokens.erase(unique(queryTokens.begin(), queryTokens.end()), queryTokens.end());
+    if (queryTokens.empty() || maxResults <= 0) return;
+
+    // Indexed tokens close to each query token, and the one leading to the fewest games
+    vector<unordered_map<int, int>> matched(queryTokens.size());
+    int driver = 0;
+    size_t driverGames = 0;
+    for (int q = 0; q < (int)queryTokens.size(); q++) {
+        vector<pair<int, int>> found;
+        findTokens(queryTokens[q], allowedTypos(queryTokens[q]), found);
+        size_t games = 0;
+        for (int i = 0; i < (int)found.size(); i++) {
+            if (postings[found[i].first].empty()) continue;
+            matched[q][found[i].first] = found[i].second;
+            games += postings[found[i].first].size();
+        }
+        if (games == 0) return;  // this token matches nothing, so no title matches all tokens
+        if (q == 0 || games < driverGames) {
+            driver = q;
+            driverGames = games;
+        }
+    }
+
+    vector<pair<int, int>> driverTokens;   // (distance, token id)
+    for (unordered_map<int, int>::const_iterator it = matched[driver].begin(); it != matched[driver].end(); ++it) {
+        driverTokens.push_back(make_pair(it->second, it->first));
+    }
+    sort(driverTokens.begin(), driverTokens.end());
+
+    vector<Match> results;
+    unordered_map<Game*, bool> seen;
+    int settled = 0;    // results scoring <= d, which nothing later can beat
+    for (int t = 0; t < (int)driverTokens.size() && settled < maxResults; t++) {
+        int d = driverTokens[t].first;
+        if (t > 0 && driverTokens[t - 1].first != d) {
+            settled = 0;
+            for (int r = 0; r < (int)results.size(); r++) if (results[r].distance <= d) settled++;
+            if (settled >= maxResults) break;
+        }
+
+        const vector<Game*>& games = postings[driverTokens[t].second];
+        for (int g = 0; g < (int)games.size() && settled < maxResults; g++) {
+            if (!seen.insert(make_pair(games[g], true)).second) continue;
+
+            int total = d;
+            if (queryTokens.size() > 1) {
+                const vector<int>& titleTokens = gameTokens.at(games[g]);
+                for (int q = 0; q < (int)queryTokens.size() && total >= 0; q++) {
+                    if (q == driver) continue;
+                    int other = bestTokenDistance(matched[q], titleTokens);
+                    total = (other < 0) ? -1 : total + other;
+                }
+            }
+            if (total >= 0) {
+                Match match = { games[g], total };
+                results.push_back(match);
+                if (total <= d) settled++;
+            }
+        }
+    }
+
+    int keep = ((int)results.size() < maxResults) ? (int)results.size() : maxResults;
+    partial_sort(results.begin(), results.begin() + keep, results.end(), betterMatch);
+    out.insert(out.end(), results.begin(), results.begin() + keep);
+}
+
+/** @return Approximate heap bytes used by the token map, postings and deletion index. */
+size_t TitleIndex::memoryUsage() const {
+    // red-black tree node: value plus three links and a colour word
+    size_t bytes = tokenIds.size() * (sizeof(pair<const string, int>) + 4 * sizeof(void*));
+    for (map<string, int>::const_iterator it = tokenIds.begin(); it != tokenIds.end(); ++it) {
+        bytes += stringHeapBytes(it->first);
+    }
+    bytes += vectorHeapBytes(tokenText) + vectorHeapBytes(postings);
+    for (size_t i = 0; i < tokenText.size(); i++) bytes += stringHeapBytes(tokenText[i]);
+    for (size_t i = 0; i < postings.size(); i++) bytes += vectorHeapBytes(postings[i]);
+    bytes += hashMapHeapBytes(gameTokens);
+    for (unordered_map<Game*, vector<int>>::const_iterator it = gameTokens.begin(); it != gameTokens.end(); ++it) {
+        bytes += vectorHeapBytes(it->second);
+    }
+    return bytes + vectorHeapBytes(deletions) + vectorHeapBytes(recent);
+}
@@ -0,0 +1,57 @@
+#ifndef TITLEINDEX_H
+#define TITLEINDEX_H
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+class Game;
+
+/**
+ * Typo-tolerant title index.
+ * Titles are split into lowercase alphanumeric tokens; each distinct token
+ * maps to the games whose title contains it. Typos are found with a
+ * symmetric-deletion index: every string reachable from a token by deleting
+ * up to MAX_TYPOS characters is hashed and stored, so a query only probes
+ * its own deletion variants and verifies the hits with Myers' bit-parallel
+ * edit distance. Prefix matches come from the sorted token map.
+ */
+class TitleIndex {
+public:
+    struct Match {
+        Game* game;
+        int distance;   // total edits across the query tokens (0 = exact/prefix)
+    };
+
+    static const int MAX_TYPOS = 2;
+
+private:
+    map<string, int> tokenIds;                  // sorted, so prefixes are a range
+    vector<string> tokenText;                   // token id -> text
+    vector<vector<Game*>> postings;             // token id -> games containing it
+    unordered_map<Game*, vector<int>> gameTokens;
+
+    // (variant hash << 32 | token id), sorted. New tokens go to the small
+    // 'recent' array first and are merged into 'deletions' in batches.
+    vector<unsigned long long> deletions;
+    vector<unsigned long long> recent;
+
+    int internToken(const string& token);
+    void findTokens(const string& query, int maxDistance, vector<pair<int, int>>& out) const;
+
+public:
+    static void tokenize(const string& text, vector<string>& tokens);
+    static int editDistance(const string& a, const string& b);
+    static int allowedTypos(const string& token);
+
+    void add(Game* game);
+    void remove(Game* game);
+
+    void search(const string& query, int maxResults, vector<Match>& out) const;
+
+    size_t memoryUsage() const;     // approximate heap bytes (see MemoryFootprint.h)
+};
+
+#endif
@@ -0,0 +1,196 @@
+/******************************************************************************
+ * Team Member: Ashton, Caden
+ * Group: 7
+ * Student IDs: S10267643, S10267163
+ * Highlighted Features:
+ * - Radix Trie: Titles sharing a prefix share nodes, and single-child chains
+ * are collapsed into one edge, so the trie stays small for long titles.
+ * - Prefix Completion: "Top N titles starting with P" walks |P| characters
+ * down the trie and then lists the first N titles in alphabetical order.
+ * - Incremental Updates: Inserts split an edge where needed and removals merge
+ * it back, so the trie never has to be rebuilt.
+ *****************************************************************************/
+
+#include "TitleTrie.h"
+#include "MemoryFootprint.h"
+#include "Game.h"
+#include "TitleIndex.h"
+#include <algorithm>
+using namespace std;
+
+TitleTrie::TitleTrie() {
+    root = new Node();
+}
+
+TitleTrie::~TitleTrie() {
+    destroy(root);
+    root = nullptr;
+}
+
+void TitleTrie::destroy(Node* node) {
+    for (int i = 0; i < (int)node->children.size(); i++) destroy(node->children[i]);
+    delete node;
+}
+
+/**
+ * Lowercases a title and keeps only its words, separated by single spaces,
+ * so "7 Wonders: Duel" and "7 wonders duel" land on the same key.
+ */
+string TitleTrie::normalize(const string& title) {
+    vector<string> words;
+    TitleIndex::tokenize(title, words);
+    string key;
+    for (int i = 0; i < (int)words.size(); i++) {
+        if (i > 0) key += ' ';
+        key += words[i];
+    }
+    return key;
+}
+
+/** @return Position of the child whose label starts with 'first', or where it would go. */
+int TitleTrie::childSlot(const Node* node, char first) {
+    int low = 0;
+    int high = (int)node->children.size();
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (node->children[mid]->label[0] < first) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+/** Length of the common prefix of 'label' and key[from..]. */
+static size_t sharedLength(const string& label, const string& key, size_t from) {
+    size_t n = 0;
+    while (n < label.size() && from + n < key.size() && label[n] == key[from + n]) n++;
+    return n;
+}
+
+/**
+ * Adds a game under its normalized title.
+ * Time Complexity: O(L) where L is the title length
+ */
+void TitleTrie::insert(Game* game) {
+    string key = normalize(game->getTitle());
+    Node* node = root;
+    size_t pos = 0;
+
+    while (pos < key.size()) {
+        int slot = childSlot(node, key[pos]);
+        if (slot == (int)node->children.size() || node->children[slot]->label[0] != key[pos]) {
+            Node* leaf = new Node();
+            leaf->label = key.substr(pos);
+            leaf->games.push_back(game);
+            node->children.insert(node->children.begin() + slot, leaf);
+            return;
+        }
+
+        Node* child = node->children[slot];
+        size_t shared = sharedLength(child->label, key, pos);
+        if (shared < child->label.size()) {
+            // The key leaves this edge part way: split it at the divergence point
+            Node* middle = new Node();
+            middle->label = child->label.substr(0, shared);
+            child->label.erase(0, shared);
+            middle->children.push_back(child);
+            node->children[slot] = middle;
+            child = middle;
+        }
+        node = child;
+        pos += shared;
+    }
+    node->games.push_back(game);
+}
+
+/**
+ * Removes a game and prunes or merges nodes it leaves redundant.
+ * Time Complexity: O(L + G) where G is the number of games with the same title
+ */
+void TitleTrie::remove(Game* game) {
+    string key = normalize(game->getTitle());
+    vector<Node*> path(1, root);
+    vector<int> slots;
+    size_t pos = 0;
+
+    while (pos < key.size()) {
+        Node* node = path.back();
+        int slot = childSlot(node, key[pos]);
+        if (slot == (int)node->children.size()) return;
+        Node* child = node->children[slot];
+        if (key.compare(pos, child->label.size(), child->label) != 0) return;
+        path.push_back(child);
+        slots.push_back(slot);
+        pos += child->label.size();
+    }
+
+    Node* node = path.back();
+    vector<Game*>::iterator it = find(node->games.begin(), node->games.end(), game);
+    if (it == node->games.end()) return;
+    node->games.erase(it);
+
+    // Walk back up, removing empty leaves and collapsing single-child chains
+    for (int depth = (int)path.size() - 1; depth > 0; depth--) {
+        Node* current = path[depth];
+        Node* parent = path[depth - 1];
+        if (!current->games.empty() || current->children.size() > 1) break;
+
+        if (current->children.empty()) {
+            parent->children.erase(parent->children.begin() + slots[depth - 1]);
+            delete current;
+            continue;
+        }
+
+        Node* only = current->children[0];
+        only->label = current->label + only->label;
+        parent->children[slots[depth - 1]] = only;
+        delete current;
+        break;
+    }
+}
+
+/** Pre-order walk: a node's own titles sort before its children's. */
+void TitleTrie::collect(const Node* node, int maxResults, vector<Game*>& out) {
+    for (int i = 0; i < (int)node->games.size() && (int)out.size() < maxResults; i++) {
+        out.push_back(node->games[i]);
+    }
+    for (int i = 0; i < (int)node->children.size() && (int)out.size() < maxResults; i++) {
+        collect(node->children[i], maxResults, out);
+    }
+}
+
+/**
+ * Lists up to maxResults games whose normalized title starts with the
+ * normalized prefix, in alphabetical order.
+ * Time Complexity: O(|P| + N)
+ */
+void TitleTrie::complete(const string& prefix, int maxResults, vector<Game*>& out) const {
+    string key = normalize(prefix);
+    const Node* node = root;
+    size_t pos = 0;
+
+    while (pos < key.size()) {
+        int slot = childSlot(node, key[pos]);
+        if (slot == (int)node->children.size() || node->children[slot]->label[0] != key[pos]) return;
+        const Node* child = node->children[slot];
+        size_t shared = sharedLength(child->label, key, pos);
+        if (pos + shared < key.size() && shared < child->label.size()) return;
+        node = child;
+        pos += shared;
+    }
+
+    int limit = (int)out.size() + maxResults;
+    collect(node, limit, out);
+}
+
+/** Heap bytes of a subtree: nodes, edge labels and child/game lists. */
+size_t TitleTrie::nodeBytes(const Node* node) {
+    size_t bytes = sizeof(Node) + stringHeapBytes(node->label) +
+                   vectorHeapBytes(node->children) + vectorHeapBytes(node->games);
+    for (int i = 0; i < (int)node->children.size(); i++) bytes += nodeBytes(node->children[i]);
+    return bytes;
+}
+
+/** @return Approximate heap bytes used by the trie. */
+size_t TitleTrie::memoryUsage() const {
+    return nodeBytes(root);
+}
@@ -0,0 +1,49 @@
+#ifndef TITLETRIE_H
+#define TITLETRIE_H
+
+#include <string>
+#include <vector>
+using namespace std;
+
+class Game;
+
+/**
+ * Radix trie over normalized titles ("7 Wonders: Duel" -> "7 wonders duel").
+ * Each edge holds a run of characters and every node has either a game or at
+ * least two children, so listing the first N titles under a prefix visits
+ * O(|P| + N) nodes. Children are kept sorted, which makes the listing
+ * alphabetical.
+ */
+class TitleTrie {
+private:
+    struct Node {
+        string label;               // characters on the edge from the parent
+        vector<Node*> children;     // sorted by the first character of their label
+        vector<Game*> games;        // games whose normalized title ends here
+    };
+
+    Node* root;
+
+    static int childSlot(const Node* node, char first);
+    static void destroy(Node* node);
+    static void collect(const Node* node, int maxResults, vector<Game*>& out);
+    static size_t nodeBytes(const Node* node);
+
+public:
+    TitleTrie();
+    ~TitleTrie();
+
+    TitleTrie(const TitleTrie&) = delete;
+    TitleTrie& operator=(const TitleTrie&) = delete;
+
+    static string normalize(const string& title);
+
+    void insert(Game* game);
+    void remove(Game* game);
+
+    void complete(const string& prefix, int maxResults, vector<Game*>& out) const;
+
+    size_t memoryUsage() const;     // approximate heap bytes (see MemoryFootprint.h)
+};
+
+#endif
@@ -1,5 +1,5 @@
 #include "User.h"
-#include <iostream>
+#include "ConsoleRenderer.h"
 using namespace std;
 
 User::User() {
@@ -14,15 +14,20 @@ User::User(string id, string n, Role r) {
     role = r;
 }
 
-string User::getUserID() const { return userID; }
-string User::getName() const { return name; }
+const string& User::getUserID() const { return userID; }
+const string& User::getName() const { return name; }
 Role User::getRole() const { return role; }
 
 bool User::isAdmin() const { return role == ADMIN; }
 bool User::isMember() const { return role == MEMBER; }
 
 void User::print() const {
-    cout << "User ID: " << userID << "\n";
-    cout << "Name: " << name << "\n";
-    cout << "Role: " << (role == ADMIN ? "ADMIN" : "MEMBER") << "\n";
+    ConsoleRenderer out;
+    render(out);
+}
+
+void User::render(ConsoleRenderer& out) const {
+    out.text("User ID: ").text(userID).newline();
+    out.text("Name: ").text(name).newline();
+    out.text("Role: ").text(role == ADMIN ? "ADMIN" : "MEMBER").newline();
 }
@@ -4,6 +4,8 @@
 #include <string>
 using namespace std;
 
+class ConsoleRenderer;
+
 enum Role {
     ADMIN = 0,
     MEMBER = 1
@@ -19,14 +21,15 @@ public:
     User();
     User(string id, string n, Role r);
 
-    string getUserID() const;
-    string getName() const;
+    const string& getUserID() const;
+    const string& getName() const;
     Role getRole() const;
 
     bool isAdmin() const;
     bool isMember() const;
 
     void print() const;
+    void render(ConsoleRenderer& out) const;
 };
 
 #endif
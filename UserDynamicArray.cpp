@@ -5,16 +5,23 @@
  * Highlighted Features:
  * - Dynamic Resizing: Implements a growth factor of 2x to ensure efficient
  * amortized O(1) addition of user accounts.
- * - Linear Search: Optimized UserID lookup used for authentication and
- * account management.
+ * - Open Addressing: UserID lookups (every login and uniqueness check) probe
+ * a linear-probing hash table instead of scanning the directory.
+ * - Backward-Shift Deletion: Removing a user closes the probe chain without
+ * tombstones, so lookups stay short after many removals.
  * - Contiguous Storage: Uses direct object storage for better cache locality
  * when iterating through the user directory.
  *****************************************************************************/
 
 #include "UserDynamicArray.h"
+#include "ConsoleRenderer.h"
+#include <algorithm>
+#include <cctype>
 #include <iostream>
 using namespace std;
 
+static const int EMPTY_SLOT = -1;
+
 /**
  * Default constructor for UserDynamicArray.
  * Allocates an initial capacity of 10 User objects on the heap.
@@ -23,6 +30,11 @@ UserDynamicArray::UserDynamicArray() {
     capacity = 10;
     count = 0;
     data = new User[capacity];
+    hashes = new unsigned int[capacity];
+
+    tableSize = 16;
+    table = new int[tableSize];
+    for (int i = 0; i < tableSize; i++) table[i] = EMPTY_SLOT;
 }
 
 /**
@@ -31,6 +43,8 @@ UserDynamicArray::UserDynamicArray() {
  */
 UserDynamicArray::~UserDynamicArray() {
     delete[] data;
+    delete[] hashes;
+    delete[] table;
 }
 
 /**
@@ -40,16 +54,89 @@ UserDynamicArray::~UserDynamicArray() {
 void UserDynamicArray::resize() {
     int newCap = capacity * 2;
     User* newData = new User[newCap];
+    unsigned int* newHashes = new unsigned int[newCap];
 
     for (int i = 0; i < count; i++) {
         newData[i] = data[i];
+        newHashes[i] = hashes[i];
     }
 
     delete[] data;
+    delete[] hashes;
     data = newData;
+    hashes = newHashes;
     capacity = newCap;
 }
 
+/** Doubles the hash table and re-inserts every user (using the cached hashes). */
+void UserDynamicArray::growTable() {
+    delete[] table;
+    tableSize *= 2;
+    table = new int[tableSize];
+    for (int i = 0; i < tableSize; i++) table[i] = EMPTY_SLOT;
+
+    int mask = tableSize - 1;
+    for (int i = 0; i < count; i++) {
+        int slot = (int)(hashes[i] & mask);
+        while (table[slot] != EMPTY_SLOT) slot = (slot + 1) & mask;
+        table[slot] = i;
+    }
+}
+
+/** 32-bit FNV-1a hash of a userID. */
+unsigned int UserDynamicArray::hashID(const string& userID) {
+    unsigned int h = 2166136261u;
+    for (char c : userID) {
+        h ^= (unsigned char)c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/** Names are indexed case-insensitively ("bob" finds "Bob"). */
+string UserDynamicArray::nameKey(const string& name) {
+    string key = name;
+    for (char& c : key) c = (char)tolower((unsigned char)c);
+    return key;
+}
+
+/**
+ * Probes for a userID.
+ * @return The slot holding it, or the empty slot where it would be inserted.
+ */
+int UserDynamicArray::findSlot(const string& userID, unsigned int hash) const {
+    int mask = tableSize - 1;
+    int slot = (int)(hash & mask);
+    while (table[slot] != EMPTY_SLOT) {
+        int index = table[slot];
+        if (hashes[index] == hash && data[index].getUserID() == userID) return slot;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * Empties a slot and shifts later entries of the same probe chain back into
+ * the hole, so no entry ends up behind an empty slot it has to probe past.
+ */
+void UserDynamicArray::eraseSlot(int slot) {
+    int mask = tableSize - 1;
+    int hole = slot;
+    int next = (hole + 1) & mask;
+    while (table[next] != EMPTY_SLOT) {
+        int home = (int)(hashes[table[next]] & mask);
+        // Distance from home to its current slot vs. to the hole (cyclically)
+        int toNext = (next - home) & mask;
+        int toHole = (hole - home) & mask;
+        if (toHole < toNext) {
+            table[hole] = table[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    table[hole] = EMPTY_SLOT;
+}
+
 /**
  * @return The number of users currently stored in the array.
  */
@@ -58,11 +145,11 @@ int UserDynamicArray::size() const {
 }
 
 /**
- * Retrieves a copy of the User object at the specified index.
+ * Retrieves the User object at the specified index without copying it.
  * @param index The position in the array.
- * @return A copy of the User object.
+ * @return Read-only reference to the User object.
  */
-User UserDynamicArray::get(int index) const {
+const User& UserDynamicArray::get(int index) const {
     return data[index];
 }
 
@@ -77,28 +164,38 @@ User* UserDynamicArray::getPtr(int index) {
 }
 
 /**
- * Adds a new user to the end of the array.
+ * Adds a new user to the end of the array and indexes it.
  * Automatically triggers a resize if the capacity is reached.
  * @param u The user object to be added.
+ * @return False (and nothing is added) if the userID already exists.
+ * Time Complexity: O(1) amortized
  */
-void UserDynamicArray::add(const User& u) {
+bool UserDynamicArray::add(const User& u) {
+    unsigned int hash = hashID(u.getUserID());
+    int slot = findSlot(u.getUserID(), hash);
+    if (table[slot] != EMPTY_SLOT) return false;
+
     if (count >= capacity) resize();
     data[count] = u;
+    hashes[count] = hash;
+    table[slot] = count;
     count++;
+    nameIndex[nameKey(u.getName())].push_back(u.getUserID());
+
+    // Keep the load factor at or below 1/2 so probe chains stay short
+    if (count * 2 > tableSize) growTable();
+    return true;
 }
 
 /**
- * Searches for a user's index based on their unique UserID.
+ * Looks up a user's index based on their unique UserID.
  * @param userID The string ID to search for.
  * @return The integer index if found, -1 otherwise.
+ * Time Complexity: O(1) average
  */
 int UserDynamicArray::findIndexByUserID(const string& userID) const {
-    for (int i = 0; i < count; i++) {
-        if (data[i].getUserID() == userID) {
-            return i;
-        }
-    }
-    return -1;
+    int slot = findSlot(userID, hashID(userID));
+    return table[slot];     // EMPTY_SLOT is -1
 }
 
 /**
@@ -112,19 +209,45 @@ User* UserDynamicArray::findByUserID(const string& userID) {
     return &data[idx];
 }
 
+/**
+ * Collects every user with the given name (case-insensitive).
+ * @param name Full name to look up.
+ * @param out Receives pointers to the matching users.
+ */
+void UserDynamicArray::findByName(const string& name, vector<User*>& out) {
+    unordered_map<string, vector<string>>::const_iterator it = nameIndex.find(nameKey(name));
+    if (it == nameIndex.end()) return;
+    for (int i = 0; i < (int)it->second.size(); i++) {
+        User* user = findByUserID(it->second[i]);
+        if (user != nullptr) out.push_back(user);
+    }
+}
+
 /**
  * Removes a user from the array by their ID.
- * Shifts all subsequent elements left to maintain array contiguousness.
+ * The last user moves into the freed position so nothing else shifts.
  * @param userID The string ID of the user to remove.
  * @return True if removal was successful, false if user not found.
+ * Time Complexity: O(1) average
  */
 bool UserDynamicArray::removeByUserID(const string& userID) {
-    int idx = findIndexByUserID(userID);
-    if (idx == -1) return false;
+    int slot = findSlot(userID, hashID(userID));
+    int idx = table[slot];
+    if (idx == EMPTY_SLOT) return false;
+
+    vector<string>& sameName = nameIndex[nameKey(data[idx].getName())];
+    sameName.erase(find(sameName.begin(), sameName.end(), userID));
+    if (sameName.empty()) nameIndex.erase(nameKey(data[idx].getName()));
 
-    for (int i = idx; i < count - 1; i++) {
-        data[i] = data[i + 1];
+    eraseSlot(slot);
+
+    int last = count - 1;
+    if (idx != last) {
+        data[idx] = data[last];
+        hashes[idx] = hashes[last];
+        table[findSlot(data[idx].getUserID(), hashes[idx])] = idx;
     }
+    data[last] = User();
     count--;
     return true;
 }
@@ -133,8 +256,9 @@ bool UserDynamicArray::removeByUserID(const string& userID) {
  * Iterates through the array and prints the details of every user.
  */
 void UserDynamicArray::printAll() const {
+    ConsoleRenderer out;
     for (int i = 0; i < count; i++) {
-        cout << "---------------------\n";
-        data[i].print();
+        out.text("---------------------\n");
+        data[i].render(out);
     }
-}
\ No newline at end of file
+}
@@ -3,28 +3,54 @@
 
 #include "User.h"
 #include <string>
+#include <unordered_map>
+#include <vector>
 using namespace std;
 
+/**
+ * User directory.
+ * Users are stored contiguously; an open-addressing hash table (linear
+ * probing, backward-shift deletion) maps each userID to its position, so
+ * add, remove and lookup are O(1) regardless of membership size. Removal
+ * moves the last user into the gap. A second index maps lowercase names to
+ * the userIDs that carry them.
+ */
 class UserDynamicArray {
 private:
     User* data;
+    unsigned int* hashes;       // hash of data[i]'s userID, kept to avoid rehashing
     int capacity;
     int count;
 
+    int* table;                 // slot -> index into data, EMPTY_SLOT if unused
+    int tableSize;              // always a power of two
+
+    unordered_map<string, vector<string>> nameIndex;   // lowercase name -> userIDs
+
     void resize();
+    void growTable();
+    int findSlot(const string& userID, unsigned int hash) const;
+    void eraseSlot(int slot);
+
+    static unsigned int hashID(const string& userID);
+    static string nameKey(const string& name);
 
 public:
     UserDynamicArray();
     ~UserDynamicArray();
 
+    UserDynamicArray(const UserDynamicArray&) = delete;
+    UserDynamicArray& operator=(const UserDynamicArray&) = delete;
+
     int size() const;
-    User get(int index) const;
+    const User& get(int index) const;
     User* getPtr(int index);
 
-    void add(const User& u);
+    bool add(const User& u);
 
     int findIndexByUserID(const string& userID) const;
     User* findByUserID(const string& userID);
+    void findByName(const string& name, vector<User*>& out);
 
     bool removeByUserID(const string& userID);
 
@@ -3,24 +3,47 @@
  * Group: 7
  * Student IDs: S10267643, S10267163
  * Highlighted Features:
- * - Unified Data Loading: Initializes all data structures from CSV files and
- * reconstructs game availability based on active borrow records at startup.
+ * - Unified Data Loading: Initializes all data structures from CSV files in a
+ * parallel startup pipeline and reconstructs game availability based on
+ * active borrow records at startup.
  * - Role-Based Access Control: Directs users to Admin or Member menus based on
  * their role, restricting sensitive operations to administrators only.
- * - Graceful Shutdown: Automatically persists all data changes (games, users,
- * records, reviews, browse history) back to CSV files before exiting.
+ * - Shared Thread Pool: One work-stealing pool is created at startup and lent
+ * to every component that splits work across threads.
+ * - Catalog Snapshots: After loading, the catalog publishes read-only versions
+ * that background threads read without locks.
+ * - Usage Sketches: Views per game are counted in a Count-Min sketch, seeded
+ * in parallel from the saved browse histories and merged.
+ * - Binary Borrow Log: Once created from the admin menu, borrow records are
+ * kept in a memory-mapped log of fixed-width entries that is updated in
+ * place; borrow_records.csv is then only written on export.
+ * - Session Cache: Members' browse history, loans and counters stay warm
+ * between logins for the whole run; histories are saved lazily.
+ * - Graceful Shutdown: Flushes the background writer, then persists all data
+ * changes (games, users, records, reviews, browse history, play sessions)
+ * back to CSV files before exiting.
  * - Validation-First Login: Implements attempt-limited user authentication with
  * three tries before returning to main menu for security.
  *****************************************************************************/
 
 #include <iostream>
 #include <string>
+#include <unordered_set>
 using namespace std;
 
 #include "GameDynamicArray.h"
 #include "UserDynamicArray.h"
 #include "BorrowLinkedList.h"
+#include "BorrowArchive.h"
+#include "BorrowLog.h"
 #include "CSVHandler.h"
+#include "StartupPipeline.h"
+#include "PersistenceWorker.h"
+#include "Recommender.h"
+#include "PlayStats.h"
+#include "SessionCache.h"
+#include "StreamSketches.h"
+#include "CatalogSnapshot.h"
 
 #include "AdminMenu.h"
 #include "MemberMenu.h"
@@ -71,48 +94,139 @@ static string getValidUserID() {
     }
 }
 
+// Number of days a returned borrow stays in memory before it is archived
+static const int ARCHIVE_AFTER_DAYS = 30;
+// Background saves wait this long for more changes, and never longer than the staleness bound
+static const int SAVE_COALESCE_MS = 200;
+static const int SAVE_MAX_STALENESS_MS = 1000;
+// Group-commit window of the journal: borrows, returns and reviews made this
+// close together share one fsync
+static const int JOURNAL_COMMIT_WINDOW_MS = 2;
+// Browse rows per partial view sketch when the sketch is seeded in parallel
+static const int VIEW_SKETCH_GRAIN = 4096;
+// View counts and distinct-borrower counters, saved at exit and restored at startup
+static const char* const SKETCH_FILE = "sketches.bin";
+
 int main() {
     GameDynamicArray games;
     UserDynamicArray users;
     BorrowLinkedList records;
 
-    // --- STEP 1: Load CSV data ---
-    if (!CSVHandler::loadGames("games.csv", games)) {
-        cout << "[WARNING] Could not load games.csv. Continuing with empty game library.\n";
-    }
+    // One work-stealing pool for the whole run: startup parsing, query indexes,
+    // archive scans and the recommender all split their work across it
+    ThreadPool pool;
+    games.attachThreadPool(&pool);
 
-    // NEW: Load Reviews immediately after games are loaded
-    if (!CSVHandler::loadReviews("reviews.csv", games)) {
-        cout << "[INFO] No reviews.csv found or file is empty.\n";
+    // Borrow records come from the binary log instead of the CSV once one exists;
+    // declared before the writer, which syncs it, so it outlives that thread
+    BorrowLog borrowLog;
+    bool binaryRecords = borrowLog.exists();
+    if (binaryRecords && !borrowLog.open()) {
+        // borrow_records.csv is stale once the log exists, so never fall back to it
+        cout << "[FATAL] " << borrowLog.getFilename() << " exists but could not be opened (damaged or "
+             << "unreadable). Borrow records are not loaded from the older borrow_records.csv; restore "
+             << "the log or remove it to go back to CSV storage.\n";
+        return 1;
     }
 
-    if (!CSVHandler::loadUsers("users.csv", users)) {
-        cout << "[WARNING] Could not load users.csv. Continuing with no users.\n";
+    // --- STEP 1 & 2: Load CSV data and reconcile game availability ---
+    // Files are read, parsed and joined in parallel; see StartupPipeline
+    StartupPipeline::run(pool, games, users, records, binaryRecords ? &borrowLog : nullptr);
+    if (binaryRecords) records.attachLog(&borrowLog);
+
+    // Read-only catalog versions for other threads; declared before the writer,
+    // which renders games.csv from them, so it outlives that thread
+    CatalogVersions catalogVersions;
+
+    // Menus hand their saves to this thread instead of writing synchronously
+    PersistenceWorker persistence(SAVE_COALESCE_MS, SAVE_MAX_STALENESS_MS, JOURNAL_COMMIT_WINDOW_MS);
+
+    // Cold tier for old returned borrows; loaded first so replay can tell which
+    // journaled borrows were archived after they were logged
+    BorrowArchive archive;
+    archive.load();
+    archive.attachThreadPool(&pool);
+
+    // Recover borrows/returns/reviews that were journaled but not yet saved to CSV
+    int replayed = CSVHandler::replayJournal("journal.log", games, records, &archive);
+    if (replayed > 0) {
+        cout << "[RECOVERY] Re-applied " << replayed << " journaled change(s) from the last session.\n";
+        persistence.markRecordsDirty(records);
+        persistence.markReviewsDirty(games);
     }
+    games.attachSnapshots(&catalogVersions);
 
-    if (!CSVHandler::loadBorrowRecords("borrow_records.csv", records)) {
-        cout << "[WARNING] Could not load borrow_records.csv. Continuing with no records.\n";
+    // Move old returned borrows out of the linked list into compressed archive segments
+    records.attachArchive(&archive);
+    int archived = records.archiveReturnedBefore(Date::today().addDays(-ARCHIVE_AFTER_DAYS));
+    if (archived > 0 && binaryRecords) {
+        // The log flagged the archived entries in place
+        persistence.markRecordsDirty(records);
+        cout << "[ARCHIVE] Moved " << archived << " returned borrow(s) older than "
+             << ARCHIVE_AFTER_DAYS << " days into archive segments.\n";
+    }
+    else if (archived > 0) {
+        // Rewrite the live file now so archived rows are never stored in both tiers
+        if (CSVHandler::saveBorrowRecords("borrow_records.csv", records)) {
+            cout << "[ARCHIVE] Moved " << archived << " returned borrow(s) older than "
+                 << ARCHIVE_AFTER_DAYS << " days into archive segments.\n";
+        }
+        else {
+            cout << "[ERROR] Failed to save borrow_records.csv after archiving\n";
+        }
     }
 
-    // --- STEP 2: Logic for Game Availability ---
-    for (int i = 0; i < games.size(); i++) {
-        Game* game = games.getPtr(i);
-        string gameID = game->getGameID();
+    // Build "also borrowed" recommendations from every borrow and browse history row.
+    // View counts and distinct-borrower counters come back from the sketch file;
+    // without one, the view counts are seeded from the saved histories
+    Recommender recommender;
+    CountMinSketch viewCounts;
+    bool sketchesRestored = CSVHandler::loadSketches(SKETCH_FILE, viewCounts, records.getPopularity());
+    {
+        // Archived borrows come from the segment counts, so no segment is decoded
+        vector<BorrowRecord> recentBorrows;
+        records.collectInMemory(recentBorrows);
+        vector<pair<string, string>> archivedBorrows;
+        archive.collectBorrowers(archivedBorrows);
+        vector<BrowseRow> views;
+        string browseText;
+        if (CSVHandler::readFile("browse_history.csv", browseText)) {
+            CSVHandler::parseChunked(&pool, browseText, CSVHandler::parseBrowseRows, views);
+        }
+        recommender.build(pool, recentBorrows, archivedBorrows, views);
+        if (!sketchesRestored) {
+            viewCounts = parallelReduce(&pool, 0, (int)views.size(), VIEW_SKETCH_GRAIN, CountMinSketch(),
+                [&views](int from, int to) {
+                    CountMinSketch partial;
+                    for (int i = from; i < to; i++) partial.add(views[i].gameID);
+                    return partial;
+                },
+                [](CountMinSketch total, const CountMinSketch& partial) {
+                    total.merge(partial);
+                    return total;
+                });
 
-        int activeBorrowCount = 0;
-        for (int userIdx = 0; userIdx < users.size(); userIdx++) {
-            User* user = users.getPtr(userIdx);
-            BorrowRecord* activeBorrow = records.findActiveBorrow(user->getUserID(), gameID);
-            if (activeBorrow != nullptr) {
-                activeBorrowCount++;
+            // A game viewed evenly across the chunks can miss every partial's
+            // heavy hitters, so rank every viewed game against the merged counters
+            vector<string> viewedGames;
+            unordered_set<string> seen;
+            for (int i = 0; i < (int)views.size(); i++) {
+                if (seen.insert(views[i].gameID).second) viewedGames.push_back(views[i].gameID);
             }
+            viewCounts.retrack(viewedGames);
         }
+    }
 
-        for (int j = 0; j < activeBorrowCount; j++) {
-            game->decrementAvailable();
-        }
+    // Play sessions feed the win-rate, head-to-head and partner statistics
+    PlayStats playStats;
+    if (!CSVHandler::loadPlaySessions("play_sessions.csv", playStats, &pool)) {
+        cout << "[INFO] No play_sessions.csv found or file is empty.\n";
     }
 
+    // Member sessions stay warm between logins (see SessionCache)
+    SessionCache sessions(persistence);
+    sessions.attachViewCounter(&viewCounts);
+
     cout << "=========================================\n";
     cout << " NPTTGC Board Game Management Application \n";
     cout << "=========================================\n";
@@ -149,10 +263,11 @@ int main() {
             if (u != nullptr) {
                 cout << "\nLogin successful. Welcome, " << u->getName() << "!\n";
                 if (u->isAdmin()) {
-                    AdminMenu::show(games, users, records);
+                    AdminMenu::show(games, users, records, persistence, playStats, pool, sessions, recommender,
+                                    borrowLog);
                 }
                 else {
-                    MemberMenu::show(*u, games, records);
+                    MemberMenu::show(*u, games, users, records, persistence, recommender, playStats, sessions);
                 }
             }
             else {
@@ -163,9 +278,22 @@ int main() {
         }
     }
     // --- STEP 3: Saving data before exit ---
-    cout << "\nSaving data...\n";
+    // Queue browse history still held by warm sessions, then let the background
+    // writer finish so it cannot overwrite the final save
+    sessions.flushAll();
+    persistence.stop();
+    cout << "\n[OK] Background writer flushed " << persistence.getChangesQueued()
+         << " change(s) in " << persistence.getFilesWritten() << " file write(s).\n";
+    cout << "[OK] Journal made " << persistence.getJournalEntries() << " change(s) durable in "
+         << persistence.getJournalBatches() << " fsync batch(es).\n";
+    cout << "[OK] Sessions: " << sessions.getWarmLogins() << " warm login(s), " << sessions.getColdLogins()
+         << " loaded from file, " << sessions.getEvictions() << " evicted.\n";
+    bool allSaved = true;
+
+    cout << "Saving data...\n";
 
     if (!CSVHandler::saveGames("games.csv", games)) {
+        allSaved = false;
         cout << "[ERROR] Failed to save games.csv\n";
     }
     else {
@@ -174,6 +302,7 @@ int main() {
 
     // NEW: Save Reviews BST
     if (!CSVHandler::saveReviews("reviews.csv", games)) {
+        allSaved = false;
         cout << "[ERROR] Failed to save reviews.csv\n";
     }
     else {
@@ -181,19 +310,49 @@ int main() {
     }
 
     if (!CSVHandler::saveUsers("users.csv", users)) {
+        allSaved = false;
         cout << "[ERROR] Failed to save users.csv\n";
     }
     else {
         cout << "[OK] Users saved successfully.\n";
     }
 
-    if (!CSVHandler::saveBorrowRecords("borrow_records.csv", records)) {
+    // With the binary log, records were updated in place; only the mapping needs flushing
+    if (records.getLog() != nullptr) {
+        if (!borrowLog.sync()) {
+            allSaved = false;
+            cout << "[ERROR] Failed to sync " << borrowLog.getFilename() << "\n";
+        }
+        else {
+            cout << "[OK] Borrow log synced (" << borrowLog.getEntryCount() << " entries).\n";
+        }
+    }
+    else if (!CSVHandler::saveBorrowRecords("borrow_records.csv", records)) {
+        allSaved = false;
         cout << "[ERROR] Failed to save borrow_records.csv\n";
     }
     else {
         cout << "[OK] Borrow records saved successfully.\n";
     }
 
+    if (!CSVHandler::savePlaySessions("play_sessions.csv", playStats)) {
+        allSaved = false;
+        cout << "[ERROR] Failed to save play_sessions.csv\n";
+    }
+    else {
+        cout << "[OK] Play sessions saved successfully.\n";
+    }
+
+    // Approximate counters only; a failure here does not hold back the checkpoint
+    if (CSVHandler::saveSketches(SKETCH_FILE, viewCounts, records.getPopularity())) {
+        cout << "[OK] View and borrower sketches saved.\n";
+    }
+
+    // Everything is in the CSV files now, so the journal can be emptied
+    if (allSaved) {
+        persistence.checkpointJournal();
+    }
+
     cout << "Goodbye!\n";
     return 0;
 }
\ No newline at end of file